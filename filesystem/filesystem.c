@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include "filesystem.h"
 #include "watch.h"
 #include "lfs.h"
@@ -50,8 +51,20 @@ int lfs_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t
     return !watch_storage_write(block, off, (void *)buffer, size);
 }
 
+// littlefs has no allocation hooks, so the free space check works from the set of blocks that may be in use: the
+// ones the last lfs_fs_traverse found, plus every block erased since. littlefs erases each block it allocates before
+// programming it, so no new block goes unnoticed. Blocks that get freed do go unnoticed, so the set only errs towards
+// less free space. Copy-on-write moves a file's last block on most appends, so the set does fill up, after about as
+// many writes as there are free blocks; a real traverse then brings it back down. This saves most traverses, but the
+// check is not O(1): a write that finds the set full still pays for one.
+static uint32_t _maybe_used_blocks;
+static bool _maybe_used_blocks_valid = false;
+
+_Static_assert(NVMCTRL_RWWEE_PAGES / 4 <= 32, "_maybe_used_blocks has a bit per block");
+
 int lfs_storage_erase(const struct lfs_config *cfg, lfs_block_t block) {
     (void) cfg;
+    _maybe_used_blocks |= 1ul << block;
     return !watch_storage_erase(block);
 }
 
@@ -68,6 +81,22 @@ const struct lfs_config watch_lfs_cfg = {
     .sync  = lfs_storage_sync,
 
     // block device configuration
+    .read_size = 16,
+    .prog_size = NVMCTRL_PAGE_SIZE,
+    .block_size = NVMCTRL_ROW_SIZE,
+    .block_count = FILESYSTEM_NUM_ROWS,
+    .cache_size = NVMCTRL_PAGE_SIZE,
+    .lookahead_size = 16,
+    .block_cycles = 100,
+};
+
+// the layout from before the rows after FILESYSTEM_NUM_ROWS were reserved, when littlefs spanned the whole area.
+static const struct lfs_config _legacy_lfs_cfg = {
+    .read  = lfs_storage_read,
+    .prog  = lfs_storage_prog,
+    .erase = lfs_storage_erase,
+    .sync  = lfs_storage_sync,
+
     .read_size = 16,
     .prog_size = NVMCTRL_PAGE_SIZE,
     .block_size = NVMCTRL_ROW_SIZE,
@@ -77,31 +106,89 @@ const struct lfs_config watch_lfs_cfg = {
     .block_cycles = 100,
 };
 
+// the same again with no block_count, which has littlefs take it from the superblock; used to tell the layouts apart.
+static const struct lfs_config _probe_lfs_cfg = {
+    .read  = lfs_storage_read,
+    .prog  = lfs_storage_prog,
+    .erase = lfs_storage_erase,
+    .sync  = lfs_storage_sync,
+
+    .read_size = 16,
+    .prog_size = NVMCTRL_PAGE_SIZE,
+    .block_size = NVMCTRL_ROW_SIZE,
+    .block_count = 0,
+    .cache_size = NVMCTRL_PAGE_SIZE,
+    .lookahead_size = 16,
+    .block_cycles = 100,
+};
+
+static filesystem_change_callback_t _filesystem_changed;
+
+static bool _reserved_rows_free = true;
+// set while a migration journal holds the only copy of some files: anything written would be lost when the next
+// boot restores the journal again.
+static bool _read_only = false;
+// the size of the filesystem that is mounted: FILESYSTEM_NUM_ROWS, unless a legacy one couldn't be shrunk.
+static lfs_size_t _filesystem_block_count = FILESYSTEM_NUM_ROWS;
+
 lfs_t eeprom_filesystem;
 static lfs_file_t file;
 static struct lfs_info info;
 
+struct filesystem_file {
+    lfs_file_t file;
+    struct lfs_file_config config;
+    uint8_t cache[NVMCTRL_PAGE_SIZE];   // handed to littlefs, which would otherwise malloc one on every open
+    char readahead[FILESYSTEM_READLINE_BUFFER_SIZE];
+    uint8_t readahead_start;
+    uint8_t readahead_end;
+    bool in_use;
+};
+
+static filesystem_file_t _open_files[FILESYSTEM_MAX_OPEN_FILES];
+
 static int _traverse_df_cb(void *p, lfs_block_t block) {
-    (void) block;
-	uint32_t *nb = p;
-	*nb += 1;
+	uint32_t *used = p;
+	// littlefs may visit a block more than once; the bit set only counts it once.
+	*used |= 1ul << block;
 	return 0;
 }
 
 int32_t filesystem_get_free_space(void) {
 	int err;
 
-	uint32_t free_blocks = 0;
-	err = lfs_fs_traverse(&eeprom_filesystem, _traverse_df_cb, &free_blocks);
+	uint32_t used = 0;
+	err = lfs_fs_traverse(&eeprom_filesystem, _traverse_df_cb, &used);
 	if(err < 0){
+		_maybe_used_blocks_valid = false;
 		return err;
 	}
 
-	uint32_t available = watch_lfs_cfg.block_count * watch_lfs_cfg.block_size - free_blocks * watch_lfs_cfg.block_size;
+	_maybe_used_blocks = used;
+	_maybe_used_blocks_valid = true;
+
+	uint32_t used_blocks = __builtin_popcount(used);
+	uint32_t available = _filesystem_block_count * watch_lfs_cfg.block_size - used_blocks * watch_lfs_cfg.block_size;
 
 	return (int32_t)available;
 }
 
+static bool _filesystem_is_writable(void) {
+    if (_read_only) printf("Filesystem is read-only!\n");
+    return !_read_only;
+}
+
+static bool _filesystem_has_room_for_write(void) {
+    // same threshold as before: more than 256 bytes free.
+    const uint32_t min_free_blocks = 256 / watch_lfs_cfg.block_size + 1;
+
+    if (_maybe_used_blocks_valid &&
+        (uint32_t)__builtin_popcount(_maybe_used_blocks) + min_free_blocks <= _filesystem_block_count) return true;
+
+    // the set says we're running low, but some of those blocks may have been freed since.
+    return filesystem_get_free_space() > 256;
+}
+
 static int filesystem_ls(lfs_t *lfs, const char *path) {
     lfs_dir_t dir;
     int err = lfs_dir_open(lfs, &dir, path);
@@ -139,8 +226,419 @@ static int filesystem_ls(lfs_t *lfs, const char *path) {
     return 0;
 }
 
+// littlefs can't shrink a filesystem in place, so a legacy one is moved over through a journal: every file is
+// streamed into the rows after FILESYSTEM_NUM_ROWS that the legacy filesystem isn't using, the journal is read back
+// and checked, and only then is the filesystem formatted at the new size and the files restored from the journal.
+// A journal that checks out at boot means a migration was cut short after the legacy filesystem may have been
+// formatted, so it is restored again; the journal is only erased once every file is back.
+#define FILESYSTEM_JOURNAL_MAGIC (0x4C4E524A)
+#define FILESYSTEM_JOURNAL_MAX_ROWS (NVMCTRL_RWWEE_PAGES / 4 - FILESYSTEM_NUM_ROWS)
+
+// the journal's first page holds this header; the files follow, each as its name, its size and its contents.
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t payload_length;
+    uint32_t payload_crc;
+    uint16_t num_files;
+    uint8_t num_rows;
+    uint8_t rows[FILESYSTEM_JOURNAL_MAX_ROWS];  // the rows the journal was written to, in order
+    uint32_t header_crc;                        // over everything above
+} filesystem_journal_header_t;
+
+_Static_assert(sizeof(filesystem_journal_header_t) <= NVMCTRL_PAGE_SIZE, "journal header doesn't fit in a page");
+
+typedef struct {
+    filesystem_journal_header_t header;
+    uint8_t page[NVMCTRL_PAGE_SIZE];
+    bool failed;
+} filesystem_journal_writer_t;
+
+static uint32_t _filesystem_journal_capacity(uint8_t num_rows) {
+    return num_rows * NVMCTRL_ROW_SIZE - NVMCTRL_PAGE_SIZE;
+}
+
+// the payload starts on the page after the header.
+static void _filesystem_journal_locate(const filesystem_journal_header_t *header, uint32_t position, uint32_t *row, uint32_t *offset) {
+    position += NVMCTRL_PAGE_SIZE;
+    *row = header->rows[position / NVMCTRL_ROW_SIZE];
+    *offset = position % NVMCTRL_ROW_SIZE;
+}
+
+static bool _filesystem_journal_read(const filesystem_journal_header_t *header, uint32_t position, void *buffer, uint32_t size) {
+    uint8_t *p = buffer;
+    while (size) {
+        uint32_t row, offset;
+        _filesystem_journal_locate(header, position, &row, &offset);
+        uint32_t length = min(size, NVMCTRL_ROW_SIZE - offset);
+        if (!watch_storage_read(row, offset, p, length)) return false;
+        p += length;
+        position += length;
+        size -= length;
+    }
+
+    return true;
+}
+
+static void _filesystem_journal_append(filesystem_journal_writer_t *writer, const void *data, uint32_t size) {
+    filesystem_journal_header_t *header = &writer->header;
+    const uint8_t *p = data;
+
+    header->payload_crc = lfs_crc(header->payload_crc, data, size);
+    while (size && !writer->failed) {
+        uint32_t fill = header->payload_length % NVMCTRL_PAGE_SIZE;
+        uint32_t length = min(size, NVMCTRL_PAGE_SIZE - fill);
+        memcpy(writer->page + fill, p, length);
+        header->payload_length += length;
+        p += length;
+        size -= length;
+        if (header->payload_length % NVMCTRL_PAGE_SIZE == 0) {
+            uint32_t row, offset;
+            _filesystem_journal_locate(header, header->payload_length - NVMCTRL_PAGE_SIZE, &row, &offset);
+            if (!watch_storage_write(row, offset, writer->page, NVMCTRL_PAGE_SIZE)) writer->failed = true;
+        }
+    }
+}
+
+static bool _filesystem_journal_finish(filesystem_journal_writer_t *writer) {
+    filesystem_journal_header_t *header = &writer->header;
+    uint32_t row, offset;
+
+    uint32_t fill = header->payload_length % NVMCTRL_PAGE_SIZE;
+    if (fill && !writer->failed) {
+        memset(writer->page + fill, 0xFF, NVMCTRL_PAGE_SIZE - fill);
+        _filesystem_journal_locate(header, header->payload_length - fill, &row, &offset);
+        if (!watch_storage_write(row, offset, writer->page, NVMCTRL_PAGE_SIZE)) writer->failed = true;
+    }
+    if (writer->failed) return false;
+
+    // the header goes in last, so that a journal cut short never looks complete.
+    header->magic = FILESYSTEM_JOURNAL_MAGIC;
+    header->header_crc = lfs_crc(0xFFFFFFFF, header, offsetof(filesystem_journal_header_t, header_crc));
+    memset(writer->page, 0xFF, NVMCTRL_PAGE_SIZE);
+    memcpy(writer->page, header, sizeof(filesystem_journal_header_t));
+
+    return watch_storage_write(header->rows[0], 0, writer->page, NVMCTRL_PAGE_SIZE);
+}
+
+// Checks that row holds the header of a complete journal, reading back every byte of its payload.
+static bool _filesystem_journal_check(uint32_t row, filesystem_journal_header_t *header) {
+    if (!watch_storage_read(row, 0, (uint8_t *)header, sizeof(filesystem_journal_header_t))) return false;
+    if (header->magic != FILESYSTEM_JOURNAL_MAGIC) return false;
+    if (header->header_crc != lfs_crc(0xFFFFFFFF, header, offsetof(filesystem_journal_header_t, header_crc))) return false;
+    if (header->num_rows == 0 || header->num_rows > FILESYSTEM_JOURNAL_MAX_ROWS || header->rows[0] != row) return false;
+    if (header->payload_length > _filesystem_journal_capacity(header->num_rows)) return false;
+    for (uint8_t i = 0; i < header->num_rows; i++) {
+        if (header->rows[i] < FILESYSTEM_NUM_ROWS || header->rows[i] >= FILESYSTEM_NUM_ROWS + FILESYSTEM_JOURNAL_MAX_ROWS) return false;
+    }
+
+    uint8_t buf[NVMCTRL_PAGE_SIZE];
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t position = 0; position < header->payload_length; position += sizeof(buf)) {
+        uint32_t length = min(sizeof(buf), header->payload_length - position);
+        if (!_filesystem_journal_read(header, position, buf, length)) return false;
+        crc = lfs_crc(crc, buf, length);
+    }
+
+    return crc == header->payload_crc;
+}
+
+static bool _filesystem_journal_find(filesystem_journal_header_t *header) {
+    for (uint32_t row = FILESYSTEM_NUM_ROWS; row < FILESYSTEM_NUM_ROWS + FILESYSTEM_JOURNAL_MAX_ROWS; row++) {
+        if (_filesystem_journal_check(row, header)) return true;
+    }
+
+    return false;
+}
+
+static void _filesystem_journal_erase(void) {
+    filesystem_journal_header_t header;
+    while (_filesystem_journal_find(&header)) {
+        if (!watch_storage_erase(header.rows[0])) return;
+    }
+}
+
+// Writes a file from the journal back to the filesystem, a cache page at a time.
+static bool _filesystem_journal_write_file(const filesystem_journal_header_t *header, uint32_t position, const char *name, lfs_size_t size) {
+    uint8_t buf[NVMCTRL_PAGE_SIZE];
+    if (lfs_file_open(&eeprom_filesystem, &file, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) < 0) return false;
+
+    bool ok = true;
+    for (lfs_size_t done = 0; ok && done < size; done += sizeof(buf)) {
+        lfs_size_t length = min(sizeof(buf), size - done);
+        ok = _filesystem_journal_read(header, position + done, buf, length) &&
+             lfs_file_write(&eeprom_filesystem, &file, buf, length) == (lfs_ssize_t)length;
+    }
+
+    return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK && ok;
+}
+
+// Checks that a file on the filesystem holds exactly what the journal does.
+static bool _filesystem_journal_verify_file(const filesystem_journal_header_t *header, uint32_t position, const char *name, lfs_size_t size) {
+    uint8_t expected[NVMCTRL_PAGE_SIZE];
+    uint8_t actual[NVMCTRL_PAGE_SIZE];
+    if (lfs_file_open(&eeprom_filesystem, &file, name, LFS_O_RDONLY) < 0) return false;
+
+    bool ok = lfs_file_size(&eeprom_filesystem, &file) == (lfs_soff_t)size;
+    for (lfs_size_t done = 0; ok && done < size; done += sizeof(expected)) {
+        lfs_size_t length = min(sizeof(expected), size - done);
+        ok = _filesystem_journal_read(header, position + done, expected, length) &&
+             lfs_file_read(&eeprom_filesystem, &file, actual, length) == (lfs_ssize_t)length &&
+             memcmp(expected, actual, length) == 0;
+    }
+
+    return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK && ok;
+}
+
+// Goes through every file in the journal, either writing it back or checking it. A file that fails doesn't stop the
+// rest, but the journal has to be kept for it.
+static bool _filesystem_journal_replay(const filesystem_journal_header_t *header, bool verify) {
+    char name[LFS_NAME_MAX + 1];
+    uint32_t position = 0;
+    bool complete = true;
+
+    for (uint16_t i = 0; i < header->num_files; i++) {
+        uint32_t name_length = 0;
+        do {
+            if (name_length > LFS_NAME_MAX || !_filesystem_journal_read(header, position++, &name[name_length], 1)) return false;
+        } while (name[name_length++]);
+        lfs_size_t size;
+        if (!_filesystem_journal_read(header, position, &size, sizeof(size))) return false;
+        position += sizeof(size);
+
+        bool ok = verify ? _filesystem_journal_verify_file(header, position, name, size)
+                         : _filesystem_journal_write_file(header, position, name, size);
+        if (!ok) {
+            printf("Couldn't %s %s while shrinking!\r\n", verify ? "read back" : "write back", name);
+            complete = false;
+        }
+        position += size;
+    }
+
+    return complete;
+}
+
+// Formats the filesystem at the new size and writes back every file in the journal. The journal is only erased once
+// every file has been written back and read back whole; until then it holds the only copy of some of them, so its
+// rows stay off limits to tslog, and the filesystem is read-only, since the next boot restores over it again.
+static int _filesystem_journal_restore(const filesystem_journal_header_t *header) {
+    printf("Shrinking filesystem...\r\n");
+    _read_only = true;
+    _reserved_rows_free = false;
+
+    int err = lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
+    if (err == LFS_ERR_OK) err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+    if (err < 0) return err;
+
+    bool complete = _filesystem_journal_replay(header, false);
+    // remount, so that the files are read back from the storage rather than from littlefs's caches.
+    if (complete) {
+        lfs_unmount(&eeprom_filesystem);
+        err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+        if (err < 0) return err;
+        complete = _filesystem_journal_replay(header, true);
+    }
+
+    if (complete && watch_storage_erase(header->rows[0])) {
+        _read_only = false;
+        _reserved_rows_free = true;
+    } else {
+        printf("Kept the journal; the filesystem is read-only until the next boot tries again, or it's formatted.\r\n");
+    }
+
+    return LFS_ERR_OK;
+}
+
+static int _traverse_rows_cb(void *p, lfs_block_t block) {
+    uint32_t *rows = p;
+    if (block < FILESYSTEM_NUM_ROWS + FILESYSTEM_JOURNAL_MAX_ROWS) *rows |= 1UL << block;
+    return 0;
+}
+
+static int _filesystem_keep_legacy(void) {
+    printf("Couldn't shrink the filesystem; format it to free the rows reserved for logs.\r\n");
+    _reserved_rows_free = false;
+    _filesystem_block_count = _legacy_lfs_cfg.block_count;
+    return LFS_ERR_OK;
+}
+
+// the trial migration runs on a RAM disk, with cfg->context pointing at its first block.
+static int _ram_disk_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size) {
+    memcpy(buffer, (uint8_t *)cfg->context + block * cfg->block_size + off, size);
+    return 0;
+}
+
+static int _ram_disk_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size) {
+    memcpy((uint8_t *)cfg->context + block * cfg->block_size + off, buffer, size);
+    return 0;
+}
+
+static int _ram_disk_erase(const struct lfs_config *cfg, lfs_block_t block) {
+    memset((uint8_t *)cfg->context + block * cfg->block_size, 0xFF, cfg->block_size);
+    return 0;
+}
+
+static int _ram_disk_sync(const struct lfs_config *cfg) {
+    (void) cfg;
+    return 0;
+}
+
+// Copies a file from the legacy filesystem a cache page at a time, the same way the journal restore writes it.
+static bool _filesystem_trial_copy_file(lfs_t *trial, const char *name) {
+    lfs_file_t copy;
+    uint8_t buf[NVMCTRL_PAGE_SIZE];
+    if (lfs_file_open(&eeprom_filesystem, &file, name, LFS_O_RDONLY) < 0) return false;
+
+    bool ok = lfs_file_open(trial, &copy, name, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) == LFS_ERR_OK;
+    if (ok) {
+        lfs_ssize_t read;
+        while (ok && (read = lfs_file_read(&eeprom_filesystem, &file, buf, sizeof(buf))) != 0) {
+            ok = read > 0 && lfs_file_write(trial, &copy, buf, read) == read;
+        }
+        if (lfs_file_close(trial, &copy) < 0) ok = false;
+    }
+    lfs_file_close(&eeprom_filesystem, &file);
+
+    return ok;
+}
+
+// Copies every file into a filesystem laid out like the new one and checks that littlefs can fit them there; totals
+// up what the journal needs to hold on the way. Directories aren't migrated, so any directory fails the trial.
+static bool _filesystem_trial_copy(lfs_t *trial, uint32_t *payload, uint16_t *num_files) {
+    lfs_dir_t dir;
+    struct lfs_info entry;
+    if (lfs_dir_open(&eeprom_filesystem, &dir, "/") < 0) return false;
+
+    bool ok = true;
+    int res;
+    while (ok && (res = lfs_dir_read(&eeprom_filesystem, &dir, &entry)) != 0) {
+        if (res < 0) {
+            ok = false;
+        } else if (entry.type == LFS_TYPE_REG) {
+            ok = _filesystem_trial_copy_file(trial, entry.name);
+            *payload += strlen(entry.name) + 1 + sizeof(lfs_size_t) + entry.size;
+            (*num_files)++;
+        } else if (strcmp(entry.name, ".") && strcmp(entry.name, "..")) {
+            ok = false;
+        }
+    }
+    lfs_dir_close(&eeprom_filesystem, &dir);
+
+    // after the migration, there has to be room for a write; same threshold as _filesystem_has_room_for_write.
+    lfs_ssize_t used = ok ? lfs_fs_size(trial) : -1;
+
+    return used >= 0 && (lfs_size_t)used < FILESYSTEM_NUM_ROWS && (FILESYSTEM_NUM_ROWS - used) * NVMCTRL_ROW_SIZE > 256;
+}
+
+// A dry run of the migration, on a RAM disk the size of the new filesystem. Nothing on the storage is touched.
+static bool _filesystem_trial_migration(uint32_t *payload, uint16_t *num_files) {
+    struct lfs_config cfg = watch_lfs_cfg;
+    cfg.read = _ram_disk_read;
+    cfg.prog = _ram_disk_prog;
+    cfg.erase = _ram_disk_erase;
+    cfg.sync = _ram_disk_sync;
+    cfg.context = malloc(FILESYSTEM_NUM_ROWS * NVMCTRL_ROW_SIZE);
+    if (cfg.context == NULL) return false;
+
+    lfs_t trial;
+    bool fits = false;
+    if (lfs_format(&trial, &cfg) == LFS_ERR_OK && lfs_mount(&trial, &cfg) == LFS_ERR_OK) {
+        fits = _filesystem_trial_copy(&trial, payload, num_files);
+        lfs_unmount(&trial);
+    }
+    free(cfg.context);
+
+    return fits;
+}
+
+// If the files don't fit at the new size, there are directories, or the journal can't be written and read back, the
+// legacy filesystem is left alone and its reserved rows stay off limits until someone formats it.
+static int _filesystem_migrate_legacy(void) {
+    uint32_t payload = 0;
+    uint16_t num_files = 0;
+    if (!_filesystem_trial_migration(&payload, &num_files)) return _filesystem_keep_legacy();
+
+    // the journal can only go in the rows the legacy filesystem isn't using.
+    uint32_t used_rows = 0;
+    if (lfs_fs_traverse(&eeprom_filesystem, _traverse_rows_cb, &used_rows) < 0) return _filesystem_keep_legacy();
+    filesystem_journal_writer_t writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.header.num_files = num_files;
+    writer.header.payload_crc = 0xFFFFFFFF;
+    for (uint32_t row = FILESYSTEM_NUM_ROWS; row < FILESYSTEM_NUM_ROWS + FILESYSTEM_JOURNAL_MAX_ROWS; row++) {
+        if (used_rows & (1UL << row)) continue;
+        if (!watch_storage_erase(row)) return _filesystem_keep_legacy();
+        writer.header.rows[writer.header.num_rows++] = row;
+        if (_filesystem_journal_capacity(writer.header.num_rows) >= payload) break;
+    }
+    if (writer.header.num_rows == 0 || _filesystem_journal_capacity(writer.header.num_rows) < payload) return _filesystem_keep_legacy();
+
+    lfs_dir_t dir;
+    struct lfs_info entry;
+    int err = lfs_dir_open(&eeprom_filesystem, &dir, "/");
+    while (err >= 0 && !writer.failed && (err = lfs_dir_read(&eeprom_filesystem, &dir, &entry)) > 0) {
+        if (entry.type != LFS_TYPE_REG) continue;
+        _filesystem_journal_append(&writer, entry.name, strlen(entry.name) + 1);
+        _filesystem_journal_append(&writer, &entry.size, sizeof(lfs_size_t));
+        if ((err = lfs_file_open(&eeprom_filesystem, &file, entry.name, LFS_O_RDONLY)) < 0) break;
+        uint8_t buf[NVMCTRL_PAGE_SIZE];
+        lfs_size_t remaining = entry.size;
+        while (remaining) {
+            lfs_ssize_t read = lfs_file_read(&eeprom_filesystem, &file, buf, min(sizeof(buf), remaining));
+            if (read <= 0) {
+                err = read < 0 ? read : LFS_ERR_CORRUPT;
+                break;
+            }
+            _filesystem_journal_append(&writer, buf, read);
+            remaining -= read;
+        }
+        lfs_file_close(&eeprom_filesystem, &file);
+    }
+    lfs_dir_close(&eeprom_filesystem, &dir);
+
+    // nothing has been touched yet: the legacy filesystem only goes once the journal reads back whole.
+    filesystem_journal_header_t header;
+    if (err < 0 || !_filesystem_journal_finish(&writer) || !_filesystem_journal_check(writer.header.rows[0], &header)) {
+        return _filesystem_keep_legacy();
+    }
+
+    lfs_unmount(&eeprom_filesystem);
+
+    return _filesystem_journal_restore(&header);
+}
+
+// Mounts the filesystem at the size its superblock gives, shrinking it first if it's a legacy one.
+static int _filesystem_mount(void) {
+    int err = lfs_mount(&eeprom_filesystem, &_probe_lfs_cfg);
+    if (err < 0) return err;
+    struct lfs_fsinfo fsinfo;
+    err = lfs_fs_stat(&eeprom_filesystem, &fsinfo);
+    lfs_unmount(&eeprom_filesystem);
+    if (err < 0) return err;
+
+    if (fsinfo.block_count == watch_lfs_cfg.block_count) return lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+    if (fsinfo.block_count == _legacy_lfs_cfg.block_count) {
+        err = lfs_mount(&eeprom_filesystem, &_legacy_lfs_cfg);
+        return err < 0 ? err : _filesystem_migrate_legacy();
+    }
+
+    // no firmware has ever laid the filesystem out at any other size.
+    return LFS_ERR_CORRUPT;
+}
+
 bool filesystem_init(void) {
-    int err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+    _maybe_used_blocks_valid = false;
+    _reserved_rows_free = true;
+    _read_only = false;
+    _filesystem_block_count = FILESYSTEM_NUM_ROWS;
+
+    int err;
+    filesystem_journal_header_t journal;
+    if (_filesystem_journal_find(&journal)) {
+        printf("Resuming an interrupted filesystem migration.\r\n");
+        err = _filesystem_journal_restore(&journal);
+    } else {
+        err = _filesystem_mount();
+    }
 
     // reformat if we can't mount the filesystem
     // this should only happen on the first boot
@@ -162,15 +660,32 @@ int _filesystem_format(void) {
         printf("Couldn't unmount - continuing to format, but you should reboot afterwards!\r\n");
     }
 
+    _maybe_used_blocks_valid = false;
+    // unmounting left any open handles pointing at nothing.
+    for (uint8_t i = 0; i < FILESYSTEM_MAX_OPEN_FILES; i++) _open_files[i].in_use = false;
+    // a journal left behind would be restored over the fresh filesystem at the next boot.
+    _filesystem_journal_erase();
     err = lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
     if (err < 0) return err;
+    _reserved_rows_free = true;
+    _read_only = false;
+    _filesystem_block_count = FILESYSTEM_NUM_ROWS;
 
     err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
     if (err < 0) return err;
     printf("Filesystem re-mounted with %ld bytes free.\r\n", filesystem_get_free_space());
+    if (_filesystem_changed) _filesystem_changed(NULL);
     return 0;
 }
 
+void filesystem_set_change_callback(filesystem_change_callback_t callback) {
+    _filesystem_changed = callback;
+}
+
+bool filesystem_reserved_rows_free(void) {
+    return _reserved_rows_free;
+}
+
 bool filesystem_file_exists(char *filename) {
     info.type = 0;
     lfs_stat(&eeprom_filesystem, filename, &info);
@@ -178,6 +693,7 @@ bool filesystem_file_exists(char *filename) {
 }
 
 bool filesystem_rm(char *filename) {
+    if (!_filesystem_is_writable()) return false;
     info.type = 0;
     lfs_stat(&eeprom_filesystem, filename, &info);
     if (filesystem_file_exists(filename)) {
@@ -234,25 +750,25 @@ bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t le
 }
 
 static void filesystem_cat(char *filename) {
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, filename, &info);
-    if (filesystem_file_exists(filename)) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(filename, buf, info.size);
-            buf[info.size] = '\0';
-            printf("%s\r\n", buf);
-            free(buf);
-        } else {
-            printf("\r\n");
-        }
-    } else {
+    filesystem_file_t *f = filesystem_file_exists(filename) ? filesystem_open(filename, FILESYSTEM_MODE_READ) : NULL;
+    if (f == NULL) {
         printf("cat: %s: No such file\r\n", filename);
+        return;
+    }
+
+    // stream the file out a cache page at a time rather than reading all of it into memory.
+    char buf[NVMCTRL_PAGE_SIZE];
+    int32_t read;
+    while ((read = filesystem_read(f, buf, sizeof(buf))) > 0) {
+        printf("%.*s", (int)read, buf);
     }
+    printf("\r\n");
+    filesystem_close(f);
 }
 
 bool filesystem_write_file(char *filename, char *text, int32_t length) {
-    if (filesystem_get_free_space() <= 256) {
+    if (!_filesystem_is_writable()) return false;
+    if (!_filesystem_has_room_for_write()) {
         printf("No free space!\n");
         return false;    
     }
@@ -265,7 +781,8 @@ bool filesystem_write_file(char *filename, char *text, int32_t length) {
 }
 
 bool filesystem_append_file(char *filename, char *text, int32_t length) {
-    if (filesystem_get_free_space() <= 256) {
+    if (!_filesystem_is_writable()) return false;
+    if (!_filesystem_has_room_for_write()) {
         printf("No free space!\n");
         return false;    
     }
@@ -277,6 +794,126 @@ bool filesystem_append_file(char *filename, char *text, int32_t length) {
     return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
 }
 
+// littlefs's position runs ahead of the caller's by whatever filesystem_readline has read but not returned yet.
+static int _filesystem_drop_readahead(filesystem_file_t *f) {
+    lfs_soff_t unread = f->readahead_end - f->readahead_start;
+    f->readahead_start = f->readahead_end = 0;
+    if (unread == 0) return LFS_ERR_OK;
+
+    lfs_soff_t pos = lfs_file_seek(&eeprom_filesystem, &f->file, -unread, LFS_SEEK_CUR);
+    return pos < 0 ? pos : LFS_ERR_OK;
+}
+
+filesystem_file_t *filesystem_open(char *filename, filesystem_mode_t mode) {
+    filesystem_file_t *f = NULL;
+    for (uint8_t i = 0; i < FILESYSTEM_MAX_OPEN_FILES; i++) {
+        if (!_open_files[i].in_use) {
+            f = &_open_files[i];
+            break;
+        }
+    }
+    if (f == NULL) {
+        printf("Too many open files!\n");
+        return NULL;
+    }
+
+    if (mode != FILESYSTEM_MODE_READ && !_filesystem_is_writable()) return NULL;
+
+    int flags;
+    switch (mode) {
+        case FILESYSTEM_MODE_WRITE:
+            flags = LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC;
+            break;
+        case FILESYSTEM_MODE_APPEND:
+            flags = LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND;
+            break;
+        case FILESYSTEM_MODE_READ:
+        default:
+            flags = LFS_O_RDONLY;
+            break;
+    }
+
+    memset(f, 0, sizeof(filesystem_file_t));
+    f->config.buffer = f->cache;
+    if (lfs_file_opencfg(&eeprom_filesystem, &f->file, filename, flags, &f->config) < 0) return NULL;
+    f->in_use = true;
+
+    return f;
+}
+
+int32_t filesystem_read(filesystem_file_t *f, void *buf, int32_t length) {
+    int err = _filesystem_drop_readahead(f);
+    if (err < 0) return err;
+
+    return lfs_file_read(&eeprom_filesystem, &f->file, buf, length);
+}
+
+int32_t filesystem_readline(filesystem_file_t *f, char *buf, int32_t length) {
+    // with no room for a character, a line could never be read past.
+    if (length < 2) {
+        if (length == 1) buf[0] = '\0';
+        return -1;
+    }
+
+    int32_t count = 0;
+    bool newline = false;
+
+    while (true) {
+        if (f->readahead_start == f->readahead_end) {
+            lfs_ssize_t read = lfs_file_read(&eeprom_filesystem, &f->file, f->readahead, sizeof(f->readahead));
+            if (read <= 0) break;
+            f->readahead_start = 0;
+            f->readahead_end = read;
+        }
+        char c = f->readahead[f->readahead_start];
+        if (c == '\n') {
+            f->readahead_start++;
+            newline = true;
+            break;
+        }
+        // the buffer is full, and this isn't the newline that ends the line: leave the rest of it, newline
+        // included, for the next call. A line that exactly fills the buffer took the branch above instead.
+        if (count == length - 1) break;
+        buf[count++] = c;
+        f->readahead_start++;
+    }
+    buf[count] = '\0';
+
+    if (count == 0 && !newline) return -1;
+
+    return count;
+}
+
+bool filesystem_write(filesystem_file_t *f, const void *buf, int32_t length) {
+    if (!_filesystem_is_writable()) return false;
+    if (!_filesystem_has_room_for_write()) {
+        printf("No free space!\n");
+        return false;
+    }
+    if (_filesystem_drop_readahead(f) < 0) return false;
+
+    return lfs_file_write(&eeprom_filesystem, &f->file, buf, length) == length;
+}
+
+bool filesystem_seek(filesystem_file_t *f, int32_t offset) {
+    f->readahead_start = f->readahead_end = 0;
+
+    return lfs_file_seek(&eeprom_filesystem, &f->file, offset, LFS_SEEK_SET) >= 0;
+}
+
+int32_t filesystem_tell(filesystem_file_t *f) {
+    lfs_soff_t pos = lfs_file_tell(&eeprom_filesystem, &f->file);
+    if (pos < 0) return pos;
+
+    return pos - (f->readahead_end - f->readahead_start);
+}
+
+bool filesystem_close(filesystem_file_t *f) {
+    f->in_use = false;
+
+    return lfs_file_close(&eeprom_filesystem, &f->file) == LFS_ERR_OK;
+}
+
 int filesystem_cmd_ls(int argc, char *argv[]) {
     if (argc >= 2) {
         filesystem_ls(&eeprom_filesystem, argv[1]);
@@ -294,27 +931,26 @@ int filesystem_cmd_cat(int argc, char *argv[]) {
 
 int filesystem_cmd_b64encode(int argc, char *argv[]) {
     (void) argc;
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, argv[1], &info);
-    if (filesystem_file_exists(argv[1])) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(argv[1], buf, info.size);
-            // print a base 64 encoding of the file, 12 bytes at a time
-            for (lfs_size_t i = 0; i < info.size; i += 12) {
-                lfs_size_t len = min(12, info.size - i);
-                char base64_line[17];
-                b64_encode((unsigned char *)buf + i, len, (unsigned char *)base64_line);
-                printf("%s\n", base64_line);
-                delay_ms(10);
-            }
-            free(buf);
-        } else {
-            printf("\r\n");
-        }
-    } else {
+    filesystem_file_t *f = filesystem_file_exists(argv[1]) ? filesystem_open(argv[1], FILESYSTEM_MODE_READ) : NULL;
+    if (f == NULL) {
         printf("b64encode: %s: No such file\r\n", argv[1]);
+        return 0;
     }
+
+    // print a base 64 encoding of the file, 12 bytes at a time
+    unsigned char buf[12];
+    int32_t read;
+    bool empty = true;
+    while ((read = filesystem_read(f, buf, sizeof(buf))) > 0) {
+        char base64_line[17];
+        b64_encode(buf, read, (unsigned char *)base64_line);
+        printf("%s\n", base64_line);
+        delay_ms(10);
+        empty = false;
+    }
+    if (empty) printf("\r\n");
+    filesystem_close(f);
+
     return 0;
 }
 
@@ -327,7 +963,7 @@ int filesystem_cmd_df(int argc, char *argv[]) {
 
 int filesystem_cmd_rm(int argc, char *argv[]) {
     (void) argc;
-    filesystem_rm(argv[1]);
+    if (filesystem_rm(argv[1]) && _filesystem_changed) _filesystem_changed(argv[1]);
     return 0;
 }
 
@@ -366,6 +1002,7 @@ int filesystem_cmd_echo(int argc, char *argv[]) {
     } else {
         return -2;
     }
+    if (_filesystem_changed) _filesystem_changed(argv[3]);
 
     return 0;
 }
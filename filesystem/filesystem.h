@@ -28,11 +28,30 @@
 #include <stdbool.h>
 #include "watch.h"
 
-/** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be.
+/// littlefs lives in the first FILESYSTEM_NUM_ROWS rows of the storage area; the rest belong to tslog.
+#define FILESYSTEM_NUM_ROWS (18)
+
+/// Called with the name of a file written or removed from the shell, or with NULL once the filesystem is formatted.
+typedef void (*filesystem_change_callback_t)(const char *filename);
+
+/** @brief Initializes and mounts the tiny filesystem, formatting it if need be.
   * @return true if the filesystem was mounted successfully.
   */
 bool filesystem_init(void);
 
+/** @brief Checks whether the storage rows after FILESYSTEM_NUM_ROWS are free for tslog.
+  * @return true unless the filesystem was formatted by older firmware across the whole storage area, and was
+  *         too full to be shrunk when it was mounted, or shrinking it hasn't finished: its journal is still in
+  *         those rows, and the filesystem is read-only until the journal is restored at a later boot.
+  */
+bool filesystem_reserved_rows_free(void);
+
+/** @brief Registers the function to call when files change from the shell, so that whatever caches their contents
+  *        can read them again. There is only one; registering another replaces it.
+  * @param callback the function to call, or NULL for none.
+  */
+void filesystem_set_change_callback(filesystem_change_callback_t callback);
+
 /** @brief Gets the space available on the filesystem.
   * @return the free space in bytes
   */
@@ -77,6 +96,8 @@ bool filesystem_read_file(char *filename, char *buf, int32_t length);
   *               to reflect the offset of the next line.
   * @param length The maximum number of bytes to read
   * @return true if the read was successful; false otherwise
+  * @note This opens and closes the file on every call. To go through a file line by line, use
+  *       filesystem_open and filesystem_readline instead.
   */
 bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length);
 
@@ -96,6 +117,77 @@ bool filesystem_write_file(char *filename, char *text, int32_t length);
   */
 bool filesystem_append_file(char *filename, char *text, int32_t length);
 
+/// The number of files that can be open through filesystem_open at the same time.
+#define FILESYSTEM_MAX_OPEN_FILES 2
+
+/// How much of the file filesystem_readline reads ahead at a time.
+#define FILESYSTEM_READLINE_BUFFER_SIZE 32
+
+typedef enum {
+    FILESYSTEM_MODE_READ = 0,   // read only; the file must exist
+    FILESYSTEM_MODE_WRITE,      // write only; creates the file, or truncates it if it exists
+    FILESYSTEM_MODE_APPEND,     // write only; creates the file, and every write goes to the end of it
+} filesystem_mode_t;
+
+/// An open file. The handles come from a small static pool, so a file that is opened must always be closed.
+typedef struct filesystem_file filesystem_file_t;
+
+/** @brief Opens a file and keeps it open for streaming reads or writes.
+  * @param filename the file you wish to open
+  * @param mode one of FILESYSTEM_MODE_READ, FILESYSTEM_MODE_WRITE or FILESYSTEM_MODE_APPEND
+  * @return a handle to the open file, or NULL if the file couldn't be opened or all
+  *         FILESYSTEM_MAX_OPEN_FILES handles are in use.
+  * @note Unlike the filesystem_*_file functions, these don't open, seek and close the file on
+  *       every call, so they are the ones to use for reading a file piece by piece.
+  */
+filesystem_file_t *filesystem_open(char *filename, filesystem_mode_t mode);
+
+/** @brief Reads from an open file at the current position.
+  * @param file the open file
+  * @param buf A buffer of at least length bytes
+  * @param length The maximum number of bytes to read
+  * @return the number of bytes read, 0 at the end of the file, or a negative number on error.
+  */
+int32_t filesystem_read(filesystem_file_t *file, void *buf, int32_t length);
+
+/** @brief Reads the next line from an open file.
+  * @param file the open file
+  * @param buf A buffer of at least length bytes; the line is stored without its newline, and
+  *            null terminated.
+  * @param length The size of buf, at least 2. A line that doesn't fit is split, and the next
+  *               call returns the rest of it; a line of exactly length - 1 characters is not.
+  * @return the length of the line, or -1 at the end of the file, on error, or if length is
+  *         less than 2.
+  */
+int32_t filesystem_readline(filesystem_file_t *file, char *buf, int32_t length);
+
+/** @brief Writes to an open file at the current position.
+  * @param file the open file
+  * @param buf The bytes to write
+  * @param length The number of bytes to write
+  * @return true if the write was successful; false otherwise
+  */
+bool filesystem_write(filesystem_file_t *file, const void *buf, int32_t length);
+
+/** @brief Moves the current position of an open file.
+  * @param file the open file
+  * @param offset The offset from the start of the file
+  * @return true if the seek was successful; false otherwise
+  */
+bool filesystem_seek(filesystem_file_t *file, int32_t offset);
+
+/** @brief Gets the current position of an open file.
+  * @param file the open file
+  * @return the offset from the start of the file of the next byte to be read or written.
+  */
+int32_t filesystem_tell(filesystem_file_t *file);
+
+/** @brief Closes a file, writing out anything still waiting to be written, and returns its handle to the pool.
+  * @param file the open file
+  * @return true if the file was closed successfully; false otherwise
+  */
+bool filesystem_close(filesystem_file_t *file);
+
 int filesystem_cmd_ls(int argc, char *argv[]);
 int filesystem_cmd_cat(int argc, char *argv[]);
 int filesystem_cmd_b64encode(int argc, char *argv[]);
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "prefs.h"
+#include "filesystem.h"
+
+typedef struct {
+    char key[PREFS_MAX_KEY_LENGTH + 1]; // empty if the entry is free
+    uint32_t value;
+    uint32_t stored_value;              // what the file holds, if it exists
+    bool stored;                        // whether the file exists
+    bool dirty;
+} prefs_entry_t;
+
+static prefs_entry_t *_prefs_entries;
+static uint8_t _prefs_max_keys;
+static prefs_callback_t _prefs_changed;
+
+static bool _prefs_write(prefs_entry_t *entry) {
+    if (!filesystem_write_file(entry->key, (char *)&entry->value, sizeof(uint32_t))) return false;
+    entry->stored_value = entry->value;
+    entry->stored = true;
+    entry->dirty = false;
+
+    return true;
+}
+
+static void _prefs_read(prefs_entry_t *entry) {
+    entry->stored = false;
+    if (filesystem_file_exists(entry->key)) {
+        entry->stored = filesystem_read_file(entry->key, (char *)&entry->stored_value, sizeof(uint32_t));
+    }
+}
+
+static prefs_entry_t *_prefs_lookup(const char *key) {
+    if (strlen(key) > PREFS_MAX_KEY_LENGTH) return NULL;
+
+    prefs_entry_t *free_entry = NULL;
+    for (uint8_t i = 0; i < _prefs_max_keys; i++) {
+        if (!strcmp(_prefs_entries[i].key, key)) return &_prefs_entries[i];
+        if (free_entry == NULL && _prefs_entries[i].key[0] == '\0') free_entry = &_prefs_entries[i];
+    }
+
+    // the cache is sized for every key the faces keep, so running out means it was sized wrong. Evicting would
+    // have every lookup after this one read its file again, so the keys that don't fit go straight to their files.
+    if (free_entry == NULL) {
+        printf("prefs: cache full, %s goes straight to its file\r\n", key);
+        return NULL;
+    }
+
+    // a missing file gets cached too, so that asking again doesn't go back to the filesystem.
+    memset(free_entry, 0, sizeof(prefs_entry_t));
+    strcpy(free_entry->key, key);
+    _prefs_read(free_entry);
+    free_entry->value = free_entry->stored_value;
+
+    return free_entry;
+}
+
+bool prefs_init(uint8_t max_keys, prefs_callback_t changed) {
+    _prefs_changed = changed;
+    // files changed from the shell or formatted away have to be read again.
+    filesystem_set_change_callback(prefs_reload);
+    if (_prefs_entries != NULL) return true;
+
+    _prefs_entries = calloc(max_keys, sizeof(prefs_entry_t));
+    if (_prefs_entries == NULL) return false;
+    _prefs_max_keys = max_keys;
+
+    return true;
+}
+
+bool prefs_get(const char *key, uint32_t *value) {
+    prefs_entry_t *entry = _prefs_lookup(key);
+    if (entry == NULL) {
+        // keys that don't fit in the cache go straight to the file.
+        if (!filesystem_file_exists((char *)key)) return false;
+        return filesystem_read_file((char *)key, (char *)value, sizeof(uint32_t));
+    }
+    if (!entry->stored && !entry->dirty) return false;
+
+    *value = entry->value;
+
+    return true;
+}
+
+void prefs_set(const char *key, uint32_t value) {
+    prefs_entry_t *entry = _prefs_lookup(key);
+    if (entry == NULL) {
+        filesystem_write_file((char *)key, (char *)&value, sizeof(uint32_t));
+        return;
+    }
+
+    entry->value = value;
+    entry->dirty = !entry->stored || entry->stored_value != value;
+    if (entry->dirty && _prefs_changed) _prefs_changed();
+}
+
+bool prefs_flush(void) {
+    bool success = true;
+    for (uint8_t i = 0; i < _prefs_max_keys; i++) {
+        if (_prefs_entries[i].dirty) success = _prefs_write(&_prefs_entries[i]) && success;
+    }
+
+    return success;
+}
+
+bool prefs_is_dirty(void) {
+    for (uint8_t i = 0; i < _prefs_max_keys; i++) {
+        if (_prefs_entries[i].dirty) return true;
+    }
+
+    return false;
+}
+
+void prefs_reload(const char *key) {
+    for (uint8_t i = 0; i < _prefs_max_keys; i++) {
+        prefs_entry_t *entry = &_prefs_entries[i];
+        if (entry->key[0] == '\0' || (key != NULL && strcmp(entry->key, key))) continue;
+        if (entry->dirty) {
+            // a value set but not flushed yet still wins over the file; it's only compared against it again.
+            _prefs_read(entry);
+            entry->dirty = !entry->stored || entry->stored_value != entry->value;
+        } else {
+            memset(entry, 0, sizeof(prefs_entry_t));
+        }
+    }
+}
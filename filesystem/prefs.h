@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * PREFS: a write-behind cache for the small settings files that Movement and the watch faces keep, like
+ * settings.u32 or location.u32.
+ *
+ * Each key is the name of a file holding one 32-bit value, so the files stay exactly as they were and anything
+ * that reads them directly keeps working. The difference is when they get written: prefs_set only updates the
+ * cache, and prefs_flush writes out every value that differs from what's in the file, all in one go. A setting
+ * changed ten times in a row gets written once, and a setting changed back to what it was doesn't get written at
+ * all. Movement flushes when a face resigns, when the watch enters low energy mode, and once a minute has gone by
+ * without a change, so faces don't need to flush themselves.
+ *
+ * Movement sizes the cache for every key the faces keep; keys that don't fit in it go straight to their files.
+ */
+
+/// Keys are file names of up to this many characters.
+#define PREFS_MAX_KEY_LENGTH 12
+
+/// Called by prefs_set whenever it leaves a value waiting to be written.
+typedef void (*prefs_callback_t)(void);
+
+/** @brief Sets up the cache. Call once the filesystem is mounted.
+  * @param max_keys the number of keys the cache holds; any more go straight to their files.
+  * @param changed called whenever prefs_set leaves a value waiting to be written; may be NULL.
+  * @return true if the cache could be allocated; false otherwise, in which case every key goes to its file.
+  */
+bool prefs_init(uint8_t max_keys, prefs_callback_t changed);
+
+/** @brief Gets a value, from the cache or from its file.
+  * @param key the name of the file holding the value
+  * @param value set to the value, if it exists; left alone otherwise.
+  * @return true if the value exists, whether in the file or only in the cache so far; false otherwise.
+  */
+bool prefs_get(const char *key, uint32_t *value);
+
+/** @brief Sets a value. It's written to its file on the next flush, if it differs from what the file holds.
+  * @param key the name of the file to hold the value
+  * @param value the value
+  */
+void prefs_set(const char *key, uint32_t value);
+
+/** @brief Writes every changed value out to its file.
+  * @return true if everything was written, or there was nothing to write; false otherwise.
+  */
+bool prefs_flush(void);
+
+/** @brief Checks whether any value is waiting to be written.
+  * @return true if the next prefs_flush has anything to write.
+  */
+bool prefs_is_dirty(void);
+
+/** @brief Reads a key's file again after it was written or removed without going through prefs. A value set but
+  *        not flushed yet is kept, and is still written on the next flush unless the file now holds it.
+  * @param key the name of the file, or NULL if the whole filesystem was formatted.
+  */
+void prefs_reload(const char *key);
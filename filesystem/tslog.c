@@ -0,0 +1,255 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "tslog.h"
+
+#define TSLOG_PAGES_PER_ROW (NVMCTRL_ROW_SIZE / NVMCTRL_PAGE_SIZE)
+#define TSLOG_MAGIC (0x5453)
+#define TSLOG_EMPTY (0xFFFFFFFF)
+
+typedef struct __attribute__((packed)) {
+    uint32_t sequence;
+    uint16_t magic;         // TSLOG_MAGIC plus the log's ID, so a page can't turn up in the wrong log
+    uint16_t checksum;
+} tslog_page_header_t;
+
+#define TSLOG_RECORDS_PER_PAGE ((NVMCTRL_PAGE_SIZE - sizeof(tslog_page_header_t)) / sizeof(tslog_record_t))
+
+// unused record slots are left erased, so they read back with a timestamp of TSLOG_EMPTY.
+typedef struct __attribute__((packed)) {
+    tslog_page_header_t header;
+    tslog_record_t records[TSLOG_RECORDS_PER_PAGE];
+} tslog_page_t;
+
+typedef struct {
+    uint8_t first_row;
+    uint8_t num_rows;
+} tslog_layout_t;
+
+// temperature is logged hourly, 9 records a page, and holds 13 to 15 days. activity is logged daily and flushed
+// weekly, 7 records a page, and holds 84 to 112 days.
+static const tslog_layout_t _tslog_layout[TSLOG_NUM_LOGS] = {
+    [TSLOG_TEMPERATURE] = { .first_row = FILESYSTEM_NUM_ROWS, .num_rows = 10 },
+    [TSLOG_ACTIVITY] = { .first_row = FILESYSTEM_NUM_ROWS + 10, .num_rows = 4 },
+};
+
+_Static_assert(FILESYSTEM_NUM_ROWS + 10 + 4 == NVMCTRL_RWWEE_PAGES / TSLOG_PAGES_PER_ROW, "tslog rows don't add up");
+
+typedef struct {
+    bool ready;
+    uint8_t next_page;          // the page within the log that gets written next
+    uint32_t next_sequence;
+    uint16_t count;             // the number of records in pages already written
+    uint8_t num_pending;
+    tslog_record_t pending[TSLOG_RECORDS_PER_PAGE];
+} tslog_state_t;
+
+static tslog_state_t _tslog_state[TSLOG_NUM_LOGS];
+
+static inline uint8_t _tslog_num_pages(tslog_id_t log) {
+    return _tslog_layout[log].num_rows * TSLOG_PAGES_PER_ROW;
+}
+
+static inline uint32_t _tslog_row(tslog_id_t log, uint8_t page) {
+    return _tslog_layout[log].first_row + page / TSLOG_PAGES_PER_ROW;
+}
+
+static inline uint32_t _tslog_offset(uint8_t page) {
+    return (page % TSLOG_PAGES_PER_ROW) * NVMCTRL_PAGE_SIZE;
+}
+
+// Fletcher-16 over the sequence number and the records.
+static uint16_t _tslog_checksum(const tslog_page_t *page) {
+    uint16_t sum1 = 0, sum2 = 0;
+    const uint8_t *bytes = (const uint8_t *)&page->header.sequence;
+    for (uint8_t i = 0; i < sizeof(page->header.sequence); i++) {
+        sum1 = (sum1 + bytes[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    bytes = (const uint8_t *)page->records;
+    for (uint8_t i = 0; i < sizeof(page->records); i++) {
+        sum1 = (sum1 + bytes[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+
+    return (sum2 << 8) | sum1;
+}
+
+static bool _tslog_read_page(tslog_id_t log, uint8_t page, tslog_page_t *out) {
+    if (!watch_storage_read(_tslog_row(log, page), _tslog_offset(page), (uint8_t *)out, sizeof(tslog_page_t))) return false;
+
+    return out->header.sequence != TSLOG_EMPTY &&
+           out->header.magic == TSLOG_MAGIC + log &&
+           out->header.checksum == _tslog_checksum(out);
+}
+
+static uint8_t _tslog_page_count(const tslog_page_t *page) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < TSLOG_RECORDS_PER_PAGE; i++) {
+        if (page->records[i].timestamp != TSLOG_EMPTY) count++;
+    }
+
+    return count;
+}
+
+static bool _tslog_page_is_blank(tslog_id_t log, uint8_t page) {
+    uint8_t buf[NVMCTRL_PAGE_SIZE];
+    if (!watch_storage_read(_tslog_row(log, page), _tslog_offset(page), buf, sizeof(buf))) return false;
+    for (uint8_t i = 0; i < sizeof(buf); i++) {
+        if (buf[i] != 0xFF) return false;
+    }
+
+    return true;
+}
+
+static bool _tslog_ready(tslog_id_t log) {
+    tslog_state_t *state = &_tslog_state[log];
+    if (state->ready) return true;
+    if (!filesystem_reserved_rows_free()) return false;
+
+    memset(state, 0, sizeof(tslog_state_t));
+
+    // the newest good page is the one with the highest sequence number; writing carries on right after it.
+    tslog_page_t page;
+    bool found = false;
+    uint32_t newest_sequence = 0;
+    uint8_t newest_page = 0;
+    for (uint8_t i = 0; i < _tslog_num_pages(log); i++) {
+        if (!_tslog_read_page(log, i, &page)) continue;
+        state->count += _tslog_page_count(&page);
+        if (!found || page.header.sequence > newest_sequence) {
+            found = true;
+            newest_sequence = page.header.sequence;
+            newest_page = i;
+        }
+    }
+    if (found) {
+        state->next_sequence = newest_sequence + 1;
+        state->next_page = (newest_page + 1) % _tslog_num_pages(log);
+    }
+
+    // a page that isn't blank in the middle of a row means a write was cut short; carry on from the next row.
+    if (state->next_page % TSLOG_PAGES_PER_ROW && !_tslog_page_is_blank(log, state->next_page)) {
+        state->next_page = ((state->next_page / TSLOG_PAGES_PER_ROW + 1) * TSLOG_PAGES_PER_ROW) % _tslog_num_pages(log);
+    }
+
+    state->ready = true;
+
+    return true;
+}
+
+// The queue only fills up when pages come faster than the NVM can take them; wait for it to drain then.
+static bool _tslog_queue_erase(uint32_t row) {
+    if (watch_storage_erase_async(row, NULL, NULL)) return true;
+    watch_storage_sync();
+    return watch_storage_erase_async(row, NULL, NULL);
+}
+
+static bool _tslog_queue_write(uint32_t row, uint32_t offset, const uint8_t *buf) {
+    if (watch_storage_write_async(row, offset, buf, NVMCTRL_PAGE_SIZE, NULL, NULL)) return true;
+    watch_storage_sync();
+    return watch_storage_write_async(row, offset, buf, NVMCTRL_PAGE_SIZE, NULL, NULL);
+}
+
+static bool _tslog_write_page(tslog_id_t log) {
+    tslog_state_t *state = &_tslog_state[log];
+    uint32_t row = _tslog_row(log, state->next_page);
+    tslog_page_t page;
+
+    // starting a row means erasing it, and with it the oldest records in the log.
+    if (state->next_page % TSLOG_PAGES_PER_ROW == 0) {
+        for (uint8_t i = 0; i < TSLOG_PAGES_PER_ROW; i++) {
+            if (_tslog_read_page(log, state->next_page + i, &page)) state->count -= _tslog_page_count(&page);
+        }
+        if (!_tslog_queue_erase(row)) return false;
+    }
+
+    uint8_t buf[NVMCTRL_PAGE_SIZE];
+    memset(buf, 0xFF, sizeof(buf));
+    memcpy(page.records, state->pending, state->num_pending * sizeof(tslog_record_t));
+    memset(&page.records[state->num_pending], 0xFF, (TSLOG_RECORDS_PER_PAGE - state->num_pending) * sizeof(tslog_record_t));
+    page.header.sequence = state->next_sequence;
+    page.header.magic = TSLOG_MAGIC + log;
+    page.header.checksum = _tslog_checksum(&page);
+    memcpy(buf, &page, sizeof(tslog_page_t));
+
+    // the queue keeps its own copy of the page, and runs it after the erase above.
+    bool success = _tslog_queue_write(row, _tslog_offset(state->next_page), buf);
+
+    // either way, the page can't be written again until its row is erased.
+    if (success) state->count += state->num_pending;
+    state->num_pending = 0;
+    state->next_sequence++;
+    state->next_page = (state->next_page + 1) % _tslog_num_pages(log);
+
+    return success;
+}
+
+bool tslog_append(tslog_id_t log, uint32_t timestamp, int16_t value) {
+    if (!_tslog_ready(log)) return false;
+
+    tslog_state_t *state = &_tslog_state[log];
+    state->pending[state->num_pending].timestamp = timestamp;
+    state->pending[state->num_pending].value = value;
+    state->num_pending++;
+
+    if (state->num_pending == TSLOG_RECORDS_PER_PAGE) return _tslog_write_page(log);
+
+    return true;
+}
+
+bool tslog_flush(tslog_id_t log) {
+    if (!_tslog_ready(log)) return false;
+    if (_tslog_state[log].num_pending == 0) return true;
+
+    return _tslog_write_page(log);
+}
+
+void tslog_iterate_since(tslog_id_t log, uint32_t since, tslog_callback_t callback, void *context) {
+    if (!_tslog_ready(log)) return;
+
+    tslog_state_t *state = &_tslog_state[log];
+    tslog_page_t page;
+
+    // going around the ring from the write position visits the pages from oldest to newest.
+    for (uint8_t i = 0; i < _tslog_num_pages(log); i++) {
+        if (!_tslog_read_page(log, (state->next_page + i) % _tslog_num_pages(log), &page)) continue;
+        for (uint8_t j = 0; j < TSLOG_RECORDS_PER_PAGE; j++) {
+            if (page.records[j].timestamp == TSLOG_EMPTY || page.records[j].timestamp < since) continue;
+            if (!callback(&page.records[j], context)) return;
+        }
+    }
+
+    for (uint8_t j = 0; j < state->num_pending; j++) {
+        if (state->pending[j].timestamp < since) continue;
+        if (!callback(&state->pending[j], context)) return;
+    }
+}
+
+uint16_t tslog_count(tslog_id_t log) {
+    if (!_tslog_ready(log)) return 0;
+
+    return _tslog_state[log].count + _tslog_state[log].num_pending;
+}
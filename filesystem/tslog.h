@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch.h"
+#include "filesystem.h"
+
+/*
+ * TSLOG: fixed-record time series logs in the storage rows after the filesystem.
+ *
+ * Each log owns a fixed range of rows and fills it as a ring. Records are collected in RAM and written a page at a
+ * time, behind a header holding a sequence number and a checksum; on startup, the page with the highest sequence
+ * number among those whose checksum is good tells where to carry on. When the ring comes back around to a row, the
+ * row is erased before its first page is written, so every row gets erased once per trip around the ring and no
+ * more. None of this goes through littlefs, so appending costs no metadata updates.
+ *
+ * Records waiting for a full page are lost on reset, unless they were written out with tslog_flush. That costs the
+ * rest of the page, so it's meant for logs that append rarely.
+ *
+ * Pages and erases go through the storage queue (watch_storage_write_async), so appending doesn't wait for the NVM
+ * controller; the page is on its way to the storage by the time tslog_append or tslog_flush returns.
+ */
+
+typedef enum {
+    TSLOG_TEMPERATURE = 0,
+    TSLOG_ACTIVITY,
+    TSLOG_NUM_LOGS
+} tslog_id_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t timestamp;     // UTC unix time
+    int16_t value;
+} tslog_record_t;
+
+/// A callback for tslog_iterate_since. Return false to stop iterating.
+typedef bool (*tslog_callback_t)(const tslog_record_t *record, void *context);
+
+/** @brief Appends a record to a log.
+  * @param log the log to append to
+  * @param timestamp the record's UTC unix time
+  * @param value the record's value
+  * @return true if the record was logged; false if the storage couldn't be queued, or if the filesystem
+  *         still spans the log's rows (see filesystem_reserved_rows_free).
+  */
+bool tslog_append(tslog_id_t log, uint32_t timestamp, int16_t value);
+
+/** @brief Writes out any records still waiting for a full page.
+  * @param log the log to flush
+  * @return true if there was nothing to write or the write was queued; false otherwise
+  */
+bool tslog_flush(tslog_id_t log);
+
+/** @brief Calls a function for every record in a log with a timestamp at or after the one given, oldest first.
+  * @param log the log to go through
+  * @param since the UTC unix time of the oldest record you're interested in; 0 for all of them.
+  * @param callback called with each record, until it returns false
+  * @param context passed to the callback
+  */
+void tslog_iterate_since(tslog_id_t log, uint32_t since, tslog_callback_t callback, void *context);
+
+/** @brief Gets the number of records in a log.
+  * @param log the log
+  * @return the number of records that tslog_iterate_since(log, 0, ...) would go through.
+  */
+uint16_t tslog_count(tslog_id_t log);
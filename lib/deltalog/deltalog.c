@@ -0,0 +1,204 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "deltalog.h"
+
+static void _deltalog_put_u32(uint8_t *buf, uint32_t value) {
+    buf[0] = value;
+    buf[1] = value >> 8;
+    buf[2] = value >> 16;
+    buf[3] = value >> 24;
+}
+
+static uint32_t _deltalog_get_u32(const uint8_t *buf) {
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static uint16_t _deltalog_get_count(const uint8_t *block) {
+    return block[8] | (block[9] << 8);
+}
+
+static uint8_t _deltalog_varint_size(uint32_t value) {
+    uint8_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static uint16_t _deltalog_put_varint(uint8_t *buf, uint32_t value) {
+    uint16_t i = 0;
+    while (value >= 0x80) {
+        buf[i++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    buf[i++] = value;
+    return i;
+}
+
+// Returns false if the varint runs past the end of the block, or is longer than any value the encoder writes.
+static bool _deltalog_get_varint(deltalog_decoder_t *decoder, uint32_t *value) {
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (decoder->position >= decoder->block_size) return false;
+        uint8_t byte = decoder->block[decoder->position++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// zigzag encoding maps signed values to unsigned ones so that small changes either way stay small: 0, -1, 1, -2...
+static uint32_t _deltalog_zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t _deltalog_unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+void deltalog_encoder_init(deltalog_encoder_t *encoder, uint8_t *block, uint16_t block_size) {
+    encoder->block = block;
+    encoder->block_size = block_size;
+    encoder->used = DELTALOG_HEADER_SIZE;
+    encoder->count = 0;
+    encoder->last_timestamp = 0;
+    encoder->last_value = 0;
+}
+
+bool deltalog_encoder_append(deltalog_encoder_t *encoder, uint32_t timestamp, int32_t value) {
+    if (encoder->count == 0) {
+        if (encoder->block_size < DELTALOG_HEADER_SIZE) return false;
+        _deltalog_put_u32(encoder->block, timestamp);
+        _deltalog_put_u32(encoder->block + 4, (uint32_t)value);
+    } else {
+        if (timestamp < encoder->last_timestamp) return false;
+        // 0xFFFF is what an erased block reads as.
+        if (encoder->count == 0xFFFE) return false;
+
+        uint32_t time_delta = timestamp - encoder->last_timestamp;
+        // computed unsigned, so that a swing across the whole range wraps instead of overflowing; the decoder wraps back.
+        uint32_t value_delta = _deltalog_zigzag((int32_t)((uint32_t)value - (uint32_t)encoder->last_value));
+        uint16_t size = _deltalog_varint_size(time_delta) + _deltalog_varint_size(value_delta);
+        if (encoder->used + size > encoder->block_size) return false;
+
+        encoder->used += _deltalog_put_varint(encoder->block + encoder->used, time_delta);
+        encoder->used += _deltalog_put_varint(encoder->block + encoder->used, value_delta);
+    }
+
+    encoder->count++;
+    encoder->block[8] = encoder->count;
+    encoder->block[9] = encoder->count >> 8;
+    encoder->last_timestamp = timestamp;
+    encoder->last_value = value;
+
+    return true;
+}
+
+bool deltalog_decoder_init(deltalog_decoder_t *decoder, const uint8_t *block, uint16_t block_size) {
+    decoder->block = block;
+    decoder->block_size = block_size;
+    decoder->position = DELTALOG_HEADER_SIZE;
+    decoder->remaining = 0;
+
+    if (block_size < DELTALOG_HEADER_SIZE) return false;
+    uint16_t count = _deltalog_get_count(block);
+    if (count == 0 || count == 0xFFFF) return false;
+
+    decoder->remaining = count;
+    return true;
+}
+
+bool deltalog_decoder_next(deltalog_decoder_t *decoder, uint32_t *timestamp, int32_t *value) {
+    if (decoder->remaining == 0) return false;
+
+    if (decoder->remaining == _deltalog_get_count(decoder->block)) {
+        decoder->timestamp = _deltalog_get_u32(decoder->block);
+        decoder->value = (int32_t)_deltalog_get_u32(decoder->block + 4);
+    } else {
+        uint32_t time_delta, value_delta;
+        if (!_deltalog_get_varint(decoder, &time_delta) || !_deltalog_get_varint(decoder, &value_delta)) {
+            decoder->remaining = 0;
+            return false;
+        }
+        decoder->timestamp += time_delta;
+        decoder->value = (int32_t)((uint32_t)decoder->value + (uint32_t)_deltalog_unzigzag(value_delta));
+    }
+
+    decoder->remaining--;
+    *timestamp = decoder->timestamp;
+    *value = decoder->value;
+
+    return true;
+}
+
+bool deltalog_read_header(const uint8_t *header, uint32_t *timestamp) {
+    uint16_t count = _deltalog_get_count(header);
+    if (count == 0 || count == 0xFFFF) return false;
+
+    *timestamp = _deltalog_get_u32(header);
+    return true;
+}
+
+uint32_t deltalog_seek(uint32_t num_blocks, uint32_t timestamp, deltalog_read_cb_t read, void *context) {
+    uint8_t header[DELTALOG_HEADER_SIZE];
+    uint32_t block_timestamp;
+
+    // Find the last block that starts at or before the timestamp. Everything from there on is at or after the start
+    // of that block, so the first sample we're after is either in it or at the start of the next block that has any.
+    uint32_t low = 0;
+    uint32_t high = num_blocks;
+    uint32_t found = num_blocks;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        // an empty block has no timestamp of its own; probe the next one that has samples instead.
+        uint32_t probe = middle;
+        bool has_samples = false;
+        while (probe < high) {
+            if (read(probe, header, context) && deltalog_read_header(header, &block_timestamp)) {
+                has_samples = true;
+                break;
+            }
+            probe++;
+        }
+
+        if (!has_samples) {
+            high = middle;
+        } else if (block_timestamp <= timestamp) {
+            found = probe;
+            low = probe + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // no block starts at or before the timestamp, so the first sample we're after is the first one in the log.
+    if (found == num_blocks) return 0;
+
+    return found;
+}
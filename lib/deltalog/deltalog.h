@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DELTALOG_H
+#define DELTALOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * DELTALOG: a compact block format for sensor logs.
+ *
+ * A log is a run of fixed-size blocks, each one sized to whatever the storage writes at once: a 64-byte page of the
+ * storage area, a 256-byte row, or a chunk of a littlefs file. Every block starts with a header that holds its
+ * first sample in full:
+ *
+ *     offset  size  field
+ *     0       4     base timestamp, little endian
+ *     4       4     base value, little endian
+ *     8       2     number of samples in the block, little endian; 0xFFFF in an erased block reads as empty
+ *
+ * Each sample after the first is stored as the time since the previous sample as an unsigned LEB128 varint,
+ * followed by the change in value since the previous sample, zigzag encoded and then stored the same way. A
+ * sample taken on a regular schedule whose value barely moved costs two bytes.
+ *
+ * Since the blocks are all the same size, their headers double as an index at a fixed stride: deltalog_seek finds
+ * the block holding a timestamp with a binary search over the headers alone, and only that block gets decoded.
+ * The encoder and decoder only touch the block buffer they're given, so where the blocks come from and go to is up
+ * to the caller. utils/deltalog builds the same code on the host.
+ */
+
+#define DELTALOG_HEADER_SIZE (10)
+
+/// The most a single sample can take up in the body of a block: a five-byte varint for each delta.
+#define DELTALOG_MAX_SAMPLE_SIZE (10)
+
+typedef struct {
+    uint8_t *block;
+    uint16_t block_size;
+    uint16_t used;
+    uint16_t count;
+    uint32_t last_timestamp;
+    int32_t last_value;
+} deltalog_encoder_t;
+
+typedef struct {
+    const uint8_t *block;
+    uint16_t block_size;
+    uint16_t position;
+    uint16_t remaining;
+    uint32_t timestamp;
+    int32_t value;
+} deltalog_decoder_t;
+
+/** @brief Starts a new, empty block.
+  * @param encoder the encoder to set up
+  * @param block a buffer of block_size bytes that the block is built in
+  * @param block_size the size of the blocks in the log; at least DELTALOG_HEADER_SIZE
+  */
+void deltalog_encoder_init(deltalog_encoder_t *encoder, uint8_t *block, uint16_t block_size);
+
+/** @brief Adds a sample to the block.
+  * @param encoder the encoder
+  * @param timestamp the sample's timestamp; it may not be earlier than the previous sample's.
+  * @param value the sample's value
+  * @return true if the sample was added; false if the block is full or the timestamp goes backwards. In the first
+  *         case, store the block and start the next one with deltalog_encoder_init.
+  * @note The unused tail of the block is left as it was, so for storage that erases to 0xFF, fill the block with
+  *       0xFF before starting it and the tail will cost nothing to program.
+  */
+bool deltalog_encoder_append(deltalog_encoder_t *encoder, uint32_t timestamp, int32_t value);
+
+/** @brief Starts decoding a block.
+  * @param decoder the decoder to set up
+  * @param block the block's contents
+  * @param block_size the size of the blocks in the log
+  * @return true if the block holds any samples; false if it's empty or erased.
+  */
+bool deltalog_decoder_init(deltalog_decoder_t *decoder, const uint8_t *block, uint16_t block_size);
+
+/** @brief Decodes the next sample in the block.
+  * @param decoder the decoder
+  * @param timestamp set to the sample's timestamp
+  * @param value set to the sample's value
+  * @return true if there was a sample; false at the end of the block, or if the block is corrupt.
+  */
+bool deltalog_decoder_next(deltalog_decoder_t *decoder, uint32_t *timestamp, int32_t *value);
+
+/** @brief Reads a block's base timestamp out of its header.
+  * @param header at least DELTALOG_HEADER_SIZE bytes from the start of a block
+  * @param timestamp set to the block's base timestamp
+  * @return true if the block holds any samples; false if it's empty or erased.
+  */
+bool deltalog_read_header(const uint8_t *header, uint32_t *timestamp);
+
+/// Called by deltalog_seek to read the first DELTALOG_HEADER_SIZE bytes of a block. Returns false if it can't.
+typedef bool (*deltalog_read_cb_t)(uint32_t block_index, uint8_t *header, void *context);
+
+/** @brief Finds the block to start decoding from to get to the first sample at or after a timestamp.
+  * @param num_blocks the number of blocks in the log, oldest first
+  * @param timestamp the timestamp to look for
+  * @param read called to read a block's header, about log2(num_blocks) times
+  * @param context passed to read
+  * @return the index of the last block that starts at or before timestamp, or 0 if there is none.
+  * @note Decode from the block that's returned, skipping samples before timestamp and carrying on into the blocks
+  *       after it if need be. Blocks that are empty or can't be read are stepped over, as long as the timestamps
+  *       of the others only go forward; they're expected at the end of a log that isn't full yet, so a log with
+  *       many of them in the middle won't seek in O(log n).
+  */
+uint32_t deltalog_seek(uint32_t num_blocks, uint32_t timestamp, deltalog_read_cb_t read, void *context);
+
+#endif // DELTALOG_H
@@ -23,7 +23,6 @@
  * SOFTWARE.
  */
 
-#define MOVEMENT_LONG_PRESS_TICKS 64
 #define MOVEMENT_REALLY_LONG_PRESS_TICKS 192
 #define MOVEMENT_MAX_LONG_PRESS_TICKS 1280 // get a chance to check if a button held down over 10 seconds is a glitch
 
@@ -34,10 +33,12 @@
 #include "app.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "watch_common_display.h"
 #include "usb.h"
 #include "watch_private.h"
 #include "movement.h"
 #include "filesystem.h"
+#include "prefs.h"
 #include "shell.h"
 #include "utz.h"
 #include "zones.h"
@@ -47,6 +48,10 @@
 #include "thermistor_driver.h"
 
 #include "movement_config.h"
+#include "movement_event_queue.h"
+#include "movement_gestures.h"
+#include "movement_task_list.h"
+#include "movement_tz.h"
 
 #include "movement_custom_signal_tunes.h"
 
@@ -59,7 +64,18 @@ void _wake_up_simulator(void);
 
 volatile movement_state_t movement_state;
 void * watch_face_contexts[MOVEMENT_NUM_FACES];
-watch_date_time_t scheduled_tasks[MOVEMENT_NUM_FACES];
+
+#ifndef MOVEMENT_CONTEXT_ARENA_SIZE
+#define MOVEMENT_CONTEXT_ARENA_SIZE (1024)
+#endif
+#define MOVEMENT_CONTEXT_ALIGNMENT (8)
+
+// Watch face contexts are allocated once at boot and never freed, so we hand them out from a static region
+// with a bump pointer, instead of paying for heap headers and fragmentation.
+static uint8_t _movement_context_arena[MOVEMENT_CONTEXT_ARENA_SIZE] __attribute__((aligned(MOVEMENT_CONTEXT_ALIGNMENT)));
+static size_t _movement_context_arena_used = 0;
+static size_t _movement_context_heap_used = 0;
+static uint16_t _movement_context_allocations = 0;
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 600, 3600, 7200, 21600, 43200, 86400, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
 
@@ -79,23 +95,32 @@ typedef struct {
 #endif
 } movement_button_t;
 
+static volatile movement_event_queue_t _movement_event_queue;
+
+// What app_loop can take in one iteration: a pending activate, a full event queue and one of each accelerometer event.
+#define MOVEMENT_MAX_ACCELEROMETER_EVENTS (2)
+#define MOVEMENT_MAX_PENDING_EVENTS (1 + MOVEMENT_EVENT_QUEUE_MAX_DRAIN + MOVEMENT_MAX_ACCELEROMETER_EVENTS)
+_Static_assert(MOVEMENT_MAX_PENDING_EVENTS <= UINT8_MAX, "app_loop counts pending events in a byte");
+
 /* Pieces of state that can be modified by the various interrupt callbacks.
    The interrupt writes state changes here, and it will be acted upon on the next app_loop invokation.
 */
 typedef struct {
-    volatile uint32_t pending_events;
+    volatile bool has_pending_activate;
     volatile bool turn_led_off;
     volatile bool has_pending_sequence;
     volatile bool enter_sleep_mode;
     volatile bool exit_sleep_mode;
     volatile bool is_sleeping;
-    volatile uint8_t subsecond;
     volatile rtc_counter_t minute_counter;
     volatile bool minute_alarm_fired;
     volatile bool is_buzzing;
     volatile uint8_t pending_sequence_priority;
     volatile bool schedule_next_comp;
     volatile bool has_pending_accelerometer;
+    volatile bool background_task_due;
+    volatile bool has_fired_timers;
+    volatile bool gesture_timeout_due;
 
     // button tracking for long press
     movement_button_t mode_button;
@@ -108,6 +133,94 @@ typedef struct {
 
 movement_volatile_state_t movement_volatile_state;
 
+/* Background tasks scheduled by the faces, in a list sorted by deadline (see movement_task_list.h).
+   Only the head of the list has an RTC comparator armed.
+*/
+// Deadlines further away than this are reached in several hops, keeping the comparator counter far from overflowing.
+#define MOVEMENT_MAX_BACKGROUND_TASK_DELAY (86400)
+
+static movement_scheduled_task_t _movement_scheduled_tasks[MOVEMENT_NUM_FACES];
+static movement_task_list_t _movement_task_list = {
+    .tasks = _movement_scheduled_tasks,
+    .num_tasks = MOVEMENT_NUM_FACES,
+    .head = MOVEMENT_NO_SCHEDULED_TASK,
+};
+
+/* Wake intents registered by the faces, and the next UTC timestamp at which each face's advise function is due.
+   At the top of the minute, advise is only called for the faces that are due.
+*/
+#define MOVEMENT_ADVISE_NEVER (UINT32_MAX)
+
+static movement_wake_intent_t _movement_wake_intents[MOVEMENT_NUM_FACES];
+static unix_timestamp_t _movement_next_advise[MOVEMENT_NUM_FACES];
+static unix_timestamp_t _movement_next_advise_any = 0;
+static uint8_t _movement_num_advising_faces = 0;
+static uint32_t _movement_advise_calls_made = 0;
+static uint32_t _movement_advise_calls_avoided = 0;
+
+// Timers started by the faces. Only the main loop touches this list; the interrupt just flags the timers that fired.
+static movement_timer_t *_movement_running_timers = NULL;
+
+typedef struct {
+    movement_timer_t timer;
+    const char *text;               // the marquee text, or NULL when playing a list of frames
+    const char * const *frames;
+    uint32_t frame_ms;
+    uint8_t length;                 // length of the marquee text
+    uint8_t num_frames;             // frames in the list, or steps the marquee takes
+    uint8_t frame;                  // the frame on screen
+    uint8_t position;
+    uint8_t width;
+    bool repeat;
+    bool running;
+} movement_animation_state_t;
+
+static movement_gesture_state_t _movement_gestures;
+static watch_rtc_comp_t _movement_gesture_comp;
+
+static movement_animation_state_t _movement_animation;
+
+#ifdef MOVEMENT_ENABLE_STATS
+/* Per-face accounting of where the CPU time goes, enabled with `make STATS=1`.
+   Times are in CPU clock cycles on hardware and in microseconds in the simulator.
+   Time on screen at each tick frequency is in RTC counter ticks.
+*/
+#define MOVEMENT_STATS_TICK_MODE_MINUTE (8)
+#define MOVEMENT_STATS_TICK_MODE_NONE (9)
+#define MOVEMENT_STATS_NUM_TICK_MODES (10)
+
+typedef struct {
+    uint32_t loop_time;
+    uint32_t advise_time;
+    uint32_t activate_time;
+    uint32_t resign_time;
+    uint32_t loop_calls;
+    uint32_t advise_calls;
+    uint32_t activate_calls;
+    uint32_t resign_calls;
+    uint32_t kept_awake;
+    uint32_t tick_mode_time[MOVEMENT_STATS_NUM_TICK_MODES];
+} movement_face_stats_t;
+
+typedef struct {
+    uint32_t top_of_minute_time;
+    uint32_t scheduled_tasks_time;
+    uint32_t top_of_minute_calls;
+    uint32_t scheduled_tasks_calls;
+    uint32_t low_energy_updates;
+} movement_stats_t;
+
+static movement_face_stats_t _movement_face_stats[MOVEMENT_NUM_FACES];
+static movement_stats_t _movement_stats;
+static rtc_counter_t _movement_stats_tick_mode_since;
+static unix_timestamp_t _movement_stats_since;
+#endif
+
+// Wakeup accounting, to verify how often the current face keeps us awake.
+static uint32_t _movement_wake_count = 0;
+static unix_timestamp_t _movement_wake_count_since = 0;
+static bool _movement_did_sleep = false;
+
 // The last sequence that we have been asked to play while the watch was in deep sleep
 static int8_t *_pending_sequence;
 
@@ -125,14 +238,19 @@ int8_t alarm_tune[] = {
     0
 };
 
-int8_t _movement_dst_offset_cache[NUM_ZONE_NAMES] = {0};
-#define TIMEZONE_DOES_NOT_OBSERVE (-127)
+// The time as seen by everyone handling events in the current iteration of the loop. @see movement_get_time_snapshot
+static movement_time_snapshot_t _movement_time_snapshot;
+static bool _movement_time_snapshot_is_active = false;
+static bool _movement_time_snapshot_is_valid = false;
+static watch_date_time_cache_t _movement_utc_date_time_cache;
+static watch_date_time_cache_t _movement_local_date_time_cache;
 
 void cb_mode_btn_interrupt(void);
 void cb_light_btn_interrupt(void);
 void cb_alarm_btn_interrupt(void);
 void cb_alarm_btn_extwake(void);
 void cb_minute_alarm_fired(void);
+void cb_background_task_fired(void);
 void cb_tick(void);
 void cb_mode_btn_timeout_interrupt(void);
 void cb_light_btn_timeout_interrupt(void);
@@ -156,18 +274,6 @@ void yield(void) {
 }
 #endif
 
-static udatetime_t _movement_convert_date_time_to_udate(watch_date_time_t date_time) {
-    return (udatetime_t) {
-        .date.dayofmonth = date_time.unit.day,
-        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR), date_time.unit.month, date_time.unit.day),
-        .date.month = date_time.unit.month,
-        .date.year = UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR),
-        .time.hour = date_time.unit.hour,
-        .time.minute = date_time.unit.minute,
-        .time.second = date_time.unit.second
-    };
-}
-
 static watch_buzzer_volume_t _movement_get_buzzer_volume(movement_buzzer_priority_t priority) {
     switch (priority) {
         case BUZZER_PRIORITY_BUTTON:
@@ -216,34 +322,6 @@ static void _movement_set_top_of_minute_alarm() {
     movement_volatile_state.schedule_next_comp = true;
 }
 
-static bool _movement_update_dst_offset_cache(void) {
-    uzone_t local_zone;
-    udatetime_t udate_time;
-    bool dst_changed = false;
-    watch_date_time_t system_date_time = watch_rtc_get_date_time();
-
-    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
-        unpack_zone(&zone_defns[i], "", &local_zone);
-        watch_date_time_t date_time = watch_utility_date_time_convert_zone(system_date_time, 0, local_zone.offset.hours * 3600 + local_zone.offset.minutes * 60);
-
-        if (!!local_zone.rules_len) {
-            // if local zone has DST rules, we need to see if DST applies.
-            udate_time = _movement_convert_date_time_to_udate(date_time);
-            uoffset_t offset;
-            get_current_offset(&local_zone, &udate_time, &offset);
-            int8_t new_offset = (offset.hours * 60 + offset.minutes) / 15;
-            if (_movement_dst_offset_cache[i] != new_offset) {
-                _movement_dst_offset_cache[i] = new_offset;
-                dst_changed = true;
-            }
-        } else {
-            // otherwise set the cache to a constant value that indicates no DST check needs to be performed.
-            _movement_dst_offset_cache[i] = TIMEZONE_DOES_NOT_OBSERVE;
-        }
-    }
-
-    return dst_changed;
-}
 
 static inline void _movement_reset_inactivity_countdown(void) {
     rtc_counter_t counter = watch_rtc_get_counter();
@@ -283,6 +361,7 @@ static void _movement_renew_top_of_minute_alarm(void) {
     movement_volatile_state.schedule_next_comp = true;
 }
 
+// Returns at most MOVEMENT_MAX_ACCELEROMETER_EVENTS events.
 static uint32_t _movement_get_accelerometer_events() {
     uint32_t accelerometer_events = 0;
 
@@ -312,12 +391,6 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
         &movement_volatile_state.alarm_button
     };
 
-    uint32_t button_events_masks[3] = {
-        _movement_mode_button_events_mask,
-        _movement_light_button_events_mask,
-        _movement_alarm_button_events_mask,
-    };
-
     for (uint8_t i = 0; i < 3; i++) {
         movement_button_t* button = buttons[i];
 
@@ -325,8 +398,6 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
         if (pending_events & (1 << button->down_event)) {
             watch_rtc_register_comp_callback_no_schedule(button->cb_longpress, button->down_timestamp + MOVEMENT_LONG_PRESS_TICKS, button->timeout_index);
             any_down = true;
-            // this button's events will start getting passed to the face
-            movement_volatile_state.passthrough_events &= ~button_events_masks[i];
         }
 
         // If a long press occurred
@@ -369,57 +440,308 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
     }
 }
 
-static void _movement_handle_top_of_minute(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
+static unix_timestamp_t _movement_get_next_advise(uint8_t watch_face_index, unix_timestamp_t now) {
+    movement_wake_intent_t intent = _movement_wake_intents[watch_face_index];
+    uint16_t interval;
+    uint16_t next_minute_of_day;
+
+    if (watch_faces[watch_face_index].advise == NULL) return MOVEMENT_ADVISE_NEVER;
+
+    switch (intent.type) {
+        case MOVEMENT_WAKE_EVERY_MINUTE:
+            return now - (now % 60) + 60;
+        case MOVEMENT_WAKE_NEVER:
+            return MOVEMENT_ADVISE_NEVER;
+        default:
+            break;
+    }
+
+    // the remaining intents are relative to local midnight
+    int32_t offset = movement_get_current_timezone_offset();
+    unix_timestamp_t local_now = now + offset;
+    unix_timestamp_t local_midnight = local_now - (local_now % 86400);
+    uint16_t minute_of_day = (local_now % 86400) / 60;
+
+    if (intent.type == MOVEMENT_WAKE_DAILY) {
+        next_minute_of_day = intent.hour * 60 + intent.minute;
+        if (next_minute_of_day <= minute_of_day) next_minute_of_day += 1440;
+    } else {
+        interval = intent.type == MOVEMENT_WAKE_TOP_OF_HOUR ? 60 : intent.interval;
+        if (interval == 0) interval = 1;
+        next_minute_of_day = (minute_of_day / interval + 1) * interval;
+        // intervals that don't divide the day evenly start over at midnight
+        if (next_minute_of_day > 1440) next_minute_of_day = 1440;
+    }
+
+    return local_midnight + next_minute_of_day * 60 - offset;
+}
 
-    // update the DST offset cache every 30 minutes, since someplace in the world could change.
-    if (date_time.unit.minute % 30 == 0) {
-        _movement_update_dst_offset_cache();
+static void _movement_update_next_advise_any(void) {
+    _movement_next_advise_any = MOVEMENT_ADVISE_NEVER;
+    _movement_num_advising_faces = 0;
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        if (watch_faces[i].advise != NULL) _movement_num_advising_faces++;
+        if (_movement_next_advise[i] < _movement_next_advise_any) _movement_next_advise_any = _movement_next_advise[i];
+    }
+}
+
+// Recomputes when each face needs to be advised. Called when the time, time zone or DST offset changes.
+static void _movement_reset_advise_schedule(void) {
+    // count from just before the start of the current minute, so that a face due this minute is still advised; the
+    // top of minute handler may be running a little late, and rounds its own time to the minute too.
+    unix_timestamp_t now = watch_rtc_get_unix_time() / 60 * 60 - 1;
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        _movement_next_advise[i] = _movement_get_next_advise(i, now);
+    }
+    _movement_update_next_advise_any();
+}
+
+#ifdef MOVEMENT_ENABLE_STATS
+
+#if !__EMSCRIPTEN__
+// TC2 and TC3 together, as a free running 32-bit counter of CPU clock cycles. Nothing else uses them, unlike SysTick,
+// which delay_ms reprograms with a short period. The counter stops in standby, so time spent asleep isn't counted.
+#define MOVEMENT_STATS_TC (2)
+#define MOVEMENT_STATS_TC_REGS (TC2)
+static bool _movement_stats_counter_running = false;
+#endif
+
+static inline uint32_t _movement_stats_now(void) {
+#if __EMSCRIPTEN__
+    return (uint32_t)(emscripten_get_now() * 1000);
+#else
+    if (!_movement_stats_counter_running) {
+        tc_init(MOVEMENT_STATS_TC, GENERIC_CLOCK_0, TC_PRESCALER_DIV1);
+        tc_set_counter_mode(MOVEMENT_STATS_TC, TC_COUNTER_MODE_32BIT);
+        tc_enable(MOVEMENT_STATS_TC);
+        _movement_stats_counter_running = true;
+    }
+    // COUNT can only be read after asking for it to be synchronized from the counter's clock domain.
+    MOVEMENT_STATS_TC_REGS->COUNT32.CTRLBSET.reg = TC_CTRLBSET_CMD_READSYNC;
+    while (MOVEMENT_STATS_TC_REGS->COUNT32.SYNCBUSY.bit.CTRLB);
+    while (MOVEMENT_STATS_TC_REGS->COUNT32.CTRLBSET.bit.CMD);
+    return MOVEMENT_STATS_TC_REGS->COUNT32.COUNT.reg;
+#endif
+}
+
+static inline uint32_t _movement_stats_elapsed(uint32_t start) {
+    // both clocks count up and wrap around at 32 bits.
+    return _movement_stats_now() - start;
+}
+
+static void _movement_stats_account_tick_mode(void) {
+    rtc_counter_t counter = watch_rtc_get_counter();
+    uint8_t mode;
+
+    switch (movement_state.tick_mode) {
+        case MOVEMENT_TICK_MODE_MINUTE:
+            mode = MOVEMENT_STATS_TICK_MODE_MINUTE;
+            break;
+        case MOVEMENT_TICK_MODE_NONE:
+            mode = MOVEMENT_STATS_TICK_MODE_NONE;
+            break;
+        default:
+            mode = movement_state.tick_pern;
+            break;
+    }
+
+    // in low energy mode, nothing is on screen
+    if (!movement_volatile_state.is_sleeping) {
+        _movement_face_stats[movement_state.current_face_idx].tick_mode_time[mode] += counter - _movement_stats_tick_mode_since;
+    }
+    _movement_stats_tick_mode_since = counter;
+}
+
+#endif
+
+static inline bool _movement_face_loop(uint8_t face_idx, movement_event_t event) {
+#ifdef MOVEMENT_ENABLE_STATS
+    uint32_t start = _movement_stats_now();
+    bool can_sleep = watch_faces[face_idx].loop(event, watch_face_contexts[face_idx]);
+    _movement_face_stats[face_idx].loop_time += _movement_stats_elapsed(start);
+    _movement_face_stats[face_idx].loop_calls++;
+    if (!can_sleep) _movement_face_stats[face_idx].kept_awake++;
+    return can_sleep;
+#else
+    return watch_faces[face_idx].loop(event, watch_face_contexts[face_idx]);
+#endif
+}
+
+static inline movement_watch_face_advisory_t _movement_face_advise(uint8_t face_idx) {
+#ifdef MOVEMENT_ENABLE_STATS
+    uint32_t start = _movement_stats_now();
+    movement_watch_face_advisory_t advisory = watch_faces[face_idx].advise(watch_face_contexts[face_idx]);
+    _movement_face_stats[face_idx].advise_time += _movement_stats_elapsed(start);
+    _movement_face_stats[face_idx].advise_calls++;
+    return advisory;
+#else
+    return watch_faces[face_idx].advise(watch_face_contexts[face_idx]);
+#endif
+}
+
+static inline void _movement_face_activate(uint8_t face_idx) {
+#ifdef MOVEMENT_ENABLE_STATS
+    uint32_t start = _movement_stats_now();
+    watch_faces[face_idx].activate(watch_face_contexts[face_idx]);
+    _movement_face_stats[face_idx].activate_time += _movement_stats_elapsed(start);
+    _movement_face_stats[face_idx].activate_calls++;
+#else
+    watch_faces[face_idx].activate(watch_face_contexts[face_idx]);
+#endif
+}
+
+static inline void _movement_face_resign(uint8_t face_idx) {
+#ifdef MOVEMENT_ENABLE_STATS
+    uint32_t start = _movement_stats_now();
+    watch_faces[face_idx].resign(watch_face_contexts[face_idx]);
+    _movement_face_stats[face_idx].resign_time += _movement_stats_elapsed(start);
+    _movement_face_stats[face_idx].resign_calls++;
+#else
+    watch_faces[face_idx].resign(watch_face_contexts[face_idx]);
+#endif
+}
+
+// Called from the interrupt callbacks only.
+static void _movement_queue_event(movement_event_type_t event_type, rtc_counter_t counter) {
+    if (event_type == EVENT_NONE) return;
+
+    // A tick that hasn't been handled yet is superseded by the next one, so it just gets a fresh timestamp.
+    movement_event_queue_push(&_movement_event_queue, event_type, counter, event_type == EVENT_TICK);
+}
+
+static uint8_t _movement_get_subsecond(rtc_counter_t counter) {
+    uint32_t freq = watch_rtc_get_frequency();
+    uint32_t half_freq = freq >> 1;
+    uint32_t subsecond_mask = freq - 1;
+
+    return ((counter + half_freq) & subsecond_mask) >> movement_state.tick_pern;
+}
+
+static inline void _movement_begin_time_snapshot(void) {
+    _movement_time_snapshot_is_active = true;
+    _movement_time_snapshot_is_valid = false;
+}
+
+static inline void _movement_end_time_snapshot(void) {
+    _movement_time_snapshot_is_active = false;
+    _movement_time_snapshot_is_valid = false;
+}
+
+static uint32_t _movement_get_button_events_mask(movement_event_type_t event_type) {
+    if (event_type >= EVENT_LIGHT_BUTTON_DOWN && event_type < EVENT_LIGHT_BUTTON_DOWN + 5) return _movement_light_button_events_mask;
+    if (event_type >= EVENT_MODE_BUTTON_DOWN && event_type < EVENT_MODE_BUTTON_DOWN + 5) return _movement_mode_button_events_mask;
+    if (event_type >= EVENT_ALARM_BUTTON_DOWN && event_type < EVENT_ALARM_BUTTON_DOWN + 5) return _movement_alarm_button_events_mask;
+    return 0;
+}
+
+static void _movement_run_top_of_minute(void) {
+    // round to the nearest minute, in case we are running a little late (or early)
+    unix_timestamp_t now = (watch_rtc_get_unix_time() + 30) / 60 * 60;
+
+    // update the DST offset cache when someplace in the world changes its offset.
+    if (now >= movement_tz_get_next_transition()) {
+        if (movement_tz_update(now, false)) {
+            _movement_reset_advise_schedule();
+        }
+    }
+
+    // if no face needs to be advised this minute, skip the fan-out entirely.
+    if (now < _movement_next_advise_any) {
+        _movement_advise_calls_avoided += _movement_num_advising_faces;
+        return;
     }
 
     for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
         // For each face that offers an advisory...
         if (watch_faces[i].advise != NULL) {
+            // ...and wants one this minute...
+            if (_movement_next_advise[i] > now) {
+                _movement_advise_calls_avoided++;
+                continue;
+            }
+            _movement_next_advise[i] = _movement_get_next_advise(i, now);
+
             // ...we ask for one.
-            movement_watch_face_advisory_t advisory = watch_faces[i].advise(watch_face_contexts[i]);
+            movement_watch_face_advisory_t advisory = _movement_face_advise(i);
+            _movement_advise_calls_made++;
 
             // If it wants a background task...
             if (advisory.wants_background_task) {
                 // we give it one. pretty straightforward!
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
+                _movement_face_loop(i, background_event);
             }
 
             // TODO: handle other advisory types
         }
     }
+
+    _movement_update_next_advise_any();
 }
 
-static void _movement_handle_scheduled_tasks(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-    uint8_t num_active_tasks = 0;
+static void _movement_handle_top_of_minute(void) {
+#ifdef MOVEMENT_ENABLE_STATS
+    uint32_t start = _movement_stats_now();
+    _movement_run_top_of_minute();
+    _movement_stats.top_of_minute_time += _movement_stats_elapsed(start);
+    _movement_stats.top_of_minute_calls++;
+#else
+    _movement_run_top_of_minute();
+#endif
+}
 
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg) {
-            if (scheduled_tasks[i].reg <= date_time.reg) {
-                scheduled_tasks[i].reg = 0;
-                movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
-                // check if loop scheduled a new task
-                if (scheduled_tasks[i].reg) {
-                    num_active_tasks++;
-                }
-            } else {
-                num_active_tasks++;
-            }
-        }
+static void _movement_set_background_task_alarm(void) {
+    unix_timestamp_t deadline;
+    movement_state.has_scheduled_background_task = movement_task_list_get_next_deadline(&_movement_task_list, &deadline);
+
+    if (!movement_state.has_scheduled_background_task) {
+        watch_rtc_disable_comp_callback_no_schedule(BACKGROUND_TASK_TIMEOUT);
+        movement_volatile_state.schedule_next_comp = true;
+        return;
     }
 
-    if (num_active_tasks == 0) {
-        movement_state.has_scheduled_background_task = false;
-    } else {
-        _movement_reset_inactivity_countdown();
+    uint32_t counter = watch_rtc_get_counter();
+    unix_timestamp_t now = watch_rtc_get_unix_time();
+    uint32_t freq = watch_rtc_get_frequency();
+    uint32_t half_freq = freq >> 1;
+    uint32_t subsecond_mask = freq - 1;
+    // if the deadline has already passed (i.e. the clock was moved forward), fire on the next second tick.
+    uint32_t delay = 1;
+
+    if (deadline > now) {
+        delay = deadline - now;
+        if (delay > MOVEMENT_MAX_BACKGROUND_TASK_DELAY) delay = MOVEMENT_MAX_BACKGROUND_TASK_DELAY;
+    }
+
+    // counter at the last second tick, shifted by half a second like the top of the minute alarm
+    uint32_t task_counter = counter & (~subsecond_mask);
+    task_counter += (counter & subsecond_mask) >= half_freq ? half_freq : -half_freq;
+    task_counter += delay * freq;
+
+    watch_rtc_register_comp_callback_no_schedule(cb_background_task_fired, task_counter, BACKGROUND_TASK_TIMEOUT);
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+static void _movement_handle_scheduled_tasks(void) {
+#ifdef MOVEMENT_ENABLE_STATS
+    uint32_t start = _movement_stats_now();
+#endif
+    unix_timestamp_t now = watch_rtc_get_unix_time();
+
+    // Tasks are sorted by deadline, so we only ever look at the head of the list.
+    uint8_t i;
+    while ((i = movement_task_list_pop_due(&_movement_task_list, now)) != MOVEMENT_NO_SCHEDULED_TASK) {
+        movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+        // the face may schedule a new task from its loop; that one is always in the future.
+        _movement_face_loop(i, background_event);
     }
+
+    _movement_set_background_task_alarm();
+#ifdef MOVEMENT_ENABLE_STATS
+    _movement_stats.scheduled_tasks_time += _movement_stats_elapsed(start);
+    _movement_stats.scheduled_tasks_calls++;
+#endif
 }
 
 void movement_request_tick_frequency(uint8_t freq) {
@@ -427,6 +749,10 @@ void movement_request_tick_frequency(uint8_t freq) {
     // If we are asked for an invalid frequency, default back to 1 Hz.
     if (freq == 0 || __builtin_popcount(freq) != 1) freq = 1;
 
+#ifdef MOVEMENT_ENABLE_STATS
+    _movement_stats_account_tick_mode();
+#endif
+
     // disable all periodic callbacks
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 
@@ -438,10 +764,29 @@ void movement_request_tick_frequency(uint8_t freq) {
 
     movement_state.tick_frequency = freq;
     movement_state.tick_pern = per_n;
+    movement_state.tick_mode = MOVEMENT_TICK_MODE_PERIODIC;
 
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+void movement_request_tick_mode(movement_tick_mode_t mode) {
+    if (mode == movement_state.tick_mode) return;
+
+    if (mode == MOVEMENT_TICK_MODE_PERIODIC) {
+        movement_request_tick_frequency(movement_state.tick_frequency);
+        return;
+    }
+
+#ifdef MOVEMENT_ENABLE_STATS
+    _movement_stats_account_tick_mode();
+#endif
+
+    // the periodic interrupt is what wakes us up every second, so disable it altogether.
+    // in minute mode, the top of the minute alarm (which is always running) delivers EVENT_TICK instead.
+    watch_rtc_disable_matching_periodic_callbacks(0xFF);
+    movement_state.tick_mode = mode;
+}
+
 void movement_illuminate_led(void) {
     if (movement_state.settings.bit.led_duration != 0b111) {
         movement_state.light_on = true;
@@ -533,23 +878,213 @@ void movement_cancel_background_task(void) {
 }
 
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time) {
-    watch_date_time_t now = watch_rtc_get_date_time();
-    if (date_time.reg > now.reg) {
-        movement_state.has_scheduled_background_task = true;
-        scheduled_tasks[watch_face_index].reg = date_time.reg;
+    unix_timestamp_t timestamp = watch_utility_date_time_to_unix_time(date_time, 0);
+    if (timestamp > watch_rtc_get_unix_time()) {
+        movement_task_list_schedule(&_movement_task_list, watch_face_index, timestamp);
+        _movement_set_background_task_alarm();
     }
 }
 
 void movement_cancel_background_task_for_face(uint8_t watch_face_index) {
-    scheduled_tasks[watch_face_index].reg = 0;
-    bool other_tasks_scheduled = false;
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg != 0) {
-            other_tasks_scheduled = true;
-            break;
+    movement_task_list_cancel(&_movement_task_list, watch_face_index);
+    _movement_set_background_task_alarm();
+}
+
+void movement_set_wake_intent(uint8_t watch_face_index, movement_wake_intent_t intent) {
+    _movement_wake_intents[watch_face_index] = intent;
+    _movement_next_advise[watch_face_index] = _movement_get_next_advise(watch_face_index, watch_rtc_get_unix_time());
+    _movement_update_next_advise_any();
+}
+
+static void _movement_unlink_timer(movement_timer_t *timer) {
+    movement_timer_t **link = &_movement_running_timers;
+    while (*link != NULL && *link != timer) {
+        link = &(*link)->next;
+    }
+    if (*link != NULL) *link = timer->next;
+    timer->running = false;
+}
+
+static void _movement_timer_fired(void *context) {
+    movement_timer_t *timer = (movement_timer_t *)context;
+    timer->fired = true;
+    movement_volatile_state.has_fired_timers = true;
+
+#if __EMSCRIPTEN__
+    _wake_up_simulator();
+#endif
+}
+
+static void _movement_handle_fired_timers(void) {
+    movement_timer_t *timer;
+
+    do {
+        // a callback may start or stop any timer, so start over from the top every time.
+        for (timer = _movement_running_timers; timer != NULL && !timer->fired; timer = timer->next);
+        if (timer != NULL) {
+            timer->fired = false;
+            _movement_unlink_timer(timer);
+            timer->callback(timer->context);
+        }
+    } while (timer != NULL);
+}
+
+void movement_timer_start(movement_timer_t *timer, uint32_t duration_ms, movement_timer_cb_t callback, void *context) {
+    // round up, so that the timer never expires early. duration_ms * freq doesn't fit 32 bits past about an hour.
+    uint64_t ticks = ((uint64_t)duration_ms * watch_rtc_get_frequency() + 999) / 1000;
+    // the RTC orders its timers by signed distance from now, so anything further out would sort as already passed.
+    if (ticks > INT32_MAX) ticks = INT32_MAX;
+    rtc_counter_t counter = watch_rtc_get_counter() + (rtc_counter_t)ticks;
+
+    if (timer->running) _movement_unlink_timer(timer);
+    timer->callback = callback;
+    timer->context = context;
+    timer->fired = false;
+    timer->running = true;
+    timer->next = _movement_running_timers;
+    _movement_running_timers = timer;
+
+    watch_rtc_register_comp(&timer->comp, _movement_timer_fired, timer, counter);
+}
+
+void movement_timer_stop(movement_timer_t *timer) {
+    if (!timer->running) return;
+
+    watch_rtc_disable_comp(&timer->comp);
+    timer->fired = false;
+    _movement_unlink_timer(timer);
+}
+
+bool movement_timer_is_running(movement_timer_t *timer) {
+    return timer->running;
+}
+
+static void _movement_animation_draw(void) {
+    movement_animation_state_t *animation = &_movement_animation;
+    const char *frame = animation->text == NULL ? animation->frames[animation->frame] : NULL;
+    bool frame_ended = false;
+
+    for (uint8_t i = 0; i < animation->width; i++) {
+        char c = ' ';
+        if (frame != NULL) {
+            // frames shorter than the width are padded with spaces
+            if (frame[i] == 0) frame_ended = true;
+            if (!frame_ended) c = frame[i];
+        } else {
+            // the marquee comes around with a space between the end of the text and its start
+            uint16_t index = (animation->frame + i) % (animation->length + 1);
+            if (index < animation->length) c = animation->text[index];
+        }
+        watch_display_character(c, animation->position + i);
+    }
+}
+
+static void _movement_animation_next_frame(void *context) {
+    (void) context;
+    movement_animation_state_t *animation = &_movement_animation;
+
+    if (++animation->frame >= animation->num_frames) {
+        if (!animation->repeat) {
+            // leave the last frame on screen
+            animation->running = false;
+            return;
         }
+        animation->frame = 0;
+    }
+    _movement_animation_draw();
+    movement_timer_start(&animation->timer, animation->frame_ms, _movement_animation_next_frame, NULL);
+}
+
+static void _movement_animation_start(uint8_t position, uint8_t width, uint32_t frame_ms, bool repeat) {
+    movement_animation_state_t *animation = &_movement_animation;
+
+    animation->position = position;
+    animation->width = width;
+    animation->frame_ms = frame_ms;
+    animation->repeat = repeat;
+    animation->frame = 0;
+    _movement_animation_draw();
+
+    animation->running = animation->num_frames > 1;
+    if (animation->running) {
+        movement_timer_start(&animation->timer, frame_ms, _movement_animation_next_frame, NULL);
+    } else {
+        movement_timer_stop(&animation->timer);
+    }
+}
+
+void movement_animate_frames(uint8_t position, uint8_t width, const char * const *frames, uint8_t num_frames, uint32_t frame_ms, bool repeat) {
+    if (num_frames == 0) {
+        movement_stop_animation();
+        return;
+    }
+    _movement_animation.text = NULL;
+    _movement_animation.frames = frames;
+    _movement_animation.num_frames = num_frames;
+    _movement_animation_start(position, width, frame_ms, repeat);
+}
+
+void movement_animate_marquee(uint8_t position, uint8_t width, const char *text, uint32_t frame_ms, bool repeat) {
+    size_t length = strlen(text);
+    if (length > UINT8_MAX - 1) length = UINT8_MAX - 1;
+
+    _movement_animation.text = text;
+    _movement_animation.frames = NULL;
+    _movement_animation.length = length;
+    if (length <= width) {
+        // it fits, nothing to scroll
+        _movement_animation.num_frames = 1;
+    } else if (repeat) {
+        _movement_animation.num_frames = length + 1;
+    } else {
+        // stop once the end of the text reaches the last position
+        _movement_animation.num_frames = length - width + 1;
+    }
+    _movement_animation_start(position, width, frame_ms, repeat);
+}
+
+void movement_stop_animation(void) {
+    movement_timer_stop(&_movement_animation.timer);
+    _movement_animation.running = false;
+}
+
+bool movement_animation_is_running(void) {
+    return _movement_animation.running;
+}
+
+static void _movement_gesture_timeout_fired(void *context) {
+    (void) context;
+    movement_volatile_state.gesture_timeout_due = true;
+
+#if __EMSCRIPTEN__
+    _wake_up_simulator();
+#endif
+}
+
+// Arms the comparator at the earliest deadline, if any.
+static void _movement_gesture_schedule(void) {
+    rtc_counter_t deadline;
+
+    if (movement_gesture_get_next_deadline(&_movement_gestures, &deadline)) {
+        watch_rtc_register_comp(&_movement_gesture_comp, _movement_gesture_timeout_fired, NULL, deadline);
+    } else {
+        watch_rtc_disable_comp(&_movement_gesture_comp);
     }
-    movement_state.has_scheduled_background_task = other_tasks_scheduled;
+}
+
+static void _movement_gesture_reset(void) {
+    movement_gesture_reset(&_movement_gestures);
+    movement_volatile_state.gesture_timeout_due = false;
+    watch_rtc_disable_comp(&_movement_gesture_comp);
+}
+
+void movement_enable_gestures(uint16_t gestures) {
+    movement_gesture_set_enabled(&_movement_gestures, gestures);
+    _movement_gesture_schedule();
+}
+
+void movement_set_multi_click_window(uint16_t window_ms) {
+    _movement_gestures.multi_click_window = ((uint32_t)window_ms * watch_rtc_get_frequency() + 999) / 1000;
 }
 
 void movement_request_sleep(void) {
@@ -649,35 +1184,28 @@ uint8_t movement_claim_backup_register(void) {
 }
 
 int32_t movement_get_current_timezone_offset_for_zone(uint8_t zone_index) {
-    int8_t cached_dst_offset = _movement_dst_offset_cache[zone_index];
-
-    if (cached_dst_offset == TIMEZONE_DOES_NOT_OBSERVE) {
-        // if time zone doesn't observe DST, we can just return the standard time offset from the zone definition.
-        return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
-    } else {
-        // otherwise, we've precalculated the offset for this zone and can return it.
-        return (int32_t)cached_dst_offset * OFFSET_INCREMENT * 60;
-    }
+    return movement_tz_get_current_offset(zone_index);
 }
 
 int32_t movement_get_current_timezone_offset(void) {
     return movement_get_current_timezone_offset_for_zone(movement_state.settings.bit.time_zone);
 }
 
+int32_t movement_get_timezone_offset_for_timestamp_in_zone(unix_timestamp_t timestamp, uint8_t zone_index) {
+    return movement_tz_get_offset_at(timestamp, zone_index, watch_rtc_get_unix_time());
+}
+
+int32_t movement_get_timezone_offset_for_timestamp(unix_timestamp_t timestamp) {
+    return movement_get_timezone_offset_for_timestamp_in_zone(timestamp, movement_state.settings.bit.time_zone);
+}
+
 int32_t movement_get_timezone_offset_for_date_in_zone(watch_date_time_t date_time, uint8_t zone_index) {
-    int8_t cached_dst_offset = _movement_dst_offset_cache[zone_index];
+    int32_t standard_offset = movement_tz_get_standard_offset(zone_index);
 
-    if (cached_dst_offset == TIMEZONE_DOES_NOT_OBSERVE) {
-        return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
-    }
+    if (!movement_tz_observes_dst(zone_index)) return standard_offset;
 
-    // Compute the offset for the given date using the zone's DST rules
-    uzone_t local_zone;
-    unpack_zone(&zone_defns[zone_index], "", &local_zone);
-    udatetime_t udt = _movement_convert_date_time_to_udate(date_time);
-    uoffset_t offset;
-    get_current_offset(&local_zone, &udt, &offset);
-    return (int32_t)(offset.hours * 60 + offset.minutes) * 60;
+    // the zone's rules are evaluated against local standard time, so that's how we read date_time.
+    return movement_get_timezone_offset_for_timestamp_in_zone(watch_utility_date_time_to_unix_time(date_time, standard_offset), zone_index);
 }
 
 int32_t movement_get_timezone_offset_for_date(watch_date_time_t date_time) {
@@ -690,36 +1218,46 @@ int32_t movement_get_timezone_index(void) {
 
 void movement_set_timezone_index(uint8_t value) {
     movement_state.settings.bit.time_zone = value;
+    // the local time in the snapshot is no good anymore
+    _movement_time_snapshot_is_valid = false;
+    // wake intents are in local time
+    _movement_reset_advise_schedule();
+}
+
+const movement_time_snapshot_t *movement_get_time_snapshot(void) {
+    if (_movement_time_snapshot_is_valid) return &_movement_time_snapshot;
+
+    rtc_counter_t counter = watch_rtc_get_counter();
+    unix_timestamp_t timestamp = watch_rtc_get_unix_time_at_counter(counter);
+
+    _movement_time_snapshot.counter = counter;
+    _movement_time_snapshot.utc_timestamp = timestamp;
+    _movement_time_snapshot.utc_date_time = watch_utility_date_time_from_unix_time_cached(&_movement_utc_date_time_cache, timestamp, 0);
+    _movement_time_snapshot.local_date_time = watch_utility_date_time_from_unix_time_cached(&_movement_local_date_time_cache, timestamp, movement_get_current_timezone_offset());
+    _movement_time_snapshot.subsecond = _movement_get_subsecond(counter);
+
+    // only hold on to it while the loop is running; anywhere else, every call gets a fresh reading.
+    _movement_time_snapshot_is_valid = _movement_time_snapshot_is_active;
+
+    return &_movement_time_snapshot;
 }
 
 watch_date_time_t movement_get_utc_date_time(void) {
-    return watch_rtc_get_date_time();
+    return movement_get_time_snapshot()->utc_date_time;
 }
 
 watch_date_time_t movement_get_date_time_in_zone(uint8_t zone_index) {
     int32_t offset = movement_get_current_timezone_offset_for_zone(zone_index);
-    unix_timestamp_t timestamp = watch_rtc_get_unix_time();
+    unix_timestamp_t timestamp = movement_get_time_snapshot()->utc_timestamp;
     return watch_utility_date_time_from_unix_time(timestamp, offset);
 }
 
 watch_date_time_t movement_get_local_date_time(void) {
-    static struct {
-        unix_timestamp_t timestamp;
-        rtc_date_time_t datetime;
-    } cached_date_time = {.datetime.reg=0, .timestamp=0};
-
-    unix_timestamp_t timestamp = watch_rtc_get_unix_time();
-
-    if (timestamp != cached_date_time.timestamp) {
-        cached_date_time.timestamp = timestamp;
-        cached_date_time.datetime = watch_utility_date_time_from_unix_time(timestamp, movement_get_current_timezone_offset());
-    }
-
-    return cached_date_time.datetime;
+    return movement_get_time_snapshot()->local_date_time;
 }
 
 uint32_t movement_get_utc_timestamp(void) {
-    return watch_rtc_get_unix_time();
+    return movement_get_time_snapshot()->utc_timestamp;
 }
 
 void movement_set_utc_date_time(watch_date_time_t date_time) {
@@ -733,14 +1271,21 @@ void movement_set_local_date_time(watch_date_time_t date_time) {
 
 void movement_set_utc_timestamp(uint32_t timestamp) {
     watch_rtc_set_unix_time(timestamp);
+    _movement_time_snapshot_is_valid = false;
 
     // If the time was changed, the top of the minute alarm needs to be reset accordingly
     _movement_set_top_of_minute_alarm();
+    // and so does the comparator for the next background task, since its deadline is in UTC.
+    _movement_set_background_task_alarm();
 
     // this may seem wasteful, but if the user's local time is in a zone that observes DST,
     // they may have just crossed a DST boundary, which means the next call to this function
     // could require a different offset to force local time back to UTC. Quelle horreur!
-    _movement_update_dst_offset_cache();
+    // the time may also have moved backwards, so every zone's next transition has to be found again.
+    movement_tz_update(timestamp, true);
+
+    // finally, wake intents have to be rescheduled relative to the new time.
+    _movement_reset_advise_schedule();
 }
 
 
@@ -829,14 +1374,31 @@ void movement_set_backlight_dwell(uint8_t value) {
     movement_state.settings.bit.led_duration = value;
 }
 
-void movement_store_settings(void) {
-    movement_settings_t old_settings;
-    filesystem_read_file("settings.u32", (char *)&old_settings, sizeof(movement_settings_t));
-    if (movement_state.settings.reg != old_settings.reg) {
-        filesystem_write_file("settings.u32", (char *)&movement_state.settings, sizeof(movement_settings_t));
+// unsaved preferences get written out once this long has gone by without a change, if nothing else flushed them.
+#define MOVEMENT_PREFS_FLUSH_DELAY_MS (60000)
+
+// settings.u32 and location.u32, plus one for each face: the faces that keep their own prefs keep one key each.
+#define MOVEMENT_PREFS_MAX_KEYS (2 + MOVEMENT_NUM_FACES)
+
+static movement_timer_t _movement_prefs_timer;
+
+static void _movement_prefs_flush(void *context) {
+    (void) context;
+    prefs_flush();
+}
+
+// app_loop starts the timer after the first change; every change after that pushes it back, so a run of changes
+// gets written once it's over.
+static void _movement_prefs_changed(void) {
+    if (movement_timer_is_running(&_movement_prefs_timer)) {
+        movement_timer_start(&_movement_prefs_timer, MOVEMENT_PREFS_FLUSH_DELAY_MS, _movement_prefs_flush, NULL);
     }
 }
 
+void movement_store_settings(void) {
+    prefs_set("settings.u32", movement_state.settings.reg);
+}
+
 bool movement_alarm_enabled(void) {
     return movement_state.alarm_enabled;
 }
@@ -943,10 +1505,129 @@ float movement_get_temperature(void) {
     return temperature_c;
 }
 
+void *movement_context_alloc(size_t size) {
+    void *block;
+
+    size = (size + MOVEMENT_CONTEXT_ALIGNMENT - 1) & ~(MOVEMENT_CONTEXT_ALIGNMENT - 1);
+    _movement_context_allocations++;
+
+    if (size <= MOVEMENT_CONTEXT_ARENA_SIZE - _movement_context_arena_used) {
+        block = &_movement_context_arena[_movement_context_arena_used];
+        _movement_context_arena_used += size;
+        return block;
+    }
+
+    // the arena is full: fall back to the heap, and keep count so that the arena can be sized up.
+    block = calloc(1, size);
+    if (block != NULL) _movement_context_heap_used += size;
+
+    return block;
+}
+
+int movement_cmd_arena(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    printf("%u face context allocations\r\n", _movement_context_allocations);
+    printf("arena: %lu of %lu bytes used\r\n", (unsigned long)_movement_context_arena_used, (unsigned long)MOVEMENT_CONTEXT_ARENA_SIZE);
+    printf("heap: %lu bytes\r\n", (unsigned long)_movement_context_heap_used);
+
+    return 0;
+}
+
+int movement_cmd_advise(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    printf("advise calls made: %lu\r\n", (unsigned long)_movement_advise_calls_made);
+    printf("advise calls avoided: %lu\r\n", (unsigned long)_movement_advise_calls_avoided);
+
+    return 0;
+}
+
+int movement_cmd_events(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    printf("event queue overflows: %lu\r\n", (unsigned long)_movement_event_queue.overflow_count);
+
+    return 0;
+}
+
+int movement_cmd_wakes(int argc, char *argv[]) {
+    unix_timestamp_t now = watch_rtc_get_unix_time();
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0) return -1;
+        _movement_wake_count = 0;
+        _movement_wake_count_since = now;
+        return 0;
+    }
+
+    uint32_t elapsed = now - _movement_wake_count_since;
+    printf("%lu wakes in %lu seconds\r\n", (unsigned long)_movement_wake_count, (unsigned long)elapsed);
+    if (elapsed >= 60) {
+        printf("%lu wakes per minute\r\n", (unsigned long)(_movement_wake_count * 60 / elapsed));
+    }
+
+    return 0;
+}
+
+#ifdef MOVEMENT_ENABLE_STATS
+int movement_cmd_stats(int argc, char *argv[]) {
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0) return -1;
+        memset(_movement_face_stats, 0, sizeof(_movement_face_stats));
+        memset(&_movement_stats, 0, sizeof(_movement_stats));
+        _movement_stats_tick_mode_since = watch_rtc_get_counter();
+        _movement_stats_since = watch_rtc_get_unix_time();
+        return 0;
+    }
+
+    // bring the current face's time on screen up to date before printing it.
+    _movement_stats_account_tick_mode();
+
+#if __EMSCRIPTEN__
+    const char *unit = "us";
+#else
+    const char *unit = "cycles";
+#endif
+    uint32_t freq = watch_rtc_get_frequency();
+
+    printf("stats for the last %lu seconds, times in %s\r\n", (unsigned long)(watch_rtc_get_unix_time() - _movement_stats_since), unit);
+    printf("top of minute: %lu calls, %lu\r\n", (unsigned long)_movement_stats.top_of_minute_calls, (unsigned long)_movement_stats.top_of_minute_time);
+    printf("background tasks: %lu calls, %lu\r\n", (unsigned long)_movement_stats.scheduled_tasks_calls, (unsigned long)_movement_stats.scheduled_tasks_time);
+    printf("low energy updates: %lu\r\n", (unsigned long)_movement_stats.low_energy_updates);
+
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        movement_face_stats_t *stats = &_movement_face_stats[i];
+        if (!stats->loop_calls && !stats->advise_calls && !stats->activate_calls) continue;
+
+        printf("face %d:\r\n", i);
+        printf("  loop: %lu calls, %lu, kept awake %lu times\r\n", (unsigned long)stats->loop_calls, (unsigned long)stats->loop_time, (unsigned long)stats->kept_awake);
+        printf("  advise: %lu calls, %lu\r\n", (unsigned long)stats->advise_calls, (unsigned long)stats->advise_time);
+        printf("  activate: %lu calls, %lu\r\n", (unsigned long)stats->activate_calls, (unsigned long)stats->activate_time);
+        printf("  resign: %lu calls, %lu\r\n", (unsigned long)stats->resign_calls, (unsigned long)stats->resign_time);
+        for (uint8_t mode = 0; mode < MOVEMENT_STATS_NUM_TICK_MODES; mode++) {
+            if (!stats->tick_mode_time[mode]) continue;
+            unsigned long seconds = stats->tick_mode_time[mode] / freq;
+            if (mode == MOVEMENT_STATS_TICK_MODE_MINUTE) printf("  on screen with minute ticks: %lu s\r\n", seconds);
+            else if (mode == MOVEMENT_STATS_TICK_MODE_NONE) printf("  on screen without ticks: %lu s\r\n", seconds);
+            else printf("  on screen at %d Hz: %lu s\r\n", 128 >> mode, seconds);
+        }
+    }
+
+    return 0;
+}
+#endif
+
 void app_init(void) {
     _watch_init();
 
+    movement_event_queue_init(&_movement_event_queue);
+
     filesystem_init();
+    prefs_init(MOVEMENT_PREFS_MAX_KEYS, _movement_prefs_changed);
 
     // check if we are plugged into USB power.
     HAL_GPIO_VBUS_DET_in();
@@ -960,7 +1641,7 @@ void app_init(void) {
 
     memset((void *)&movement_state, 0, sizeof(movement_state));
 
-    movement_volatile_state.pending_events = 0;
+    movement_volatile_state.has_pending_activate = false;
     movement_volatile_state.turn_led_off = false;
 
     movement_volatile_state.minute_alarm_fired = false;
@@ -995,11 +1676,8 @@ void app_init(void) {
 
     movement_state.has_thermistor = thermistor_driver_init();
 
-    bool settings_file_exists = filesystem_file_exists("settings.u32");
     movement_settings_t maybe_settings;
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
-        filesystem_read_file("settings.u32", (char *) &maybe_settings, sizeof(movement_settings_t));
-    }
+    bool settings_file_exists = prefs_get("settings.u32", &maybe_settings.reg);
 
     if (settings_file_exists && maybe_settings.bit.version == 0) {
         // If settings file exists and has a valid version, restore it!
@@ -1053,7 +1731,16 @@ void app_init(void) {
     watch_buzzer_register_global_callbacks(cb_buzzer_start, cb_buzzer_stop);
 
     // populate the DST offset cache
-    _movement_update_dst_offset_cache();
+    movement_tz_update(watch_rtc_get_unix_time(), true);
+
+    // and work out when each face will need to be advised
+    _movement_reset_advise_schedule();
+
+    _movement_wake_count_since = watch_rtc_get_unix_time();
+#ifdef MOVEMENT_ENABLE_STATS
+    _movement_stats_since = _movement_wake_count_since;
+    _movement_stats_tick_mode_since = watch_rtc_get_counter();
+#endif
 
     if (movement_state.accelerometer_motion_threshold == 0) movement_state.accelerometer_motion_threshold = 32;
 
@@ -1082,9 +1769,8 @@ void app_setup(void) {
 
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
             watch_face_contexts[i] = NULL;
-            scheduled_tasks[i].reg = 0;
-            is_first_launch = false;
         }
+        movement_task_list_init(&_movement_task_list, _movement_scheduled_tasks, MOVEMENT_NUM_FACES);
 
 #if __EMSCRIPTEN__
         int32_t time_zone_offset = EM_ASM_INT({
@@ -1112,7 +1798,15 @@ void app_setup(void) {
 
 #ifdef I2C_SERCOM
         static bool lis2dw_checked = false;
-        if (!lis2dw_checked) {
+        if (lis2dw_checked) {
+            // the accelerometer stays powered, and keeps its configuration, while we sleep.
+            // only our end of the bus and the interrupt pins need to come back.
+            if (movement_state.has_lis2dw) {
+                watch_enable_i2c();
+                HAL_GPIO_A4_in();
+                watch_register_interrupt_callback(HAL_GPIO_A3_pin(), cb_accelerometer_event, INTERRUPT_TRIGGER_RISING);
+            }
+        } else {
             watch_enable_i2c();
             if (lis2dw_begin()) {
                 movement_state.has_lis2dw = true;
@@ -1121,12 +1815,9 @@ void app_setup(void) {
                 watch_disable_i2c();
             }
             lis2dw_checked = true;
-        } else if (movement_state.has_lis2dw) {
-            watch_enable_i2c();
-            lis2dw_begin();
         }
 
-        if (movement_state.has_lis2dw) {
+        if (movement_state.has_lis2dw && is_first_launch) {
             lis2dw_set_mode(LIS2DW_MODE_LOW_POWER);         // select low power (not high performance) mode
             lis2dw_set_low_power_mode(LIS2DW_LP_MODE_1);    // lowest power mode, 12-bit
             lis2dw_set_low_noise_mode(false);               // low noise mode raises power consumption slightly; we don't need it
@@ -1171,12 +1862,25 @@ void app_setup(void) {
 
         movement_request_tick_frequency(1);
 
-        for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-            watch_faces[i].setup(i, &watch_face_contexts[i]);
+        if (is_first_launch) {
+            for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+                watch_faces[i].setup(i, &watch_face_contexts[i]);
+            }
+            is_first_launch = false;
+            printf("face contexts: %lu bytes in arena, %lu bytes on heap\r\n", (unsigned long)_movement_context_arena_used, (unsigned long)_movement_context_heap_used);
+        } else {
+            // waking from low energy mode: contexts are intact, but faces that use pins or peripherals have to restore them.
+            for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+                if (watch_faces[i].resume != NULL) {
+                    watch_faces[i].resume(watch_face_contexts[i]);
+                }
+            }
         }
 
-        watch_faces[movement_state.current_face_idx].activate(watch_face_contexts[movement_state.current_face_idx]);
-        movement_volatile_state.pending_events |=  1 << EVENT_ACTIVATE;
+        // the face opts in to gestures again from activate
+        _movement_gesture_reset();
+        _movement_face_activate(movement_state.current_face_idx);
+        movement_volatile_state.has_pending_activate = true;
     }
 }
 
@@ -1185,6 +1889,8 @@ void app_setup(void) {
 static void _sleep_mode_app_loop(void) {
     // as long as we are in low energy mode, we wake up here, update the screen, and go right back to sleep.
     while (movement_volatile_state.is_sleeping) {
+        _movement_begin_time_snapshot();
+
         // if we need to wake immediately, do it!
         if (movement_volatile_state.exit_sleep_mode) {
             movement_volatile_state.exit_sleep_mode = false;
@@ -1200,10 +1906,25 @@ static void _sleep_mode_app_loop(void) {
             _movement_handle_top_of_minute();
         }
 
+        // background tasks are due whenever their comparator fires, even in low energy mode
+        if (movement_volatile_state.background_task_due) {
+            movement_volatile_state.background_task_due = false;
+            _movement_handle_scheduled_tasks();
+        }
+
+        // and so are the timers
+        if (movement_volatile_state.has_fired_timers) {
+            movement_volatile_state.has_fired_timers = false;
+            _movement_handle_fired_timers();
+        }
+
         movement_event_t event;
         event.event_type = EVENT_LOW_ENERGY_UPDATE;
         event.subsecond = 0;
-        watch_faces[movement_state.current_face_idx].loop(event, watch_face_contexts[movement_state.current_face_idx]);
+        _movement_face_loop(movement_state.current_face_idx, event);
+#ifdef MOVEMENT_ENABLE_STATS
+        _movement_stats.low_energy_updates++;
+#endif
 
         // If any of the previous loops requested to wake up, do it!
         if (movement_volatile_state.exit_sleep_mode) {
@@ -1220,19 +1941,22 @@ static void _sleep_mode_app_loop(void) {
         }
 
         // otherwise enter sleep mode, until either the top of the minute interrupt or extwake wakes us up.
+        _movement_end_time_snapshot();
         watch_enter_sleep_mode();
+        _movement_wake_count++;
     }
 }
 
 #endif
 
 static bool _switch_face(void) {
-    const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
-
-    wf->resign(watch_face_contexts[movement_state.current_face_idx]);
+#ifdef MOVEMENT_ENABLE_STATS
+    _movement_stats_account_tick_mode();
+#endif
+    _movement_face_resign(movement_state.current_face_idx);
+    // whatever the face changed while it was on screen is done changing
+    prefs_flush();
     movement_state.current_face_idx = movement_state.next_face_idx;
-    // we have just updated the face idx, so we must recache the watch face pointer.
-    wf = &watch_faces[movement_state.current_face_idx];
     watch_clear_display();
     movement_request_tick_frequency(1);
 
@@ -1241,13 +1965,18 @@ static bool _switch_face(void) {
         movement_play_note(movement_state.next_face_idx ? BUZZER_NOTE_C7 : BUZZER_NOTE_C8, 50);
     }
 
-    wf->activate(watch_face_contexts[movement_state.current_face_idx]);
+    _movement_gesture_reset();
+    // a blink, a seconds counter or an animation belongs to the face that started it
+    watch_blink_positions(0, 0);
+    watch_stop_seconds_counter();
+    movement_stop_animation();
+    _movement_face_activate(movement_state.current_face_idx);
 
     movement_event_t event;
     event.subsecond = 0;
     event.event_type = EVENT_ACTIVATE;
     movement_state.watch_face_changed = false;
-    bool can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]);
+    bool can_sleep = _movement_face_loop(movement_state.current_face_idx, event);
 
     // Button events that follow a down event that happened on the previous face should not be forwarded to the new face
     movement_volatile_state.passthrough_events = _movement_button_events_mask;
@@ -1255,21 +1984,44 @@ static bool _switch_face(void) {
     return can_sleep;
 }
 
-bool app_loop(void) {
-    const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
+static bool _movement_deliver_gestures(movement_gesture_output_t *gestures) {
+    bool can_sleep = true;
+    movement_event_t event;
 
+    for (uint8_t i = 0; i < gestures->count; i++) {
+        event.event_type = gestures->events[i].event_type;
+        event.subsecond = _movement_get_subsecond(gestures->events[i].counter);
+        can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
+    }
+
+    return can_sleep;
+}
+
+bool app_loop(void) {
     // default to being allowed to sleep by the face.
     bool can_sleep = true;
 
-    // Any events that have been added by the various interrupts in between app_loop invokations
-    uint32_t pending_events = movement_volatile_state.pending_events;
-    movement_volatile_state.pending_events = 0;
+    // the first one to ask for the time in this iteration takes the snapshot that everyone else gets.
+    _movement_begin_time_snapshot();
+
+    // if we were allowed to sleep last time around, an interrupt just woke us up.
+    if (_movement_did_sleep) {
+        _movement_wake_count++;
+    }
+
+    // Any events that have been queued by the various interrupts in between app_loop invokations, in order.
+    // We take them all out of the queue up front, so that the interrupts can keep queueing while we work.
+    movement_queued_event_t pending[MOVEMENT_MAX_PENDING_EVENTS];
+    uint8_t num_pending = 0;
+
+    if (movement_volatile_state.has_pending_activate) {
+        movement_volatile_state.has_pending_activate = false;
+        pending[num_pending++] = (movement_queued_event_t) { EVENT_ACTIVATE, watch_rtc_get_counter() };
+    }
+
+    num_pending += movement_event_queue_drain(&_movement_event_queue, &pending[num_pending]);
 
     movement_event_t event;
-    event.event_type = EVENT_NONE;
-    // Subsecond is determined by the TICK event, if concurrent events have happened,
-    // they will all have the same subsecond as they should to keep backward compatibility.
-    event.subsecond = movement_volatile_state.subsecond;
 
     // if the LED should be off, turn it off
     if (movement_volatile_state.turn_led_off) {
@@ -1283,47 +2035,84 @@ bool app_loop(void) {
 
     if (movement_volatile_state.has_pending_accelerometer) {
         movement_volatile_state.has_pending_accelerometer = false;
-        pending_events |= _movement_get_accelerometer_events();
+        uint32_t accelerometer_events = _movement_get_accelerometer_events();
+        rtc_counter_t counter = watch_rtc_get_counter();
+        while (accelerometer_events && num_pending < MOVEMENT_MAX_PENDING_EVENTS) {
+            uint8_t next_event = __builtin_ctz(accelerometer_events);
+            pending[num_pending++] = (movement_queued_event_t) { next_event, counter };
+            accelerometer_events &= ~(1 << next_event);
+        }
     }
 
     // handle any button up/down events that occurred, e.g. schedule longpress timeouts, reset inactivity, etc.
-    _movement_handle_button_presses(pending_events);
+    // this has to follow the order of events, e.g. a quick release and press again must leave a longpress timeout armed.
+    for (uint8_t i = 0; i < num_pending; i++) {
+        if (_movement_get_button_events_mask(pending[i].event_type)) {
+            _movement_handle_button_presses(1 << pending[i].event_type);
+        }
+    }
 
-    // if we have a scheduled background task, handle that here:
-    if (
-        (pending_events & (1 << EVENT_TICK))
-        && event.subsecond == 0
-        && movement_state.has_scheduled_background_task
-    ) {
+    // if the comparator for the earliest background task fired, handle all tasks that are due here:
+    if (movement_volatile_state.background_task_due) {
+        movement_volatile_state.background_task_due = false;
         _movement_handle_scheduled_tasks();
     }
 
-    // Pop the EVENT_TIMEOUT out of the pending_events so it can be handled separately
-    bool resign_timeout = (pending_events & (1 << EVENT_TIMEOUT)) != 0;
-    if (resign_timeout) {
-        pending_events &= ~(1 << EVENT_TIMEOUT);
+    // call back the faces whose timers expired
+    if (movement_volatile_state.has_fired_timers) {
+        movement_volatile_state.has_fired_timers = false;
+        _movement_handle_fired_timers();
     }
 
-    // Consume all the pending events
-    uint32_t passthrough_pending_events = pending_events & movement_volatile_state.passthrough_events;
-    pending_events = pending_events & ~movement_volatile_state.passthrough_events;
+    bool update_gesture_comp = false;
+
+    // The EVENT_TIMEOUT is handled separately, after the top of the minute tasks
+    bool resign_timeout = false;
+    rtc_counter_t resign_timeout_counter = 0;
 
-    movement_event_type_t event_type = 0;
-    while (passthrough_pending_events) {
-        uint8_t next_event = __builtin_ctz(passthrough_pending_events);
-        event.event_type = event_type + next_event;
-        can_sleep = movement_default_loop_handler(event) && can_sleep;
-        passthrough_pending_events = passthrough_pending_events >> (next_event + 1);
-        event_type = event_type + next_event + 1;
+    // Consume all the pending events, in the order they happened
+    for (uint8_t i = 0; i < num_pending; i++) {
+        event.event_type = pending[i].event_type;
+        event.subsecond = _movement_get_subsecond(pending[i].counter);
+
+        if (event.event_type == EVENT_TIMEOUT) {
+            resign_timeout = true;
+            resign_timeout_counter = pending[i].counter;
+            continue;
+        }
+
+        uint32_t button_events_mask = _movement_get_button_events_mask(event.event_type);
+        if (event.event_type == EVENT_LIGHT_BUTTON_DOWN || event.event_type == EVENT_MODE_BUTTON_DOWN || event.event_type == EVENT_ALARM_BUTTON_DOWN) {
+            // this button's events will start getting passed to the face
+            movement_volatile_state.passthrough_events &= ~button_events_mask;
+        }
+
+        if (button_events_mask & movement_volatile_state.passthrough_events) {
+            can_sleep = movement_default_loop_handler(event) && can_sleep;
+        } else {
+            can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
+
+            // gestures follow the button event that completed them
+            if (button_events_mask && _movement_gestures.enabled) {
+                movement_gesture_output_t gestures = { .count = 0 };
+                movement_gesture_feed(&_movement_gestures, event.event_type, pending[i].counter, &gestures);
+                can_sleep = _movement_deliver_gestures(&gestures) && can_sleep;
+                update_gesture_comp = true;
+            }
+        }
     }
 
-    event_type = 0;
-    while (pending_events) {
-        uint8_t next_event = __builtin_ctz(pending_events);
-        event.event_type = event_type + next_event;
-        can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]) && can_sleep;
-        pending_events = pending_events >> (next_event + 1);
-        event_type = event_type + next_event + 1;
+    // repeats and held back double clicks that came due in the meantime
+    if (movement_volatile_state.gesture_timeout_due) {
+        movement_volatile_state.gesture_timeout_due = false;
+        movement_gesture_output_t gestures = { .count = 0 };
+        movement_gesture_expire(&_movement_gestures, watch_rtc_get_counter(), &gestures);
+        can_sleep = _movement_deliver_gestures(&gestures) && can_sleep;
+        update_gesture_comp = true;
+    }
+
+    if (update_gesture_comp) {
+        _movement_gesture_schedule();
     }
 
     // handle top-of-minute tasks, if the alarm handler told us we need to
@@ -1336,7 +2125,8 @@ bool app_loop(void) {
     // Now handle the EVENT_TIMEOUT
     if (resign_timeout && movement_state.current_face_idx != 0) {
         event.event_type = EVENT_TIMEOUT;
-        can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]) && can_sleep;
+        event.subsecond = _movement_get_subsecond(resign_timeout_counter);
+        can_sleep = _movement_face_loop(movement_state.current_face_idx, event) && can_sleep;
     }
 
     // The watch_face_changed flag might be set again by the face loop, so check it again
@@ -1353,12 +2143,32 @@ bool app_loop(void) {
         // No need to fire resign and sleep interrupts while in sleep mode
         _movement_disable_inactivity_countdown();
 
+        // nor to keep a blink's, the seconds counter's or an animation's comparator waking us up
+        watch_blink_positions(0, 0);
+        watch_stop_seconds_counter();
+        movement_stop_animation();
+
+        // and write out unsaved preferences now, rather than have their timer wake us up later;
+        // watch_enter_sleep_mode waits for the storage to finish before it goes to standby.
+        movement_timer_stop(&_movement_prefs_timer);
+        prefs_flush();
+
         watch_register_extwake_callback(HAL_GPIO_BTN_ALARM_pin(), cb_alarm_btn_extwake, true);
 
+#ifdef MOVEMENT_ENABLE_STATS
+        // the screen is off from here on: close out the time spent on screen at the current tick frequency.
+        _movement_stats_account_tick_mode();
+#endif
+
         // _sleep_mode_app_loop takes over at this point and loops until exit_sleep_mode is set by the extwake handler,
         // or wake is requested using the movement_request_wake function.
         _sleep_mode_app_loop();
         // as soon as _sleep_mode_app_loop returns, we prepare to reactivate
+        // we've been asleep, so the time has moved on
+        _movement_begin_time_snapshot();
+#ifdef MOVEMENT_ENABLE_STATS
+        _movement_stats_tick_mode_since = watch_rtc_get_counter();
+#endif
 
         // // this is a hack tho: waking from sleep mode, app_setup does get called, but it happens before we have reset our ticks.
         // // need to figure out if there's a better heuristic for determining how we woke up.
@@ -1379,6 +2189,11 @@ bool app_loop(void) {
     }
 #endif
 
+    // this also tries a failed flush again a minute later.
+    if (prefs_is_dirty() && !movement_timer_is_running(&_movement_prefs_timer)) {
+        movement_timer_start(&_movement_prefs_timer, MOVEMENT_PREFS_FLUSH_DELAY_MS, _movement_prefs_flush, NULL);
+    }
+
     // If we have made changes to any of the RTC comp timers, schedule the next one in the queue
     if (movement_volatile_state.schedule_next_comp) {
         movement_volatile_state.schedule_next_comp = false;
@@ -1400,6 +2215,20 @@ bool app_loop(void) {
         can_sleep = false;
     }
 
+    // everything that was drawn in this iteration shows up at once
+    watch_display_commit();
+
+    // storage writes queued in this iteration have to finish before we go to standby. Rather than hold the loop
+    // until all of them have, sleep in idle until the NVM's READY interrupt and come back around; the loop goes to
+    // standby once the queue is empty, and events that came in meanwhile get handled in between.
+    if (can_sleep && watch_storage_is_busy()) {
+        watch_storage_wait();
+        can_sleep = false;
+    }
+
+    _movement_did_sleep = can_sleep;
+    _movement_end_time_snapshot();
+
     return can_sleep;
 }
 
@@ -1447,19 +2276,19 @@ static movement_event_type_t _process_button_event(bool pin_level, movement_butt
 void cb_light_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_LIGHT_read();
 
-    movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.light_button);
+    _movement_queue_event(_process_button_event(pin_level, &movement_volatile_state.light_button), watch_rtc_get_counter());
 }
 
 void cb_mode_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_MODE_read();
 
-    movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.mode_button);
+    _movement_queue_event(_process_button_event(pin_level, &movement_volatile_state.mode_button), watch_rtc_get_counter());
 }
 
 void cb_alarm_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_ALARM_read();
 
-    movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.alarm_button);
+    _movement_queue_event(_process_button_event(pin_level, &movement_volatile_state.alarm_button), watch_rtc_get_counter());
 }
 
 static movement_event_type_t _process_button_longpress_timeout(bool pin_level, movement_button_t* button) {
@@ -1501,21 +2330,21 @@ void cb_light_btn_timeout_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_LIGHT_read();
     movement_button_t* button = &movement_volatile_state.light_button;
 
-    movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
+    _movement_queue_event(_process_button_longpress_timeout(pin_level, button), watch_rtc_get_counter());
 }
 
 void cb_mode_btn_timeout_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_MODE_read();
     movement_button_t* button = &movement_volatile_state.mode_button;
 
-    movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
+    _movement_queue_event(_process_button_longpress_timeout(pin_level, button), watch_rtc_get_counter());
 }
 
 void cb_alarm_btn_timeout_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_ALARM_read();
     movement_button_t* button = &movement_volatile_state.alarm_button;
 
-    movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
+    _movement_queue_event(_process_button_longpress_timeout(pin_level, button), watch_rtc_get_counter());
 }
 
 void cb_led_timeout_interrupt(void) {
@@ -1523,7 +2352,7 @@ void cb_led_timeout_interrupt(void) {
 }
 
 void cb_resign_timeout_interrupt(void) {
-    movement_volatile_state.pending_events |= 1 << EVENT_TIMEOUT;
+    _movement_queue_event(EVENT_TIMEOUT, watch_rtc_get_counter());
 }
 
 void cb_sleep_timeout_interrupt(void) {
@@ -1538,18 +2367,26 @@ void cb_alarm_btn_extwake(void) {
 void cb_minute_alarm_fired(void) {
     movement_volatile_state.minute_alarm_fired = true;
 
+    // nobody consumes events while we are in low energy mode
+    if (movement_state.tick_mode == MOVEMENT_TICK_MODE_MINUTE && !movement_volatile_state.is_sleeping) {
+        _movement_queue_event(EVENT_TICK, movement_volatile_state.minute_counter);
+    }
+
+#if __EMSCRIPTEN__
+    _wake_up_simulator();
+#endif
+}
+
+void cb_background_task_fired(void) {
+    movement_volatile_state.background_task_due = true;
+
 #if __EMSCRIPTEN__
     _wake_up_simulator();
 #endif
 }
 
 void cb_tick(void) {
-    rtc_counter_t counter = watch_rtc_get_counter();
-    uint32_t freq = watch_rtc_get_frequency();
-    uint32_t half_freq = freq >> 1;
-    uint32_t subsecond_mask = freq - 1;
-    movement_volatile_state.pending_events |= 1 << EVENT_TICK;
-    movement_volatile_state.subsecond = ((counter + half_freq) & subsecond_mask) >> movement_state.tick_pern;
+    _movement_queue_event(EVENT_TICK, watch_rtc_get_counter());
 }
 
 void cb_accelerometer_event(void) {
@@ -1557,7 +2394,7 @@ void cb_accelerometer_event(void) {
 }
 
 void cb_accelerometer_wake(void) {
-    movement_volatile_state.pending_events |= 1 << EVENT_ACCELEROMETER_WAKE;
+    _movement_queue_event(EVENT_ACCELEROMETER_WAKE, watch_rtc_get_counter());
     // also: wake up!
     _movement_reset_inactivity_countdown();
 }
@@ -38,6 +38,23 @@ typedef struct {
     uint8_t responds_to_dst_change: 1;
 } movement_watch_face_advisory_t;
 
+/// @brief Tells Movement at which minutes a watch face's advise function needs to be called.
+typedef enum {
+    MOVEMENT_WAKE_EVERY_MINUTE = 0, // advise is called at the top of every minute (the default)
+    MOVEMENT_WAKE_EVERY_N_MINUTES,  // advise is called every N minutes, counting from local midnight
+    MOVEMENT_WAKE_DAILY,            // advise is called once a day, at HH:MM local time
+    MOVEMENT_WAKE_TOP_OF_HOUR,      // advise is called at minute 0 of every local hour
+    MOVEMENT_WAKE_NEVER,            // advise is never called
+} movement_wake_intent_type_t;
+
+/// @brief A wake intent, registered by a watch face with movement_set_wake_intent.
+typedef struct {
+    movement_wake_intent_type_t type;
+    uint16_t interval;  // in minutes, for MOVEMENT_WAKE_EVERY_N_MINUTES
+    uint8_t hour;       // for MOVEMENT_WAKE_DAILY
+    uint8_t minute;     // for MOVEMENT_WAKE_DAILY
+} movement_wake_intent_t;
+
 // Movement Preferences
 // These four 32-bit structs store information about the wearer and their preferences. Tentatively, the plan is
 // for Movement to use four 32-bit registers for these preferences and to store them in the RTC's backup registers
@@ -139,8 +156,39 @@ typedef enum {
     EVENT_ACCELEROMETER_WAKE,   // The accelerometer has detected motion and woken up.
     EVENT_SINGLE_TAP,           // Accelerometer detected a single tap. This event is not yet implemented.
     EVENT_DOUBLE_TAP,           // Accelerometer detected a double tap. This event is not yet implemented.
+
+    // Gesture events are only sent to faces that opt in with movement_enable_gestures. The plain button events are
+    // always sent too, as they happen; these follow them.
+    EVENT_LIGHT_DOUBLE_CLICK,   // The light button was clicked twice within the multi-click window.
+    EVENT_MODE_DOUBLE_CLICK,    // The mode button was clicked twice within the multi-click window.
+    EVENT_ALARM_DOUBLE_CLICK,   // The alarm button was clicked twice within the multi-click window.
+    EVENT_LIGHT_TRIPLE_CLICK,   // The light button was clicked three times within the multi-click window.
+    EVENT_MODE_TRIPLE_CLICK,    // The mode button was clicked three times within the multi-click window.
+    EVENT_ALARM_TRIPLE_CLICK,   // The alarm button was clicked three times within the multi-click window.
+    EVENT_LIGHT_REPEAT,         // The light button is being held; sent repeatedly, faster and faster, until released.
+    EVENT_MODE_REPEAT,          // The mode button is being held; sent repeatedly, faster and faster, until released.
+    EVENT_ALARM_REPEAT,         // The alarm button is being held; sent repeatedly, faster and faster, until released.
+    EVENT_LIGHT_MODE_CHORD,     // The light and mode buttons were pressed together.
+    EVENT_LIGHT_ALARM_CHORD,    // The light and alarm buttons were pressed together.
+    EVENT_MODE_ALARM_CHORD,     // The mode and alarm buttons were pressed together.
 } movement_event_type_t;
 
+// Gestures a watch face can opt in to with movement_enable_gestures. Combine them with a bitwise OR.
+typedef enum {
+    MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK = 1 << 0,
+    MOVEMENT_GESTURE_MODE_DOUBLE_CLICK = 1 << 1,
+    MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK = 1 << 2,
+    MOVEMENT_GESTURE_LIGHT_TRIPLE_CLICK = 1 << 3,
+    MOVEMENT_GESTURE_MODE_TRIPLE_CLICK = 1 << 4,
+    MOVEMENT_GESTURE_ALARM_TRIPLE_CLICK = 1 << 5,
+    MOVEMENT_GESTURE_LIGHT_REPEAT = 1 << 6,
+    MOVEMENT_GESTURE_MODE_REPEAT = 1 << 7,
+    MOVEMENT_GESTURE_ALARM_REPEAT = 1 << 8,
+    MOVEMENT_GESTURE_LIGHT_MODE_CHORD = 1 << 9,
+    MOVEMENT_GESTURE_LIGHT_ALARM_CHORD = 1 << 10,
+    MOVEMENT_GESTURE_MODE_ALARM_CHORD = 1 << 11,
+} movement_gesture_t;
+
 // Each different timeout type will use a different index when invoking watch_rtc_register_comp_callback
 typedef enum {
     LIGHT_BUTTON_TIMEOUT = 0,   // Light button longpress timeout
@@ -150,6 +198,7 @@ typedef enum {
     RESIGN_TIMEOUT,             // Resign active face timeout
     SLEEP_TIMEOUT,              // Low-energy begin timeout
     MINUTE_TIMEOUT,             // Top of the Minute timeout
+    BACKGROUND_TASK_TIMEOUT,    // Earliest scheduled background task
 } movement_timeout_index_t;
 
 typedef enum {
@@ -163,16 +212,45 @@ typedef struct {
     uint8_t subsecond;
 } movement_event_t;
 
+/// A consistent view of the time, taken once per run of the event loop. @see movement_get_time_snapshot
+typedef struct {
+    rtc_counter_t counter;              // the RTC counter when the snapshot was taken
+    unix_timestamp_t utc_timestamp;     // the UTC timestamp at that counter
+    watch_date_time_t utc_date_time;
+    watch_date_time_t local_date_time;  // in the current time zone
+    uint8_t subsecond;                  // the subsecond an event at that counter would carry
+} movement_time_snapshot_t;
+
+typedef void (*movement_timer_cb_t)(void *context);
+
+/// @brief A one-shot timer owned by a watch face (typically in its context). It must be zeroed before first use;
+///        after that, don't touch the fields directly.
+typedef struct movement_timer {
+    watch_rtc_comp_t comp;
+    movement_timer_cb_t callback;
+    void *context;
+    struct movement_timer *next;
+    volatile bool fired;
+    bool running;
+} movement_timer_t;
+
+/// @brief How often the active watch face receives EVENT_TICK.
+typedef enum {
+    MOVEMENT_TICK_MODE_PERIODIC = 0,    // EVENT_TICK at the rate set with movement_request_tick_frequency (the default)
+    MOVEMENT_TICK_MODE_MINUTE,          // EVENT_TICK only at the top of each minute
+    MOVEMENT_TICK_MODE_NONE,            // no EVENT_TICK at all; button events and timeouts are still delivered
+} movement_tick_mode_t;
+
 extern const int16_t movement_timezone_offsets[];
 
-/** @brief Perform setup for your watch face.
-  * @details It's tempting to say this is 'one-time' setup, but technically this function is called more than
-  *          once. When the watch first boots, this function is called with a NULL context_ptr, indicating
-  *          that it is the first run. At this time you should set context_ptr to something non-NULL if you
-  *          need to keep track of any state in your watch face. If your watch face requires any other setup,
-  *          like configuring a pin mode or a peripheral, you may want to do that here too.
-  *          This function will be called again after waking from sleep mode, since sleep mode disables all
-  *          of the device's pins and peripherals.
+/** @brief Perform one-time setup for your watch face.
+  * @details This function is called once, when the watch first boots, with a NULL context_ptr. At this time
+  *          you should set context_ptr to something non-NULL if you need to keep track of any state in your
+  *          watch face. If your watch face requires any other setup, like configuring a pin mode or a
+  *          peripheral, you may want to do that here too.
+  *          Sleep mode disables all of the device's pins and peripherals, but this function is NOT called
+  *          again when the watch wakes up. If you need to restore a pin or a peripheral, do it in your
+  *          resume function. @see watch_face_resume.
   * @param watch_face_index The index of this watch face in the global array of watch faces; 0 is the first face,
   *                         1 is the second, etc. You may stash this value in your context if you wish to reference
   *                         it later; your watch face's index is set at launch and will not change.
@@ -241,6 +319,8 @@ typedef void (*watch_face_resign)(void *context);
   *          current time to determine whether you require a background task. If you return true here, Movement will
   *          immediately call your loop function with an EVENT_BACKGROUND_TASK event. Note that it will not call your
   *          activate or deactivate functions, since you are not going on screen.
+  *          If you only need to be advised at certain minutes (e.g. at the top of the hour), register a wake intent
+  *          with movement_set_wake_intent, and Movement will skip calling this function on all other minutes.
   *
   *          Examples of background tasks:
   *           - Wake and play a sound when an alarm or timer has been triggered.
@@ -258,12 +338,23 @@ typedef void (*watch_face_resign)(void *context);
   */
 typedef movement_watch_face_advisory_t (*watch_face_advise)(void *context);
 
+/** @brief OPTIONAL. Restore pins and peripherals after waking from sleep mode.
+  * @details Most faces will not need this function: their context survives sleep mode, and the on-screen face
+  *          gets its activate function called again on wake anyway. If your setup function configured a pin or a
+  *          peripheral that must stay configured while your face is in the background, redo that here.
+  *          Movement only calls this for faces that provide it, so it adds nothing to the wake latency of the
+  *          faces that don't.
+  * @param context A pointer to your application's context. @see watch_face_setup.
+  */
+typedef void (*watch_face_resume)(void *context);
+
 typedef struct {
     watch_face_setup setup;
     watch_face_activate activate;
     watch_face_loop loop;
     watch_face_resign resign;
     watch_face_advise advise;
+    watch_face_resume resume;
 } watch_face_t;
 
 typedef struct {
@@ -283,6 +374,7 @@ typedef struct {
     // stuff for subsecond tracking
     uint8_t tick_frequency;
     uint8_t tick_pern;
+    movement_tick_mode_t tick_mode;
 
     // backup register stuff
     uint8_t next_available_backup_register;
@@ -315,6 +407,10 @@ void movement_force_led_on(uint8_t red, uint8_t green, uint8_t blue);
 void movement_force_led_off(void);
 
 void movement_request_tick_frequency(uint8_t freq);
+// Faces that only display minute (or coarser) resolution can use this to stop the periodic tick while they are on screen,
+// so the watch doesn't wake up every second. Switching faces (or calling movement_request_tick_frequency) goes back to
+// MOVEMENT_TICK_MODE_PERIODIC at 1 Hz.
+void movement_request_tick_mode(movement_tick_mode_t mode);
 
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
@@ -328,6 +424,40 @@ void movement_cancel_background_task(void);
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time);
 void movement_cancel_background_task_for_face(uint8_t watch_face_index);
 
+// Watch faces with an advise function can call this (typically from setup) to tell Movement when advise needs to
+// be called. On every other minute, Movement skips the call entirely. Faces that never register an intent keep
+// getting advise called every minute.
+void movement_set_wake_intent(uint8_t watch_face_index, movement_wake_intent_t intent);
+
+// One-shot timers with sub-second resolution, as an alternative to requesting a high tick frequency.
+// When the timer expires, the callback is called from the main loop (not from an interrupt), so it is safe to update
+// the display or call any other Movement function from there, including restarting the timer.
+// Timers keep running when the face resigns, so stop them in your resign function if they only make sense on screen.
+// Durations are clamped to 2^31 RTC ticks (over three weeks even at 1024 Hz), the furthest ahead the RTC can schedule.
+void movement_timer_start(movement_timer_t *timer, uint32_t duration_ms, movement_timer_cb_t callback, void *context);
+void movement_timer_stop(movement_timer_t *timer);
+bool movement_timer_is_running(movement_timer_t *timer);
+
+// Display animations, as an alternative to raising the tick frequency and counting frames in the loop. Movement
+// draws each frame into `width` positions starting at `position` (as numbered by watch_display_character), from the
+// main loop and without calling the face's loop. One animation runs at a time: starting another replaces it, and it
+// stops when the face resigns. The strings are not copied, so they must stay valid while the animation runs.
+// A list of frames; frames shorter than the width are padded with spaces. Without repeat, the last one stays on screen.
+void movement_animate_frames(uint8_t position, uint8_t width, const char * const *frames, uint8_t num_frames, uint32_t frame_ms, bool repeat);
+// Scrolls text that doesn't fit one character per frame. With repeat it comes around again after a space, otherwise
+// it stops once its end is on screen. Text that fits is just drawn.
+void movement_animate_marquee(uint8_t position, uint8_t width, const char *text, uint32_t frame_ms, bool repeat);
+void movement_stop_animation(void);
+bool movement_animation_is_running(void);
+
+// Opt in to gesture events (see movement_gesture_t). Gestures are off by default and reset every time the face changes,
+// so call this from activate. A double click is reported as soon as the second click is released, unless the triple
+// click is enabled for the same button too: then it is held back until the multi-click window closes.
+// A third press that turns into a long press cancels a pending double click.
+void movement_enable_gestures(uint16_t gestures);
+// How long after a release the next press still counts towards a double or triple click. Also reset on face change.
+void movement_set_multi_click_window(uint16_t window_ms);
+
 void movement_request_sleep(void);
 void movement_request_wake(void);
 
@@ -343,10 +473,21 @@ int32_t movement_get_current_timezone_offset_for_zone(uint8_t zone_index);
 int32_t movement_get_current_timezone_offset(void);
 int32_t movement_get_timezone_offset_for_date_in_zone(watch_date_time_t date_time, uint8_t zone_index);
 int32_t movement_get_timezone_offset_for_date(watch_date_time_t date_time);
+// Returns the UTC offset in seconds that applies at the given UTC timestamp. Cheap for timestamps within a few years of now.
+int32_t movement_get_timezone_offset_for_timestamp_in_zone(unix_timestamp_t timestamp, uint8_t zone_index);
+int32_t movement_get_timezone_offset_for_timestamp(unix_timestamp_t timestamp);
 
 int32_t movement_get_timezone_index(void);
 void movement_set_timezone_index(uint8_t value);
 
+/** @brief Returns the time as of the current run of Movement's event loop.
+  * @details The RTC is read once per iteration of the loop, the first time anyone asks, so every face handling
+  *          events in that iteration sees the same values. movement_get_utc_date_time, movement_get_local_date_time,
+  *          movement_get_date_time_in_zone and movement_get_utc_timestamp return the snapshot too. Outside of the loop
+  *          they read the RTC every time, like before. To measure an interval within one event, use watch_rtc_get_counter.
+  */
+const movement_time_snapshot_t *movement_get_time_snapshot(void);
+
 watch_date_time_t movement_get_utc_date_time(void);
 watch_date_time_t movement_get_local_date_time(void);
 watch_date_time_t movement_get_date_time_in_zone(uint8_t zone_index);
@@ -410,3 +551,21 @@ bool movement_set_accelerometer_motion_threshold(uint8_t new_threshold);
 // If the board has multiple temperature sensors, it will use the most accurate one available.
 // If the board has no temperature sensors, it will return 0xFFFFFFFF.
 float movement_get_temperature(void);
+
+/** @brief Allocates memory for a watch face's context. Call this from your setup function instead of malloc.
+  * @details Blocks come from a statically sized arena (see MOVEMENT_CONTEXT_ARENA_SIZE in movement_config.h),
+  *          are zero-filled, aligned to 8 bytes, and can never be freed. If the arena runs out, the block comes
+  *          from the heap instead. If your face needs a buffer that it frees again, use malloc for that one.
+  * @param size The number of bytes to allocate.
+  * @return A pointer to the block, or NULL if there is no memory left at all.
+  */
+void *movement_context_alloc(size_t size);
+
+// shell commands
+int movement_cmd_advise(int argc, char *argv[]);
+int movement_cmd_wakes(int argc, char *argv[]);
+int movement_cmd_events(int argc, char *argv[]);
+int movement_cmd_arena(int argc, char *argv[]);
+#ifdef MOVEMENT_ENABLE_STATS
+int movement_cmd_stats(int argc, char *argv[]);
+#endif
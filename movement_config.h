@@ -108,4 +108,10 @@ const watch_face_t watch_faces[] = {
 */
 #define MOVEMENT_DEBOUNCE_TICKS 0
 
+/* Size in bytes of the static region that watch face contexts are allocated from.
+ * If your faces need more than this, the rest comes from the heap; use the `arena`
+ * shell command to see how much your configuration actually uses.
+ */
+#define MOVEMENT_CONTEXT_ARENA_SIZE 1024
+
 #endif // MOVEMENT_CONFIG_H_
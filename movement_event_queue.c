@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_event_queue.h"
+
+void movement_event_queue_init(volatile movement_event_queue_t *queue) {
+    queue->head = 0;
+    queue->tail = 0;
+    queue->draining_until = MOVEMENT_EVENT_QUEUE_NOT_DRAINING;
+    queue->overflow_count = 0;
+}
+
+movement_event_queue_result_t movement_event_queue_push(volatile movement_event_queue_t *queue, uint8_t event_type, rtc_counter_t counter, bool coalesce) {
+    uint8_t head = queue->head;
+
+    // The last event can only be updated while it's still in the queue, and not while the consumer is copying it
+    // out: the consumer only drains up to the head it saw when it started, so any slot before that one may be taken.
+    if (coalesce && head != queue->tail && head != queue->draining_until) {
+        volatile movement_queued_event_t *last = &queue->events[(head - 1) & MOVEMENT_EVENT_QUEUE_MASK];
+        if (last->event_type == event_type) {
+            last->counter = counter;
+            return MOVEMENT_EVENT_COALESCED;
+        }
+    }
+
+    uint8_t next_head = (head + 1) & MOVEMENT_EVENT_QUEUE_MASK;
+    if (next_head == queue->tail) {
+        queue->overflow_count++;
+        return MOVEMENT_EVENT_DROPPED;
+    }
+
+    queue->events[head].event_type = event_type;
+    queue->events[head].counter = counter;
+    // publish the event only once it has been written
+    queue->head = next_head;
+
+    return MOVEMENT_EVENT_QUEUED;
+}
+
+uint8_t movement_event_queue_drain(volatile movement_event_queue_t *queue, movement_queued_event_t *events) {
+    // Only what's in the queue right now is taken, so that interrupts refilling it while we copy can't make us run
+    // past the end of events. The slots are handed back all at once at the end.
+    uint8_t head = queue->head;
+    queue->draining_until = head;
+
+    uint8_t tail = queue->tail;
+    uint8_t count = 0;
+    while (tail != head) {
+        events[count].event_type = queue->events[tail].event_type;
+        events[count].counter = queue->events[tail].counter;
+        count++;
+        tail = (tail + 1) & MOVEMENT_EVENT_QUEUE_MASK;
+#ifdef MOVEMENT_EVENT_QUEUE_YIELD
+        movement_event_queue_yield();
+#endif
+    }
+
+    queue->tail = tail;
+    queue->draining_until = MOVEMENT_EVENT_QUEUE_NOT_DRAINING;
+
+    return count;
+}
@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rtc32.h"
+
+/* Events raised by Movement's interrupt callbacks, queued in the order they happened along with the RTC counter at
+   that time. This is a single producer, single consumer ring: all the producers are interrupts of the same priority,
+   which can't preempt each other, and app_loop is the only consumer. The size must be a power of two.
+*/
+#define MOVEMENT_EVENT_QUEUE_SIZE (32)
+#define MOVEMENT_EVENT_QUEUE_MASK (MOVEMENT_EVENT_QUEUE_SIZE - 1)
+
+/// The most events a single movement_event_queue_drain can hand back.
+#define MOVEMENT_EVENT_QUEUE_MAX_DRAIN (MOVEMENT_EVENT_QUEUE_SIZE - 1)
+
+_Static_assert((MOVEMENT_EVENT_QUEUE_SIZE & MOVEMENT_EVENT_QUEUE_MASK) == 0, "the event queue size must be a power of two");
+_Static_assert(MOVEMENT_EVENT_QUEUE_SIZE <= 128, "the event queue indices are bytes");
+
+typedef struct {
+    uint8_t event_type;
+    rtc_counter_t counter;
+} movement_queued_event_t;
+
+typedef struct {
+    movement_queued_event_t events[MOVEMENT_EVENT_QUEUE_SIZE];
+    uint8_t head;           // only written by the producer
+    uint8_t tail;           // only written by the consumer
+    uint8_t draining_until; // the head the consumer is draining up to, or MOVEMENT_EVENT_QUEUE_NOT_DRAINING
+    uint32_t overflow_count;
+} movement_event_queue_t;
+
+#define MOVEMENT_EVENT_QUEUE_NOT_DRAINING (0xFF)
+
+typedef enum {
+    MOVEMENT_EVENT_QUEUED = 0,      // the event went into the queue
+    MOVEMENT_EVENT_COALESCED,       // the event replaced the counter of the last one queued, which had the same type
+    MOVEMENT_EVENT_DROPPED,         // the queue was full; overflow_count was incremented
+} movement_event_queue_result_t;
+
+/** @brief Empties a queue. Call it before the producer is started.
+  */
+void movement_event_queue_init(volatile movement_event_queue_t *queue);
+
+/** @brief Adds an event to the queue. Called by the producer only.
+  * @param queue the queue
+  * @param event_type the type of event
+  * @param counter the RTC counter at the time of the event
+  * @param coalesce if true, and the last event still waiting in the queue has the same type, only its counter is
+  *                 updated. This is for events like ticks, where a newer one supersedes one that hasn't been
+  *                 handled yet.
+  */
+movement_event_queue_result_t movement_event_queue_push(volatile movement_event_queue_t *queue, uint8_t event_type, rtc_counter_t counter, bool coalesce);
+
+/** @brief Takes every event in the queue out of it, in order. Called by the consumer only.
+  * @param queue the queue
+  * @param events a buffer of at least MOVEMENT_EVENT_QUEUE_MAX_DRAIN events
+  * @return the number of events copied into events. Events pushed while this runs are left for the next call.
+  */
+uint8_t movement_event_queue_drain(volatile movement_event_queue_t *queue, movement_queued_event_t *events);
+
+#ifdef MOVEMENT_EVENT_QUEUE_YIELD
+/** @brief Only in the host test, which builds with MOVEMENT_EVENT_QUEUE_YIELD defined and provides this: called by
+  *        movement_event_queue_drain after each event it copies, so the test can run an interrupt in the middle of a
+  *        drain.
+  */
+void movement_event_queue_yield(void);
+#endif
@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "movement_gestures.h"
+
+typedef struct {
+    movement_event_type_t down_event;
+    movement_event_type_t double_click_event;
+    movement_event_type_t triple_click_event;
+    movement_event_type_t repeat_event;
+    uint16_t double_click_gesture;
+    uint16_t triple_click_gesture;
+    uint16_t repeat_gesture;
+} movement_gesture_button_def_t;
+
+typedef struct {
+    uint8_t first;
+    uint8_t second;
+    movement_event_type_t event;
+    uint16_t gesture;
+} movement_gesture_chord_def_t;
+
+// in the same order as the button events in movement_event_type_t
+static const movement_gesture_button_def_t _movement_gesture_buttons[MOVEMENT_GESTURE_NUM_BUTTONS] = {
+    { EVENT_LIGHT_BUTTON_DOWN, EVENT_LIGHT_DOUBLE_CLICK, EVENT_LIGHT_TRIPLE_CLICK, EVENT_LIGHT_REPEAT,
+      MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK, MOVEMENT_GESTURE_LIGHT_TRIPLE_CLICK, MOVEMENT_GESTURE_LIGHT_REPEAT },
+    { EVENT_MODE_BUTTON_DOWN, EVENT_MODE_DOUBLE_CLICK, EVENT_MODE_TRIPLE_CLICK, EVENT_MODE_REPEAT,
+      MOVEMENT_GESTURE_MODE_DOUBLE_CLICK, MOVEMENT_GESTURE_MODE_TRIPLE_CLICK, MOVEMENT_GESTURE_MODE_REPEAT },
+    { EVENT_ALARM_BUTTON_DOWN, EVENT_ALARM_DOUBLE_CLICK, EVENT_ALARM_TRIPLE_CLICK, EVENT_ALARM_REPEAT,
+      MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK, MOVEMENT_GESTURE_ALARM_TRIPLE_CLICK, MOVEMENT_GESTURE_ALARM_REPEAT },
+};
+
+static const movement_gesture_chord_def_t _movement_gesture_chords[] = {
+    { 0, 1, EVENT_LIGHT_MODE_CHORD, MOVEMENT_GESTURE_LIGHT_MODE_CHORD },
+    { 0, 2, EVENT_LIGHT_ALARM_CHORD, MOVEMENT_GESTURE_LIGHT_ALARM_CHORD },
+    { 1, 2, EVENT_MODE_ALARM_CHORD, MOVEMENT_GESTURE_MODE_ALARM_CHORD },
+};
+
+// Interval in ticks before each repeat event after the first one; the last entry applies from then on.
+static const uint8_t _movement_gesture_repeat_intervals[] = { 32, 32, 26, 20, 16, 13, 10, 8 };
+
+static void _movement_gesture_emit(movement_gesture_output_t *out, movement_event_type_t event_type, rtc_counter_t counter) {
+    if (out->count < MOVEMENT_GESTURE_MAX_EVENTS) {
+        out->events[out->count++] = (movement_queued_event_t) { event_type, counter };
+    }
+}
+
+// Each button has at most one repeat due per call, since a late wake-up shouldn't result in a burst of repeats.
+void movement_gesture_expire(movement_gesture_state_t *state, rtc_counter_t counter, movement_gesture_output_t *out) {
+    for (uint8_t i = 0; i < MOVEMENT_GESTURE_NUM_BUTTONS; i++) {
+        const movement_gesture_button_def_t *def = &_movement_gesture_buttons[i];
+        movement_gesture_button_state_t *button = &state->buttons[i];
+
+        if (button->click_pending && (int32_t)(counter - button->click_deadline) >= 0) {
+            button->click_pending = false;
+            button->clicks = 0;
+            _movement_gesture_emit(out, def->double_click_event, button->click_deadline);
+        }
+
+        if (button->repeat_pending && (int32_t)(counter - button->repeat_deadline) >= 0) {
+            uint8_t last = sizeof(_movement_gesture_repeat_intervals) - 1;
+            uint8_t interval = _movement_gesture_repeat_intervals[button->repeats < last ? button->repeats : last];
+
+            _movement_gesture_emit(out, def->repeat_event, button->repeat_deadline);
+            if (button->repeats < UINT8_MAX) button->repeats++;
+            button->repeat_deadline += interval;
+            if ((int32_t)(counter - button->repeat_deadline) >= 0) button->repeat_deadline = counter + interval;
+        }
+    }
+}
+
+static void _movement_gesture_button_down(movement_gesture_state_t *state, uint8_t index, rtc_counter_t counter, movement_gesture_output_t *out) {
+    const movement_gesture_button_def_t *def = &_movement_gesture_buttons[index];
+    movement_gesture_button_state_t *button = &state->buttons[index];
+
+    // too late to continue the multi-click, start over.
+    if (button->clicks && (counter - button->up_counter) > state->multi_click_window) {
+        button->clicks = 0;
+    }
+    // a third click is under way, the double click will turn into either a triple click or nothing.
+    button->click_pending = false;
+
+    button->is_down = true;
+    button->in_chord = false;
+    button->down_counter = counter;
+    button->repeats = 0;
+    button->repeat_pending = (state->enabled & def->repeat_gesture) != 0;
+    button->repeat_deadline = counter + MOVEMENT_REPEAT_DELAY_TICKS;
+
+    for (uint8_t i = 0; i < sizeof(_movement_gesture_chords) / sizeof(_movement_gesture_chords[0]); i++) {
+        const movement_gesture_chord_def_t *chord = &_movement_gesture_chords[i];
+        if (!(state->enabled & chord->gesture)) continue;
+        if (chord->first != index && chord->second != index) continue;
+
+        movement_gesture_button_state_t *other = &state->buttons[chord->first == index ? chord->second : chord->first];
+        if (!other->is_down || other->in_chord || (counter - other->down_counter) > MOVEMENT_CHORD_WINDOW_TICKS) continue;
+
+        _movement_gesture_emit(out, chord->event, counter);
+        button->in_chord = other->in_chord = true;
+        button->repeat_pending = other->repeat_pending = false;
+        button->clicks = other->clicks = 0;
+        break;
+    }
+}
+
+static void _movement_gesture_button_up(movement_gesture_state_t *state, uint8_t index, rtc_counter_t counter, movement_gesture_output_t *out) {
+    const movement_gesture_button_def_t *def = &_movement_gesture_buttons[index];
+    movement_gesture_button_state_t *button = &state->buttons[index];
+    bool is_click = button->is_down && !button->in_chord && button->repeats == 0 &&
+                    (counter - button->down_counter) < MOVEMENT_LONG_PRESS_TICKS;
+
+    button->is_down = false;
+    button->repeat_pending = false;
+    button->up_counter = counter;
+
+    if (!is_click) {
+        button->clicks = 0;
+        return;
+    }
+
+    button->clicks++;
+    if (button->clicks == 2 && (state->enabled & def->double_click_gesture)) {
+        if (state->enabled & def->triple_click_gesture) {
+            // hold it back until we know whether a third click follows
+            button->click_pending = true;
+            button->click_deadline = counter + state->multi_click_window;
+        } else {
+            _movement_gesture_emit(out, def->double_click_event, counter);
+            button->clicks = 0;
+        }
+    } else if (button->clicks >= 3) {
+        if (state->enabled & def->triple_click_gesture) {
+            _movement_gesture_emit(out, def->triple_click_event, counter);
+        }
+        button->clicks = 0;
+    }
+}
+
+void movement_gesture_feed(movement_gesture_state_t *state, movement_event_type_t event_type, rtc_counter_t counter, movement_gesture_output_t *out) {
+    movement_gesture_expire(state, counter, out);
+
+    if (event_type < EVENT_LIGHT_BUTTON_DOWN || event_type >= EVENT_LIGHT_BUTTON_DOWN + 5 * MOVEMENT_GESTURE_NUM_BUTTONS) return;
+
+    uint8_t index = (event_type - EVENT_LIGHT_BUTTON_DOWN) / 5;
+    uint8_t kind = (event_type - EVENT_LIGHT_BUTTON_DOWN) % 5;
+
+    if (kind == 0) {
+        _movement_gesture_button_down(state, index, counter, out);
+    } else if (kind == 1 || kind == 3) {
+        // button up or long up
+        _movement_gesture_button_up(state, index, counter, out);
+    }
+}
+
+void movement_gesture_reset(movement_gesture_state_t *state) {
+    memset(state, 0, sizeof(movement_gesture_state_t));
+    state->multi_click_window = MOVEMENT_MULTI_CLICK_WINDOW_TICKS;
+}
+
+void movement_gesture_set_enabled(movement_gesture_state_t *state, uint16_t gestures) {
+    state->enabled = gestures;
+
+    // drop whatever was pending for the gestures that were just turned off
+    for (uint8_t i = 0; i < MOVEMENT_GESTURE_NUM_BUTTONS; i++) {
+        if (!(gestures & _movement_gesture_buttons[i].double_click_gesture)) state->buttons[i].click_pending = false;
+        if (!(gestures & _movement_gesture_buttons[i].repeat_gesture)) state->buttons[i].repeat_pending = false;
+    }
+}
+
+bool movement_gesture_get_next_deadline(const movement_gesture_state_t *state, rtc_counter_t *deadline) {
+    bool found = false;
+
+    for (uint8_t i = 0; i < MOVEMENT_GESTURE_NUM_BUTTONS; i++) {
+        const movement_gesture_button_state_t *button = &state->buttons[i];
+        if (button->click_pending && (!found || (int32_t)(button->click_deadline - *deadline) < 0)) {
+            *deadline = button->click_deadline;
+            found = true;
+        }
+        if (button->repeat_pending && (!found || (int32_t)(button->repeat_deadline - *deadline) < 0)) {
+            *deadline = button->repeat_deadline;
+            found = true;
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "movement.h"
+#include "movement_event_queue.h"
+
+/* Gesture recognizer. It is fed the button events in the order they happened, with the RTC counter of each one,
+   and emits the gesture events the current face opted in to. Anything that has to happen later (a repeat, a double
+   click held back in case a third click follows) is a deadline; Movement arms an RTC comparator at the earliest one
+   and calls movement_gesture_expire when it fires. The recognizer only looks at the counters it is given, never at
+   the clock or the pins.
+*/
+
+#define MOVEMENT_LONG_PRESS_TICKS 64
+#define MOVEMENT_MULTI_CLICK_WINDOW_TICKS 38 // default time between a release and the next press of a multi-click
+#define MOVEMENT_CHORD_WINDOW_TICKS 19 // max time between the two presses of a chord
+#define MOVEMENT_REPEAT_DELAY_TICKS 48 // time from the press to the first repeat event
+
+#define MOVEMENT_GESTURE_NUM_BUTTONS (3)
+/// The most events a single call can emit.
+#define MOVEMENT_GESTURE_MAX_EVENTS (8)
+
+typedef struct {
+    rtc_counter_t down_counter;
+    rtc_counter_t up_counter;
+    rtc_counter_t click_deadline;   // when a held back double click gets emitted
+    rtc_counter_t repeat_deadline;  // when the next repeat event gets emitted
+    uint8_t clicks;                 // short clicks counted so far in the current multi-click
+    uint8_t repeats;                // repeat events emitted during the current press
+    bool is_down;
+    bool in_chord;                  // this press is part of a chord, so it neither counts as a click nor repeats
+    bool click_pending;
+    bool repeat_pending;
+} movement_gesture_button_state_t;
+
+typedef struct {
+    uint16_t enabled;
+    uint16_t multi_click_window;
+    movement_gesture_button_state_t buttons[MOVEMENT_GESTURE_NUM_BUTTONS];
+} movement_gesture_state_t;
+
+typedef struct {
+    movement_queued_event_t events[MOVEMENT_GESTURE_MAX_EVENTS];
+    uint8_t count;
+} movement_gesture_output_t;
+
+/// Forgets everything in progress and turns all gestures off.
+void movement_gesture_reset(movement_gesture_state_t *state);
+
+/// Sets the gestures to recognize (see movement_gesture_t), dropping anything pending for the ones turned off.
+void movement_gesture_set_enabled(movement_gesture_state_t *state, uint16_t gestures);
+
+/// Feeds one button event to the recognizer, after emitting anything that was due before it.
+void movement_gesture_feed(movement_gesture_state_t *state, movement_event_type_t event_type, rtc_counter_t counter, movement_gesture_output_t *out);
+
+/// Emits whatever was due at or before the given counter.
+void movement_gesture_expire(movement_gesture_state_t *state, rtc_counter_t counter, movement_gesture_output_t *out);
+
+/// Gets the earliest deadline, if there is one. That's when movement_gesture_expire has something to emit next.
+bool movement_gesture_get_next_deadline(const movement_gesture_state_t *state, rtc_counter_t *deadline);
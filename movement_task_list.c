@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_task_list.h"
+
+void movement_task_list_init(movement_task_list_t *list, movement_scheduled_task_t *tasks, uint8_t num_tasks) {
+    list->tasks = tasks;
+    list->num_tasks = num_tasks;
+    list->head = MOVEMENT_NO_SCHEDULED_TASK;
+    for (uint8_t i = 0; i < num_tasks; i++) tasks[i].is_scheduled = false;
+}
+
+void movement_task_list_cancel(movement_task_list_t *list, uint8_t watch_face_index) {
+    if (watch_face_index >= list->num_tasks || !list->tasks[watch_face_index].is_scheduled) return;
+
+    uint8_t *link = &list->head;
+    while (*link != watch_face_index) {
+        link = &list->tasks[*link].next;
+    }
+    *link = list->tasks[watch_face_index].next;
+    list->tasks[watch_face_index].is_scheduled = false;
+}
+
+void movement_task_list_schedule(movement_task_list_t *list, uint8_t watch_face_index, unix_timestamp_t timestamp) {
+    if (watch_face_index >= list->num_tasks) return;
+    movement_task_list_cancel(list, watch_face_index);
+
+    // tasks with the same deadline run in the order they were scheduled
+    uint8_t *link = &list->head;
+    while (*link != MOVEMENT_NO_SCHEDULED_TASK && list->tasks[*link].timestamp <= timestamp) {
+        link = &list->tasks[*link].next;
+    }
+    list->tasks[watch_face_index].timestamp = timestamp;
+    list->tasks[watch_face_index].next = *link;
+    list->tasks[watch_face_index].is_scheduled = true;
+    *link = watch_face_index;
+}
+
+uint8_t movement_task_list_pop_due(movement_task_list_t *list, unix_timestamp_t now) {
+    uint8_t index = list->head;
+    if (index == MOVEMENT_NO_SCHEDULED_TASK || list->tasks[index].timestamp > now) return MOVEMENT_NO_SCHEDULED_TASK;
+
+    list->head = list->tasks[index].next;
+    list->tasks[index].is_scheduled = false;
+
+    return index;
+}
+
+bool movement_task_list_get_next_deadline(const movement_task_list_t *list, unix_timestamp_t *deadline) {
+    if (list->head == MOVEMENT_NO_SCHEDULED_TASK) return false;
+    *deadline = list->tasks[list->head].timestamp;
+
+    return true;
+}
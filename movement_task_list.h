@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch_rtc.h"
+
+/* Background tasks scheduled by the faces.
+   Pending tasks are kept in a singly linked list sorted by deadline (UTC timestamp), with one node per face, so the
+   earliest task is always at the head. Movement arms an RTC comparator for the head only, and the watch wakes up
+   exactly when the earliest task is due. The list only looks at the timestamps it is given, never at the clock.
+*/
+
+#define MOVEMENT_NO_SCHEDULED_TASK (0xFF)
+
+typedef struct {
+    unix_timestamp_t timestamp;
+    uint8_t next;
+    bool is_scheduled;
+} movement_scheduled_task_t;
+
+typedef struct {
+    movement_scheduled_task_t *tasks;   // one per face, indexed by watch face index
+    uint8_t num_tasks;
+    uint8_t head;                       // the face whose task is due first, or MOVEMENT_NO_SCHEDULED_TASK
+} movement_task_list_t;
+
+/// Sets up an empty list over an array of num_tasks nodes, at most MOVEMENT_NO_SCHEDULED_TASK of them.
+void movement_task_list_init(movement_task_list_t *list, movement_scheduled_task_t *tasks, uint8_t num_tasks);
+
+/// Schedules a face's task, replacing the one it had. Tasks with the same deadline run in the order they were scheduled.
+void movement_task_list_schedule(movement_task_list_t *list, uint8_t watch_face_index, unix_timestamp_t timestamp);
+
+/// Cancels a face's task, if it had one.
+void movement_task_list_cancel(movement_task_list_t *list, uint8_t watch_face_index);
+
+/// Removes the earliest task if it is due at or before now, and returns its face; MOVEMENT_NO_SCHEDULED_TASK otherwise.
+uint8_t movement_task_list_pop_due(movement_task_list_t *list, unix_timestamp_t now);
+
+/// Gets the earliest deadline, if there is one.
+bool movement_task_list_get_next_deadline(const movement_task_list_t *list, unix_timestamp_t *deadline);
@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_tz.h"
+#include "watch_utility.h"
+#include "utz.h"
+#include "zones.h"
+
+// Offsets are cached in 15 minute increments, to fit in an int8_t.
+#define TIMEZONE_DOES_NOT_OBSERVE (-127)
+
+static int8_t _movement_tz_current_offset[NUM_ZONE_NAMES] = {0};
+
+// UTC timestamp of each zone's next DST transition, and the soonest of them all.
+static unix_timestamp_t _movement_tz_next_transition[NUM_ZONE_NAMES];
+static unix_timestamp_t _movement_tz_next_transition_any = 0;
+// To find the next transition, we step forward a week at a time (no zone changes its offset twice in a week),
+// for up to a year. If nothing changes in that time, we look again a year from now.
+#define MOVEMENT_TZ_PROBE_INTERVAL (7 * 86400)
+#define MOVEMENT_TZ_PROBE_COUNT (53)
+
+// Faces that convert many timestamps get a table of each zone's transitions over a window of years around now,
+// built on first use. A handful of zones are kept at a time, least recently used goes first.
+#define MOVEMENT_TZ_TABLE_SLOTS (4)
+#define MOVEMENT_TZ_TABLE_MAX_TRANSITIONS (24)
+#define MOVEMENT_TZ_TABLE_YEARS_BEFORE (1)
+#define MOVEMENT_TZ_TABLE_YEARS_AFTER (3)
+
+typedef struct {
+    unix_timestamp_t start;
+    unix_timestamp_t end;
+    // offsets[0] applies from start, and offsets[i + 1] from transitions[i], until end.
+    unix_timestamp_t transitions[MOVEMENT_TZ_TABLE_MAX_TRANSITIONS];
+    int8_t offsets[MOVEMENT_TZ_TABLE_MAX_TRANSITIONS + 1];
+    uint8_t num_transitions;
+    uint8_t zone_index;
+    uint16_t last_used;
+    bool is_valid;
+} movement_tz_table_t;
+
+static movement_tz_table_t _movement_tz_tables[MOVEMENT_TZ_TABLE_SLOTS];
+static uint16_t _movement_tz_table_uses = 0;
+
+static udatetime_t _movement_tz_convert_date_time_to_udate(watch_date_time_t date_time) {
+    return (udatetime_t) {
+        .date.dayofmonth = date_time.unit.day,
+        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR), date_time.unit.month, date_time.unit.day),
+        .date.month = date_time.unit.month,
+        .date.year = UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR),
+        .time.hour = date_time.unit.hour,
+        .time.minute = date_time.unit.minute,
+        .time.second = date_time.unit.second
+    };
+}
+
+static int8_t _movement_tz_get_dst_offset_at(const uzone_t *zone, unix_timestamp_t timestamp) {
+    // zone rules are evaluated against local standard time.
+    watch_date_time_t date_time = watch_utility_date_time_from_unix_time(timestamp, zone->offset.hours * 3600 + zone->offset.minutes * 60);
+    udatetime_t udate_time = _movement_tz_convert_date_time_to_udate(date_time);
+    uoffset_t offset;
+
+    get_current_offset(zone, &udate_time, &offset);
+
+    return (offset.hours * 60 + offset.minutes) / 15;
+}
+
+static unix_timestamp_t _movement_tz_find_next_transition(const uzone_t *zone, unix_timestamp_t now, int8_t current_offset) {
+    unix_timestamp_t before = now;
+    unix_timestamp_t after;
+    uint8_t probes = 0;
+
+    do {
+        after = before + MOVEMENT_TZ_PROBE_INTERVAL;
+        if (_movement_tz_get_dst_offset_at(zone, after) != current_offset) break;
+        before = after;
+    } while (++probes < MOVEMENT_TZ_PROBE_COUNT);
+
+    if (probes == MOVEMENT_TZ_PROBE_COUNT) return before;
+
+    // the offset changes somewhere in (before, after]; narrow it down to the minute.
+    while (after - before > 60) {
+        unix_timestamp_t middle = before + (after - before) / 2;
+        if (_movement_tz_get_dst_offset_at(zone, middle) == current_offset) {
+            before = middle;
+        } else {
+            after = middle;
+        }
+    }
+
+    // transitions happen on the minute, and there is exactly one minute boundary in (before, after].
+    return after / 60 * 60;
+}
+
+bool movement_tz_update(unix_timestamp_t now, bool force) {
+    uzone_t local_zone;
+    bool dst_changed = false;
+
+    _movement_tz_next_transition_any = UINT32_MAX;
+
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        if (force || _movement_tz_next_transition[i] <= now) {
+            unpack_zone(&zone_defns[i], "", &local_zone);
+
+            if (!!local_zone.rules_len) {
+                // if local zone has DST rules, we need to see if DST applies, and until when.
+                int8_t new_offset = _movement_tz_get_dst_offset_at(&local_zone, now);
+                if (_movement_tz_current_offset[i] != new_offset) {
+                    _movement_tz_current_offset[i] = new_offset;
+                    dst_changed = true;
+                }
+                _movement_tz_next_transition[i] = _movement_tz_find_next_transition(&local_zone, now, new_offset);
+            } else {
+                // otherwise set the cache to a constant value that indicates no DST check needs to be performed.
+                _movement_tz_current_offset[i] = TIMEZONE_DOES_NOT_OBSERVE;
+                _movement_tz_next_transition[i] = UINT32_MAX;
+            }
+        }
+
+        if (_movement_tz_next_transition[i] < _movement_tz_next_transition_any) {
+            _movement_tz_next_transition_any = _movement_tz_next_transition[i];
+        }
+    }
+
+    return dst_changed;
+}
+
+unix_timestamp_t movement_tz_get_next_transition(void) {
+    return _movement_tz_next_transition_any;
+}
+
+bool movement_tz_observes_dst(uint8_t zone_index) {
+    return _movement_tz_current_offset[zone_index] != TIMEZONE_DOES_NOT_OBSERVE;
+}
+
+int32_t movement_tz_get_standard_offset(uint8_t zone_index) {
+    return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
+}
+
+int32_t movement_tz_get_current_offset(uint8_t zone_index) {
+    int8_t cached_dst_offset = _movement_tz_current_offset[zone_index];
+
+    if (cached_dst_offset == TIMEZONE_DOES_NOT_OBSERVE) {
+        // if time zone doesn't observe DST, we can just return the standard time offset from the zone definition.
+        return movement_tz_get_standard_offset(zone_index);
+    } else {
+        // otherwise, we've precalculated the offset for this zone and can return it.
+        return (int32_t)cached_dst_offset * OFFSET_INCREMENT * 60;
+    }
+}
+
+static void _movement_tz_build_table(movement_tz_table_t *table, const uzone_t *zone, uint8_t zone_index, unix_timestamp_t now) {
+    table->zone_index = zone_index;
+    table->start = now - MOVEMENT_TZ_TABLE_YEARS_BEFORE * 365 * 86400;
+    table->end = now + MOVEMENT_TZ_TABLE_YEARS_AFTER * 365 * 86400;
+    table->num_transitions = 0;
+    table->offsets[0] = _movement_tz_get_dst_offset_at(zone, table->start);
+
+    unix_timestamp_t timestamp = table->start;
+    while (timestamp < table->end) {
+        int8_t offset = table->offsets[table->num_transitions];
+        timestamp = _movement_tz_find_next_transition(zone, timestamp, offset);
+        if (timestamp >= table->end) break;
+        // a year without transitions; keep looking from there.
+        if (_movement_tz_get_dst_offset_at(zone, timestamp) == offset) continue;
+        if (table->num_transitions == MOVEMENT_TZ_TABLE_MAX_TRANSITIONS) {
+            // out of room: the table only covers up to this transition.
+            table->end = timestamp;
+            break;
+        }
+        table->transitions[table->num_transitions++] = timestamp;
+        table->offsets[table->num_transitions] = _movement_tz_get_dst_offset_at(zone, timestamp);
+    }
+
+    table->is_valid = true;
+}
+
+static movement_tz_table_t *_movement_tz_get_table(uint8_t zone_index, unix_timestamp_t timestamp, unix_timestamp_t now) {
+    movement_tz_table_t *table = NULL;
+
+    for (uint8_t i = 0; i < MOVEMENT_TZ_TABLE_SLOTS; i++) {
+        if (_movement_tz_tables[i].is_valid && _movement_tz_tables[i].zone_index == zone_index) {
+            table = &_movement_tz_tables[i];
+            break;
+        }
+    }
+
+    if (table == NULL || timestamp < table->start || timestamp >= table->end) {
+        // only build tables around the current time; a far off timestamp is a one-off, and isn't worth evicting for.
+        if (timestamp < now - MOVEMENT_TZ_TABLE_YEARS_BEFORE * 365 * 86400 || timestamp >= now + MOVEMENT_TZ_TABLE_YEARS_AFTER * 365 * 86400) {
+            return NULL;
+        }
+        if (table == NULL) {
+            table = &_movement_tz_tables[0];
+            for (uint8_t i = 1; i < MOVEMENT_TZ_TABLE_SLOTS; i++) {
+                if (!table->is_valid) break;
+                if (!_movement_tz_tables[i].is_valid || (uint16_t)(_movement_tz_table_uses - _movement_tz_tables[i].last_used) > (uint16_t)(_movement_tz_table_uses - table->last_used)) {
+                    table = &_movement_tz_tables[i];
+                }
+            }
+        }
+        uzone_t local_zone;
+        unpack_zone(&zone_defns[zone_index], "", &local_zone);
+        _movement_tz_build_table(table, &local_zone, zone_index, now);
+        if (timestamp < table->start || timestamp >= table->end) return NULL;
+    }
+
+    table->last_used = ++_movement_tz_table_uses;
+
+    return table;
+}
+
+int32_t movement_tz_get_offset_at(unix_timestamp_t timestamp, uint8_t zone_index, unix_timestamp_t now) {
+    if (!movement_tz_observes_dst(zone_index)) return movement_tz_get_standard_offset(zone_index);
+
+    movement_tz_table_t *table = _movement_tz_get_table(zone_index, timestamp, now);
+
+    if (table == NULL) return movement_tz_get_offset_from_rules(timestamp, zone_index);
+
+    // find how many transitions have happened by this timestamp.
+    uint8_t low = 0;
+    uint8_t high = table->num_transitions;
+    while (low < high) {
+        uint8_t middle = (low + high) / 2;
+        if (table->transitions[middle] <= timestamp) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return (int32_t)table->offsets[low] * OFFSET_INCREMENT * 60;
+}
+
+int32_t movement_tz_get_offset_from_rules(unix_timestamp_t timestamp, uint8_t zone_index) {
+    uzone_t local_zone;
+    unpack_zone(&zone_defns[zone_index], "", &local_zone);
+    if (!local_zone.rules_len) return movement_tz_get_standard_offset(zone_index);
+
+    return (int32_t)_movement_tz_get_dst_offset_at(&local_zone, timestamp) * OFFSET_INCREMENT * 60;
+}
@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch_rtc.h"
+
+/* UTC offsets of the time zones in utz's zone list, for Movement. The offset each zone is in right now is cached
+   along with the time of its next DST transition, so Movement only has to look at the zone rules when a transition
+   is due. Offsets at other times come from per-zone tables of transitions, built on first use.
+   Offsets are in seconds, like everywhere else in Movement.
+*/
+
+/** @brief Recomputes the current offset of every zone whose next transition is due.
+  * @param now The current UTC time.
+  * @param force Recompute every zone, e.g. at boot or when the time was set (it may have moved backwards).
+  * @return true if any zone's offset changed.
+  */
+bool movement_tz_update(unix_timestamp_t now, bool force);
+
+/// The UTC time at which some zone's offset changes next. Call movement_tz_update once it has passed.
+unix_timestamp_t movement_tz_get_next_transition(void);
+
+/// The offset the zone was in as of the last movement_tz_update.
+int32_t movement_tz_get_current_offset(uint8_t zone_index);
+
+/// Whether the zone has DST rules, i.e. whether its offset ever changes.
+bool movement_tz_observes_dst(uint8_t zone_index);
+
+/// The zone's offset outside of DST.
+int32_t movement_tz_get_standard_offset(uint8_t zone_index);
+
+/** @brief The offset in effect at a given time.
+  * @param timestamp The UTC time to look up.
+  * @param zone_index The zone.
+  * @param now The current UTC time. Tables are only built for a window of years around it; a timestamp outside
+  *            of that window is evaluated against the zone's rules directly, which is much slower.
+  */
+int32_t movement_tz_get_offset_at(unix_timestamp_t timestamp, uint8_t zone_index, unix_timestamp_t now);
+
+/// Evaluates the zone's rules at a given UTC time, without any caching.
+int32_t movement_tz_get_offset_from_rules(unix_timestamp_t timestamp, uint8_t zone_index);
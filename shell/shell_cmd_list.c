@@ -27,14 +27,18 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "filesystem.h"
+#include "movement.h"
 #include "watch.h"
 #include "delay.h"
 
 static int help_cmd(int argc, char *argv[]);
 static int flash_cmd(int argc, char *argv[]);
 static int stress_cmd(int argc, char *argv[]);
+static int wakelog_cmd(int argc, char *argv[]);
+static int lcdstat_cmd(int argc, char *argv[]);
 
 shell_command_t g_shell_commands[] = {
     {
@@ -107,6 +111,57 @@ shell_command_t g_shell_commands[] = {
         .max_args = 3,
         .cb = filesystem_cmd_echo,
     },
+    {
+        .name = "advise",
+        .help = "print how many advise calls were made and avoided",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_advise,
+    },
+    {
+        .name = "wakes",
+        .help = "usage: wakes [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = movement_cmd_wakes,
+    },
+    {
+        .name = "events",
+        .help = "print how many events were dropped by the event queue",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_events,
+    },
+    {
+        .name = "arena",
+        .help = "print how much RAM the watch face contexts use",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = movement_cmd_arena,
+    },
+#ifdef MOVEMENT_ENABLE_STATS
+    {
+        .name = "stats",
+        .help = "usage: stats [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = movement_cmd_stats,
+    },
+#endif
+    {
+        .name = "wakelog",
+        .help = "dump the wakeup log; usage: wakelog [clear]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = wakelog_cmd,
+    },
+    {
+        .name = "lcdstat",
+        .help = "show segment updates vs. display memory writes",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = lcdstat_cmd,
+    },
     {
         .name = "stress",
         .help = "test CDC write; usage: stress [LEN] [DELAY_MS]",
@@ -171,3 +226,39 @@ static int stress_cmd(int argc, char *argv[]) {
 
     return 0;
 }
+
+static int wakelog_cmd(int argc, char *argv[]) {
+    static const char *cause_names[] = {"none", "reset", "per", "cmp", "tamper", "ovf", "eic", "usb", "tc0", "other"};
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "clear") != 0) return -1;
+        watch_wakelog_clear();
+        return 0;
+    }
+
+    // utils/wakelog/decode_wakelog.py parses this format, so keep them in sync.
+    uint8_t count = watch_wakelog_get_count();
+    printf("=== WAKELOG %u %lu ===\r\n", count, (unsigned long)watch_rtc_get_frequency());
+    for (uint8_t i = 0; i < count; i++) {
+        watch_wakelog_entry_t entry;
+        if (!watch_wakelog_get_entry(i, &entry)) break;
+        const char *name = entry.cause < sizeof(cause_names) / sizeof(cause_names[0]) ? cause_names[entry.cause] : "?";
+        printf("%u %lu %s %u\r\n", entry.sequence, (unsigned long)entry.counter, name, entry.detail);
+    }
+    printf("=== END ===\r\n");
+
+    return 0;
+}
+
+static int lcdstat_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    uint32_t segment_writes, register_writes;
+    watch_display_get_write_counts(&segment_writes, &register_writes);
+    // without the shadow framebuffer, every segment update was a read-modify-write of the display memory.
+    printf("segment updates: %lu\r\n", (unsigned long)segment_writes);
+    printf("register writes: %lu\r\n", (unsigned long)register_writes);
+
+    return 0;
+}
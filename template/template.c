@@ -29,11 +29,12 @@
 void <#watch_face_name#>_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(<#watch_face_name#>_state_t));
+        *context_ptr = movement_context_alloc(sizeof(<#watch_face_name#>_state_t));
         memset(*context_ptr, 0, sizeof(<#watch_face_name#>_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
-    // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
+    // This function only runs at boot. If you need to restore a pin or peripheral whenever the watch wakes from deep sleep,
+    // add a resume function to your watch_face_t and do it there.
 }
 
 void <#watch_face_name#>_face_activate(void *context) {
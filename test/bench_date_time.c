@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Times watch_utility_date_time_from_unix_time_cached against the full conversion, for the steps Movement makes:
+ * a second at a time for the 1 Hz tick, and a minute at a time for the minute handler in low energy mode.
+ *
+ * Timings are from the host, which divides in hardware. The M0+ doesn't, so on the watch the full conversion costs
+ * far more than it does here, and the gap is bigger than what this shows.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "watch_utility.h"
+
+#define START (1780272000) // 2026-06-01 00:00 UTC
+#define NUM_CONVERSIONS (10000000)
+
+static volatile uint32_t sink;
+
+static double _seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void _bench(const char *name, uint32_t step) {
+    watch_date_time_cache_t cache = {0};
+
+    double start = _seconds();
+    for (uint32_t i = 0; i < NUM_CONVERSIONS; i++) sink = watch_utility_date_time_from_unix_time(START + i * step, 7200).reg;
+    double full = _seconds() - start;
+
+    start = _seconds();
+    for (uint32_t i = 0; i < NUM_CONVERSIONS; i++) sink = watch_utility_date_time_from_unix_time_cached(&cache, START + i * step, 7200).reg;
+    double cached = _seconds() - start;
+
+    printf("    %-22s full %6.1f ns/conversion, incremental %6.1f ns/conversion, %5.1fx\n", name,
+           full * 1e9 / NUM_CONVERSIONS, cached * 1e9 / NUM_CONVERSIONS, full / cached);
+}
+
+int main(void) {
+    _bench("every second:", 1);
+    _bench("every minute:", 60);
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Plays a day of background tasks through the old scheduler and the task list, and counts the work each does.
+ *
+ * The old scheduler kept a deadline per face in an array. While any task was pending it stayed out of low energy
+ * mode, and on every 1 Hz tick it read the RTC and scanned every face's slot. The task list is ordered by deadline,
+ * so the RTC alarm is set for the head and the watch only wakes when something is due.
+ *
+ * Both are modelled here with Unix timestamps rather than the RTC's date/time register, so the RTC reads are counted
+ * rather than timed. Host timings don't stand for the M0+, but the counts do.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "movement_task_list.h"
+
+#define NUM_FACES (40)
+#define START (1780272000) // 2026-06-01 00:00 UTC
+#define DAY (86400)
+#define NUM_DAYS (100)
+
+// faces that keep a task scheduled, and how often it comes due
+static const struct {
+    uint8_t face;
+    uint32_t period;
+} workload[] = {
+    { 3, 60 },      // a countdown that checks in every minute
+    { 7, 300 },     // a sensor logged every five minutes
+    { 12, 900 },    // a quarter-hour chime
+    { 20, 3600 },   // hourly
+    { 21, 3600 },   // another hourly one, due at the same time
+    { 33, DAY },    // a daily alarm
+};
+#define NUM_WORKLOAD (sizeof(workload) / sizeof(workload[0]))
+
+static uint32_t period[NUM_FACES];
+
+typedef struct {
+    uint32_t wakeups;
+    uint32_t rtc_reads;
+    uint32_t visits;
+    uint32_t tasks_run;
+    uint32_t checksum;
+    double seconds;
+} result_t;
+
+static double _seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// the array runs tasks due in the same second in face order and the list in deadline order, so this ignores order
+static void _run_task(result_t *result, uint8_t face, unix_timestamp_t now) {
+    result->tasks_run++;
+    result->checksum += (face + 1) * now;
+}
+
+static void _bench_array(result_t *result) {
+    unix_timestamp_t scheduled[NUM_FACES] = {0};
+    memset(result, 0, sizeof(*result));
+    for (uint8_t i = 0; i < NUM_WORKLOAD; i++) scheduled[workload[i].face] = START + workload[i].period;
+
+    double start = _seconds();
+    for (unix_timestamp_t now = START + 1; now <= START + NUM_DAYS * DAY; now++) {
+        result->wakeups++;
+        result->rtc_reads++;
+        for (uint8_t i = 0; i < NUM_FACES; i++) {
+            result->visits++;
+            if (scheduled[i] && scheduled[i] <= now) {
+                _run_task(result, i, now);
+                scheduled[i] = now + period[i];
+            }
+        }
+    }
+    result->seconds = _seconds() - start;
+}
+
+static void _bench_list(result_t *result) {
+    movement_scheduled_task_t tasks[NUM_FACES];
+    movement_task_list_t list;
+    memset(result, 0, sizeof(*result));
+    movement_task_list_init(&list, tasks, NUM_FACES);
+    for (uint8_t i = 0; i < NUM_WORKLOAD; i++) movement_task_list_schedule(&list, workload[i].face, START + workload[i].period);
+
+    double start = _seconds();
+    unix_timestamp_t now;
+    while (movement_task_list_get_next_deadline(&list, &now) && now <= START + NUM_DAYS * DAY) {
+        // the alarm fires at the head's deadline; Movement reads the RTC counter once to see what's due
+        result->wakeups++;
+        result->rtc_reads++;
+        uint8_t i;
+        while ((i = movement_task_list_pop_due(&list, now)) != MOVEMENT_NO_SCHEDULED_TASK) {
+            result->visits++;
+            _run_task(result, i, now);
+            // and the walk that inserting the next deadline makes
+            for (uint8_t j = list.head; j != MOVEMENT_NO_SCHEDULED_TASK && tasks[j].timestamp <= now + period[i]; j = tasks[j].next) {
+                result->visits++;
+            }
+            movement_task_list_schedule(&list, i, now + period[i]);
+        }
+    }
+    result->seconds = _seconds() - start;
+}
+
+static void _print(const char *name, const result_t *result) {
+    printf("    %-12s %6u wakeups/day, %6u RTC reads/day, %8u slots visited/day, %5u tasks/day, %8.0f ns/day\n", name,
+           result->wakeups / NUM_DAYS, result->rtc_reads / NUM_DAYS, result->visits / NUM_DAYS,
+           result->tasks_run / NUM_DAYS, result->seconds * 1e9 / NUM_DAYS);
+}
+
+int main(void) {
+    result_t array, list;
+
+    for (uint8_t i = 0; i < NUM_WORKLOAD; i++) period[workload[i].face] = workload[i].period;
+
+    _bench_array(&array);
+    _bench_list(&list);
+
+    printf("    %d faces, %zu with a task, %d days\n", NUM_FACES, NUM_WORKLOAD, NUM_DAYS);
+    _print("array scan:", &array);
+    _print("task list:", &list);
+    if (array.tasks_run != list.tasks_run || array.checksum != list.checksum) {
+        printf("    the two ran different tasks!\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Times movement_tz_get_offset_at against evaluating the zone's rules on every call, which is what
+ * movement_get_timezone_offset_for_date_in_zone did before the transition tables: unpack the zone, work out the day
+ * of the week and run the rules. Both get the same random timestamps within the tables' window, and their answers
+ * are compared as they go.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "movement_tz.h"
+#include "zones.h"
+#include "test.h"
+
+#define NOW (1780272000) // 2026-06-01 00:00 UTC
+#define WINDOW_BEFORE (365 * 86400)
+#define WINDOW_AFTER (3 * 365 * 86400)
+#define NUM_LOOKUPS (1000000)
+
+static uint32_t rand_state = 1;
+static unix_timestamp_t timestamps[NUM_LOOKUPS];
+static uint8_t zones[NUM_LOOKUPS];
+static volatile int32_t sink;
+
+static uint32_t _rand(void) {
+    rand_state = rand_state * 1664525 + 1013904223;
+    return rand_state;
+}
+
+static double _seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void _bench(const char *name, const uint8_t *dst_zones, uint8_t num_zones) {
+    for (uint32_t i = 0; i < NUM_LOOKUPS; i++) {
+        timestamps[i] = NOW - WINDOW_BEFORE + _rand() % (WINDOW_BEFORE + WINDOW_AFTER);
+        zones[i] = dst_zones[_rand() % num_zones];
+    }
+
+    double start = _seconds();
+    for (uint32_t i = 0; i < NUM_LOOKUPS; i++) sink = movement_tz_get_offset_from_rules(timestamps[i], zones[i]);
+    double rules = _seconds() - start;
+
+    start = _seconds();
+    for (uint32_t i = 0; i < NUM_LOOKUPS; i++) sink = movement_tz_get_offset_at(timestamps[i], zones[i], NOW);
+    double tables = _seconds() - start;
+
+    for (uint32_t i = 0; i < NUM_LOOKUPS; i++) {
+        CHECK(movement_tz_get_offset_at(timestamps[i], zones[i], NOW) == movement_tz_get_offset_from_rules(timestamps[i], zones[i]));
+    }
+
+    printf("    %-28s rules %7.1f ns/lookup, tables %7.1f ns/lookup, %5.1fx\n", name,
+           rules * 1e9 / NUM_LOOKUPS, tables * 1e9 / NUM_LOOKUPS, rules / tables);
+}
+
+int main(void) {
+    uint8_t dst_zones[NUM_ZONE_NAMES];
+    uint8_t num_dst_zones = 0;
+
+    movement_tz_update(NOW, true);
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        if (movement_tz_observes_dst(i)) dst_zones[num_dst_zones++] = i;
+    }
+    CHECK(num_dst_zones > 0);
+
+    // a face converting timestamps in one zone, e.g. a log browser.
+    _bench("one zone:", dst_zones, 1);
+    // a few zones at once, e.g. a world clock; the tables all stay cached.
+    _bench("four zones:", dst_zones, num_dst_zones < 4 ? num_dst_zones : 4);
+    // more zones than there are tables, so most lookups rebuild one: the worst case.
+    _bench("every DST zone:", dst_zones, num_dst_zones);
+
+    return 0;
+}
@@ -0,0 +1,4 @@
+// Host stand-in for gossamer's external interrupt controller driver, for watch_extint.h.
+#pragma once
+
+typedef int eic_interrupt_trigger_t;
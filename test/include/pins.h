@@ -0,0 +1,2 @@
+// Host stand-in for the board's pin definitions, which only the firmware build has. Nothing here uses pins.
+#pragma once
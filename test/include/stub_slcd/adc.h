@@ -0,0 +1,9 @@
+// Host stand-in for gossamer's ADC driver. Nothing the test runs reads the ADC.
+#pragma once
+
+#include <stdint.h>
+
+static inline void adc_init(void) {}
+static inline void adc_enable(void) {}
+static inline void adc_disable(void) {}
+static inline uint16_t adc_get_analog_value(uint16_t pin) { (void) pin; return 0; }
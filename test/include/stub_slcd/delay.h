@@ -0,0 +1,6 @@
+// Host stand-in for gossamer's delays. The test runs on simulated time, so there is nothing to wait for.
+#pragma once
+
+#include <stdint.h>
+
+static inline void delay_ms(uint32_t ms) { (void) ms; }
@@ -0,0 +1,27 @@
+// Host stand-in for the board's pin definitions, with just the pins the display code touches.
+#pragma once
+
+#include <stdbool.h>
+
+#define HAL_GPIO_PMUX_B (1)
+#define HAL_GPIO_PMUX_ADC (1)
+#define _HAL_GPIO_STUB(name) \
+    static inline void HAL_GPIO_##name##_in(void) {} \
+    static inline void HAL_GPIO_##name##_out(void) {} \
+    static inline void HAL_GPIO_##name##_set(void) {} \
+    static inline void HAL_GPIO_##name##_clr(void) {} \
+    static inline void HAL_GPIO_##name##_pulldown(void) {} \
+    static inline void HAL_GPIO_##name##_pmuxen(int pmux) { (void) pmux; } \
+    static inline void HAL_GPIO_##name##_pmuxdis(void) {} \
+    static inline bool HAL_GPIO_##name##_read(void) { return false; } \
+    static inline int HAL_GPIO_##name##_pin(void) { return 0; }
+
+_HAL_GPIO_STUB(BTN_MODE)
+_HAL_GPIO_STUB(BTN_LIGHT)
+_HAL_GPIO_STUB(BTN_ALARM)
+_HAL_GPIO_STUB(SLCD0) _HAL_GPIO_STUB(SLCD1) _HAL_GPIO_STUB(SLCD2) _HAL_GPIO_STUB(SLCD3) _HAL_GPIO_STUB(SLCD4)
+_HAL_GPIO_STUB(SLCD5) _HAL_GPIO_STUB(SLCD6) _HAL_GPIO_STUB(SLCD7) _HAL_GPIO_STUB(SLCD8) _HAL_GPIO_STUB(SLCD9)
+_HAL_GPIO_STUB(SLCD10) _HAL_GPIO_STUB(SLCD11) _HAL_GPIO_STUB(SLCD12) _HAL_GPIO_STUB(SLCD13) _HAL_GPIO_STUB(SLCD14)
+_HAL_GPIO_STUB(SLCD15) _HAL_GPIO_STUB(SLCD16) _HAL_GPIO_STUB(SLCD17) _HAL_GPIO_STUB(SLCD18) _HAL_GPIO_STUB(SLCD19)
+_HAL_GPIO_STUB(SLCD20) _HAL_GPIO_STUB(SLCD21) _HAL_GPIO_STUB(SLCD22) _HAL_GPIO_STUB(SLCD23) _HAL_GPIO_STUB(SLCD24)
+_HAL_GPIO_STUB(SLCD25) _HAL_GPIO_STUB(SLCD26)
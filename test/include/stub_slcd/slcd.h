@@ -0,0 +1,51 @@
+// Host stand-in for gossamer's SLCD driver and the SLCD registers, for building the watch library's hardware display
+// code in test_display_writes. The display memory is plain RAM the test can read back; everything else does nothing.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    struct { struct { uint32_t ENABLE:1; } bit; } CTRLA;
+    struct { struct { uint16_t LOCK:1; } bit; } CTRLC;
+    struct { struct { uint8_t CSREN:1; } bit; } CTRLD;
+    // SDATAL0, SDATAH0, SDATAL1, SDATAH1...
+    struct { uint32_t reg; } SDATAL0;
+    uint32_t sdata[15];
+} slcd_model_t;
+
+extern slcd_model_t slcd_model;
+#define SLCD (&slcd_model)
+
+#define LCD_PIN_ENABLE (0)
+
+typedef enum { SLCD_BIAS_THIRD } slcd_bias_t;
+typedef enum { SLCD_DUTY_3_COMMON, SLCD_DUTY_4_COMMON } slcd_duty_t;
+typedef enum { SLCD_CLOCKSOURCE_XOSC } slcd_clocksource_t;
+typedef enum { SLCD_PRESCALER_DIV64 } slcd_prescaler_t;
+typedef enum { SLCD_CLOCKDIV_4, SLCD_CLOCKDIV_5 } slcd_clockdiv_t;
+typedef enum { SLCD_CSRSHIFT_LEFT } slcd_csrshift_t;
+
+static inline void slcd_init(uint64_t pins, slcd_bias_t bias, slcd_duty_t duty, slcd_clocksource_t clocksource,
+                             slcd_prescaler_t prescaler, slcd_clockdiv_t clockdiv) {
+    (void) pins; (void) bias; (void) duty; (void) clocksource; (void) prescaler; (void) clockdiv;
+}
+static inline void slcd_clear(void) {
+    slcd_model.SDATAL0.reg = 0;
+    for (int i = 0; i < 15; i++) slcd_model.sdata[i] = 0;
+}
+static inline void slcd_set_contrast(uint8_t contrast) { (void) contrast; }
+static inline void slcd_enable(void) { slcd_model.CTRLA.bit.ENABLE = 1; }
+static inline void slcd_disable(void) { slcd_model.CTRLA.bit.ENABLE = 0; }
+static inline void slcd_set_frame_counter_enabled(uint8_t fc, bool enabled) { (void) fc; (void) enabled; }
+static inline void slcd_configure_frame_counter(uint8_t fc, uint8_t period, bool prescaler_bypass) {
+    (void) fc; (void) period; (void) prescaler_bypass;
+}
+static inline void slcd_set_blink_enabled(bool enabled) { (void) enabled; }
+static inline void slcd_configure_blink(bool blink_all, uint8_t bss0, uint8_t bss1, uint8_t fc) {
+    (void) blink_all; (void) bss0; (void) bss1; (void) fc;
+}
+static inline void slcd_configure_circular_shift_animation(uint8_t initial, uint8_t size, slcd_csrshift_t direction, uint8_t fc) {
+    (void) initial; (void) size; (void) direction; (void) fc;
+}
+static inline void slcd_set_circular_shift_animation_enabled(bool enabled) { slcd_model.CTRLD.bit.CSREN = enabled; }
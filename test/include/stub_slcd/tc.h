@@ -0,0 +1,2 @@
+// Host stand-in for gossamer's TC driver, which the display code includes but doesn't use.
+#pragma once
@@ -0,0 +1,6 @@
+// Host stand-in for gossamer's USB driver: the watch in the test is never plugged in.
+#pragma once
+
+#include <stdbool.h>
+
+static inline bool usb_is_enabled(void) { return false; }
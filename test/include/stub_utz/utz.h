@@ -0,0 +1,2 @@
+// Host stand-in for utz, for tests that include movement.h without needing any time zone code.
+#pragma once
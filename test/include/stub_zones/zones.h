@@ -0,0 +1,8 @@
+// Host stand-in for utz's zone list, for tests that build the watch library without utz: a single zone, UTC. The names
+// are in stub_zones.c.
+#pragma once
+
+extern const char zone_names[];
+
+#define UTZ_UTC (0)
+#define NUM_ZONE_NAMES (1)
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * What the stock watch faces need from Movement, for driving them on the host. Settings are the defaults, time is
+ * UTC with no time zones, and anything that would make a sound, light the LED or change faces does nothing.
+ */
+
+#include <stdlib.h>
+#include "movement.h"
+#include "watch_utility.h"
+#include "prefs.h"
+
+static movement_clock_mode_t clock_mode = MOVEMENT_CLOCK_MODE_12H;
+static watch_buzzer_volume_t button_volume = WATCH_BUZZER_VOLUME_SOFT;
+static watch_buzzer_volume_t signal_volume = WATCH_BUZZER_VOLUME_LOUD;
+static watch_buzzer_volume_t alarm_volume = WATCH_BUZZER_VOLUME_LOUD;
+static bool button_should_sound = true;
+static bool alarm_enabled = false;
+static bool use_imperial_units = false;
+static uint8_t backlight_dwell = 1;
+static uint8_t low_energy_timeout = 1;
+static uint8_t fast_tick_timeout = 0;
+static uint8_t timezone_index = 0;
+
+void *movement_context_alloc(size_t size) { return calloc(1, size); }
+
+bool movement_default_loop_handler(movement_event_t event) {
+    (void) event;
+    return true;
+}
+
+void movement_move_to_face(uint8_t watch_face_index) { (void) watch_face_index; }
+void movement_move_to_next_face(void) {}
+void movement_illuminate_led(void) {}
+void movement_force_led_on(uint8_t red, uint8_t green, uint8_t blue) { (void) red; (void) green; (void) blue; }
+void movement_force_led_off(void) {}
+void movement_play_signal(void) {}
+void movement_play_alarm(void) {}
+bool movement_enable_tap_detection_if_available(void) { return false; }
+bool movement_disable_tap_detection_if_available(void) { return false; }
+void movement_set_wake_intent(uint8_t watch_face_index, movement_wake_intent_t intent) { (void) watch_face_index; (void) intent; }
+void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time) {
+    (void) watch_face_index;
+    (void) date_time;
+}
+void movement_cancel_background_task_for_face(uint8_t watch_face_index) { (void) watch_face_index; }
+void movement_store_settings(void) {}
+
+float movement_get_temperature(void) { return 21.5; }
+
+watch_date_time_t movement_get_utc_date_time(void) {
+    return watch_utility_date_time_from_unix_time(watch_rtc_get_unix_time(), 0);
+}
+watch_date_time_t movement_get_local_date_time(void) { return movement_get_utc_date_time(); }
+watch_date_time_t movement_get_date_time_in_zone(uint8_t zone_index) {
+    (void) zone_index;
+    return movement_get_utc_date_time();
+}
+uint32_t movement_get_utc_timestamp(void) { return watch_rtc_get_unix_time(); }
+void movement_set_utc_timestamp(uint32_t timestamp) { (void) timestamp; }
+void movement_set_utc_date_time(watch_date_time_t date_time) { (void) date_time; }
+void movement_set_local_date_time(watch_date_time_t date_time) { (void) date_time; }
+int32_t movement_get_current_timezone_offset(void) { return 0; }
+int32_t movement_get_current_timezone_offset_for_zone(uint8_t zone_index) {
+    (void) zone_index;
+    return 0;
+}
+int32_t movement_get_timezone_offset_for_date(watch_date_time_t date_time) {
+    (void) date_time;
+    return 0;
+}
+int32_t movement_get_timezone_index(void) { return timezone_index; }
+void movement_set_timezone_index(uint8_t value) { timezone_index = value; }
+
+movement_clock_mode_t movement_clock_mode_24h(void) { return clock_mode; }
+void movement_set_clock_mode_24h(movement_clock_mode_t value) { clock_mode = value; }
+bool movement_button_should_sound(void) { return button_should_sound; }
+void movement_set_button_should_sound(bool value) { button_should_sound = value; }
+watch_buzzer_volume_t movement_button_volume(void) { return button_volume; }
+void movement_set_button_volume(watch_buzzer_volume_t value) { button_volume = value; }
+watch_buzzer_volume_t movement_signal_volume(void) { return signal_volume; }
+void movement_set_signal_volume(watch_buzzer_volume_t value) { signal_volume = value; }
+watch_buzzer_volume_t movement_alarm_volume(void) { return alarm_volume; }
+void movement_set_alarm_volume(watch_buzzer_volume_t value) { alarm_volume = value; }
+bool movement_alarm_enabled(void) { return alarm_enabled; }
+void movement_set_alarm_enabled(bool value) { alarm_enabled = value; }
+bool movement_use_imperial_units(void) { return use_imperial_units; }
+void movement_set_use_imperial_units(bool value) { use_imperial_units = value; }
+uint8_t movement_get_backlight_dwell(void) { return backlight_dwell; }
+void movement_set_backlight_dwell(uint8_t value) { backlight_dwell = value; }
+uint8_t movement_get_low_energy_timeout(void) { return low_energy_timeout; }
+void movement_set_low_energy_timeout(uint8_t value) { low_energy_timeout = value; }
+uint8_t movement_get_fast_tick_timeout(void) { return fast_tick_timeout; }
+void movement_set_fast_tick_timeout(uint8_t value) { fast_tick_timeout = value; }
+movement_color_t movement_backlight_color(void) { return (movement_color_t) { .red = 0, .green = 0xF, .blue = 0 }; }
+
+// no files on the host, so the faces see a watch that has never had a preference set.
+bool prefs_get(const char *key, uint32_t *value) {
+    (void) key;
+    (void) value;
+    return false;
+}
+void prefs_set(const char *key, uint32_t value) {
+    (void) key;
+    (void) value;
+}
+
+void watch_buzzer_play_note_with_volume(watch_buzzer_note_t note, uint16_t duration_ms, watch_buzzer_volume_t volume) {
+    (void) note;
+    (void) duration_ms;
+    (void) volume;
+}
+void watch_enable_leds(void) {}
+void watch_set_led_color_rgb(uint8_t red, uint8_t green, uint8_t blue) { (void) red; (void) green; (void) blue; }
+uint16_t watch_get_vcc_voltage(void) { return 2950; }
@@ -0,0 +1,2 @@
+// Goes with include/stub_zones/zones.h: a zone list with UTC in it and nothing else.
+const char zone_names[] = "UTC\0\0\0\0\0";
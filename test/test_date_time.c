@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Checks watch_utility_date_time_from_unix_time_cached against the full conversion it stands in for, over the
+ * whole range the RTC can hold (2020-2083) and at a spread of UTC offsets.
+ * - Every second of a leap year and of the year after, at UTC, +5:30 and -12:00, which goes through every
+ *   carry the incremental path makes.
+ * - Random forward steps across the whole range: under an hour, which stay on the incremental path, mixed with
+ *   longer jumps, backward jumps and offset changes, which have to fall back to the full conversion.
+ */
+
+#include <stdio.h>
+#include "watch_utility.h"
+#include "test.h"
+
+#define RANGE_START (1577836800) // 2020-01-01 00:00 UTC
+#define RANGE_END (3597436800) // 2083-12-31 00:00 UTC
+#define LEAP_YEAR_START (1704067200) // 2024-01-01 00:00 UTC
+#define TWO_YEARS (731 * 86400)
+
+static const int32_t offsets[] = { 0, 3600, -5 * 3600, 5 * 3600 + 1800, 12 * 3600 + 2700, 14 * 3600, -12 * 3600 };
+#define NUM_OFFSETS (sizeof(offsets) / sizeof(offsets[0]))
+
+static uint32_t rand_state = 1;
+static uint32_t num_checked = 0;
+
+static uint32_t _rand(void) {
+    rand_state = rand_state * 1664525 + 1013904223;
+    return rand_state >> 8;
+}
+
+static void _check(watch_date_time_cache_t *cache, uint32_t timestamp, int32_t offset) {
+    watch_date_time_t expected = watch_utility_date_time_from_unix_time(timestamp, offset);
+    watch_date_time_t actual = watch_utility_date_time_from_unix_time_cached(cache, timestamp, offset);
+    if (actual.reg != expected.reg) {
+        fprintf(stderr, "timestamp %u, offset %d: expected %04d-%02d-%02d %02d:%02d:%02d, got %04d-%02d-%02d %02d:%02d:%02d\n",
+                timestamp, offset,
+                expected.unit.year + WATCH_RTC_REFERENCE_YEAR, expected.unit.month, expected.unit.day,
+                expected.unit.hour, expected.unit.minute, expected.unit.second,
+                actual.unit.year + WATCH_RTC_REFERENCE_YEAR, actual.unit.month, actual.unit.day,
+                actual.unit.hour, actual.unit.minute, actual.unit.second);
+        CHECK(actual.reg == expected.reg);
+    }
+    num_checked++;
+}
+
+int main(void) {
+    for (uint8_t i = 0; i < NUM_OFFSETS; i += 3) {
+        watch_date_time_cache_t cache = {0};
+        for (uint32_t timestamp = LEAP_YEAR_START; timestamp < LEAP_YEAR_START + TWO_YEARS; timestamp++) {
+            _check(&cache, timestamp, offsets[i]);
+        }
+    }
+
+    for (uint8_t i = 0; i < NUM_OFFSETS; i++) {
+        watch_date_time_cache_t cache = {0};
+        // start a day in, so that negative offsets stay within the range too.
+        uint32_t timestamp = RANGE_START + 86400;
+        int32_t offset = offsets[i];
+        while (timestamp < RANGE_END - 86400) {
+            uint32_t choice = _rand() % 100;
+            if (choice < 95) {
+                timestamp += 1 + _rand() % 3599;
+            } else if (choice < 97) {
+                timestamp += 3600 + _rand() % (2 * 86400);
+            } else if (choice < 99) {
+                timestamp -= _rand() % 7200;
+            } else {
+                offset = offsets[_rand() % NUM_OFFSETS];
+            }
+            _check(&cache, timestamp, offset);
+        }
+    }
+
+    printf("    %u conversions checked\n", num_checked);
+
+    TEST_PASSED();
+}
@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Counts what drawing the stock faces costs in SLCD register writes. Each face is activated the way Movement switches
+ * to it and then gets two minutes of simulated ticks, at whatever tick frequency or tick mode it asks for, with the
+ * display committed after every loop call the way app_loop does.
+ *
+ * The display code is the hardware backend, built against a model of the SLCD whose display memory is plain RAM. Each
+ * segment update is counted: before the RAM shadow, every one was a read-modify-write of an SDATA register. The
+ * register writes the shadow makes are checked against the display memory actually changing between commits.
+ *
+ * settings and set_time blink their field with watch_blink_positions, which costs register writes at every phase
+ * change and no segment updates, so for those two the columns don't compare like for like.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "movement.h"
+#include "clock_face.h"
+#include "world_clock_face.h"
+#include "sunrise_sunset_face.h"
+#include "moon_phase_face.h"
+#include "fast_stopwatch_face.h"
+#include "countdown_face.h"
+#include "alarm_face.h"
+#include "temperature_display_face.h"
+#include "voltage_face.h"
+#include "settings_face.h"
+#include "set_time_face.h"
+#include "slcd.h"
+#include "test.h"
+
+#define START (1780272000) // 2026-06-01 00:00 UTC
+#define RTC_FREQUENCY (128)
+#define RUN_SECONDS (120)
+#define NUM_COMS (8)
+
+static const struct {
+    const char *name;
+    watch_face_t face;
+} faces[] = {
+    { "clock", clock_face },
+    { "world_clock", world_clock_face },
+    { "sunrise_sunset", sunrise_sunset_face },
+    { "moon_phase", moon_phase_face },
+    { "fast_stopwatch", fast_stopwatch_face },
+    { "countdown", countdown_face },
+    { "alarm", alarm_face },
+    { "temperature", temperature_display_face },
+    { "voltage", voltage_face },
+    { "settings", settings_face },
+    { "set_time", set_time_face },
+};
+#define NUM_FACES (sizeof(faces) / sizeof(faces[0]))
+
+slcd_model_t slcd_model;
+
+static void *contexts[NUM_FACES];
+static rtc_counter_t counter;
+static watch_rtc_comp_t *comps;
+static uint8_t tick_frequency;
+static movement_tick_mode_t tick_mode;
+
+// the display memory as it was at the last commit, and the write counts then.
+static uint32_t last_sdata[NUM_COMS];
+static uint32_t last_segment_writes;
+static uint32_t last_register_writes;
+
+rtc_counter_t watch_rtc_get_counter(void) { return counter; }
+uint32_t watch_rtc_get_frequency(void) { return RTC_FREQUENCY; }
+unix_timestamp_t watch_rtc_get_unix_time(void) { return START + counter / RTC_FREQUENCY; }
+
+void watch_rtc_register_comp(watch_rtc_comp_t *comp, watch_rtc_comp_cb_t callback, void *context, rtc_counter_t at) {
+    watch_rtc_disable_comp(comp);
+    comp->counter = at;
+    comp->callback = callback;
+    comp->context = context;
+    comp->enabled = true;
+    comp->next = comps;
+    comps = comp;
+}
+
+void watch_rtc_disable_comp(watch_rtc_comp_t *comp) {
+    for (watch_rtc_comp_t **link = &comps; *link; link = &(*link)->next) {
+        if (*link == comp) {
+            *link = comp->next;
+            break;
+        }
+    }
+    comp->enabled = false;
+}
+
+void movement_request_tick_frequency(uint8_t freq) {
+    tick_frequency = freq;
+    tick_mode = MOVEMENT_TICK_MODE_PERIODIC;
+}
+
+void movement_request_tick_mode(movement_tick_mode_t mode) {
+    tick_mode = mode;
+}
+
+static uint32_t _sdata(uint8_t com) {
+    return (&SLCD->SDATAL0.reg)[com * 2];
+}
+
+// fires the RTC comparators that are due, the way the RTC interrupt would.
+static bool _fire_comps(void) {
+    bool fired = false;
+    watch_rtc_comp_t *comp;
+    while ((comp = comps) != NULL) {
+        for (watch_rtc_comp_t *c = comps; c; c = c->next) if ((int32_t)(c->counter - comp->counter) < 0) comp = c;
+        if ((int32_t)(comp->counter - counter) > 0) break;
+        watch_rtc_disable_comp(comp);
+        comp->callback(comp->context);
+        fired = true;
+    }
+    return fired;
+}
+
+static void _commit(void) {
+    uint32_t segment_writes, register_writes;
+
+    watch_display_commit();
+    CHECK(!SLCD->CTRLC.bit.LOCK);
+    watch_display_get_write_counts(&segment_writes, &register_writes);
+
+    // every COM that changed took a write; a COM can change more than once between two of these, but never without one.
+    uint32_t changed = 0;
+    for (uint8_t com = 0; com < NUM_COMS; com++) {
+        if (_sdata(com) != last_sdata[com]) changed++;
+        last_sdata[com] = _sdata(com);
+    }
+    CHECK(changed <= register_writes - last_register_writes);
+    CHECK(register_writes - last_register_writes <= segment_writes - last_segment_writes + NUM_COMS);
+    last_segment_writes = segment_writes;
+    last_register_writes = register_writes;
+
+    // committing again with nothing drawn in between costs nothing.
+    watch_display_commit();
+    watch_display_get_write_counts(&segment_writes, &register_writes);
+    CHECK(register_writes == last_register_writes);
+}
+
+static void _loop(uint8_t index, uint8_t event_type, uint8_t subsecond) {
+    movement_event_t event = { .event_type = event_type, .subsecond = subsecond };
+    faces[index].face.loop(event, contexts[index]);
+    _commit();
+}
+
+static void _run_face(uint8_t index, uint32_t *segment_writes, uint32_t *register_writes) {
+    uint32_t segment_writes_before, register_writes_before;
+    watch_display_get_write_counts(&segment_writes_before, &register_writes_before);
+
+    // what _switch_face does
+    watch_clear_display();
+    movement_request_tick_frequency(1);
+    watch_blink_positions(0, 0);
+    watch_stop_seconds_counter();
+    faces[index].face.activate(contexts[index]);
+    _loop(index, EVENT_ACTIVATE, 0);
+
+    rtc_counter_t end = counter + RUN_SECONDS * RTC_FREQUENCY;
+    while (counter < end) {
+        counter++;
+        if (_fire_comps()) _commit();
+
+        uint8_t subsecond = counter % RTC_FREQUENCY;
+        switch (tick_mode) {
+            case MOVEMENT_TICK_MODE_PERIODIC:
+                if (counter % (RTC_FREQUENCY / tick_frequency) == 0) {
+                    _loop(index, EVENT_TICK, subsecond / (RTC_FREQUENCY / tick_frequency));
+                }
+                break;
+            case MOVEMENT_TICK_MODE_MINUTE:
+                if (counter % (60 * RTC_FREQUENCY) == 0) _loop(index, EVENT_TICK, 0);
+                break;
+            case MOVEMENT_TICK_MODE_NONE:
+                break;
+        }
+    }
+
+    faces[index].face.resign(contexts[index]);
+    watch_stop_sleep_animation();
+
+    watch_display_get_write_counts(segment_writes, register_writes);
+    *segment_writes -= segment_writes_before;
+    *register_writes -= register_writes_before;
+}
+
+int main(void) {
+    uint32_t total_segment_writes = 0;
+    uint32_t total_register_writes = 0;
+
+    watch_enable_display();
+    for (uint8_t i = 0; i < NUM_FACES; i++) faces[i].face.setup(i, &contexts[i]);
+
+    printf("    %-16s %24s %24s\n", "face", "before (segment RMWs)", "after (register writes)");
+    for (uint8_t i = 0; i < NUM_FACES; i++) {
+        uint32_t segment_writes, register_writes;
+        _run_face(i, &segment_writes, &register_writes);
+        printf("    %-16s %24u %24u\n", faces[i].name, segment_writes, register_writes);
+        total_segment_writes += segment_writes;
+        total_register_writes += register_writes;
+    }
+    printf("    %-16s %24u %24u\n", "total", total_segment_writes, total_register_writes);
+    CHECK(total_register_writes < total_segment_writes);
+
+    TEST_PASSED();
+}
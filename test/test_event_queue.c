@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Hammers movement_event_queue from a simulated interrupt that pushes events. It runs between drains, the way
+ * Movement's interrupt callbacks fire while app_loop is busy, and in the middle of drains, from the hook the drain
+ * calls after each event it copies. Where it runs is picked by a seeded generator, so every run is the same, and now
+ * and then enough of them run between two drains to overflow the queue.
+ *
+ * Every push is logged along with what the queue said it did with it, and the events drained are checked against
+ * that log at the end: nothing lost or delivered twice, everything in order, ticks coalesced only into events that
+ * were still waiting, and overflow_count matching the drops. Each drain is also checked against its bound.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "movement_event_queue.h"
+#include "test.h"
+
+#define EVENT_TICK (1)
+#define EVENT_BUTTON (2)
+#define NUM_DRAINS (100000)
+#define MAX_PUSHES (1 << 21)
+#define CANARY (0xA5)
+
+typedef struct {
+    uint8_t event_type;
+    uint8_t result;
+    uint32_t counter;
+} push_log_t;
+
+static volatile movement_event_queue_t queue;
+static push_log_t pushes[MAX_PUSHES];
+static movement_queued_event_t delivered[MAX_PUSHES];
+static movement_queued_event_t expected[MAX_PUSHES];
+static uint32_t num_pushes = 0;
+static uint32_t num_interrupts = 0;
+static uint32_t num_interrupts_in_drain = 0;
+static bool interrupts_enabled = false;
+static uint32_t rand_state = 1;
+
+static uint32_t _rand(void) {
+    rand_state = rand_state * 1103515245 + 12345;
+    return (rand_state >> 16) & 0x7FFF;
+}
+
+// the simulated interrupt: one or more events, like several callbacks of the same priority running back to back.
+static void _interrupt(void) {
+    num_interrupts++;
+
+    uint8_t burst = 1 + _rand() % 6;
+    for (uint8_t i = 0; i < burst && num_pushes < MAX_PUSHES; i++) {
+        uint8_t event_type = _rand() % 2 ? EVENT_TICK : EVENT_BUTTON;
+        uint32_t counter = num_pushes + 1;
+        pushes[num_pushes].event_type = event_type;
+        pushes[num_pushes].counter = counter;
+        pushes[num_pushes].result = movement_event_queue_push(&queue, event_type, counter, event_type == EVENT_TICK);
+        num_pushes++;
+    }
+}
+
+// called by the drain after each event it copies.
+void movement_event_queue_yield(void) {
+    if (interrupts_enabled && _rand() % 4 == 0) {
+        num_interrupts_in_drain++;
+        _interrupt();
+    }
+}
+
+static void _test_single_threaded(void) {
+    movement_queued_event_t events[MOVEMENT_EVENT_QUEUE_MAX_DRAIN];
+
+    movement_event_queue_init(&queue);
+    for (uint32_t i = 0; i < MOVEMENT_EVENT_QUEUE_MAX_DRAIN; i++) {
+        CHECK(movement_event_queue_push(&queue, EVENT_BUTTON, i, false) == MOVEMENT_EVENT_QUEUED);
+    }
+    CHECK(movement_event_queue_push(&queue, EVENT_BUTTON, 99, false) == MOVEMENT_EVENT_DROPPED);
+    CHECK(queue.overflow_count == 1);
+    CHECK(movement_event_queue_drain(&queue, events) == MOVEMENT_EVENT_QUEUE_MAX_DRAIN);
+    for (uint32_t i = 0; i < MOVEMENT_EVENT_QUEUE_MAX_DRAIN; i++) CHECK(events[i].counter == i);
+
+    CHECK(movement_event_queue_push(&queue, EVENT_TICK, 1, true) == MOVEMENT_EVENT_QUEUED);
+    CHECK(movement_event_queue_push(&queue, EVENT_TICK, 2, true) == MOVEMENT_EVENT_COALESCED);
+    CHECK(movement_event_queue_push(&queue, EVENT_BUTTON, 3, false) == MOVEMENT_EVENT_QUEUED);
+    CHECK(movement_event_queue_push(&queue, EVENT_TICK, 4, true) == MOVEMENT_EVENT_QUEUED);
+    CHECK(movement_event_queue_drain(&queue, events) == 3);
+    CHECK(events[0].event_type == EVENT_TICK && events[0].counter == 2);
+    CHECK(events[1].event_type == EVENT_BUTTON && events[1].counter == 3);
+    CHECK(events[2].event_type == EVENT_TICK && events[2].counter == 4);
+
+    // nothing waiting, so a tick can't be coalesced into the one that was just drained.
+    CHECK(movement_event_queue_push(&queue, EVENT_TICK, 5, true) == MOVEMENT_EVENT_QUEUED);
+    CHECK(movement_event_queue_drain(&queue, events) == 1);
+}
+
+static void _test_hammer(void) {
+    // room past the bound, to catch a drain that overruns it.
+    movement_queued_event_t events[MOVEMENT_EVENT_QUEUE_MAX_DRAIN + 8];
+    uint32_t num_delivered = 0;
+
+    movement_event_queue_init(&queue);
+    interrupts_enabled = true;
+
+    for (uint32_t drain = 0; drain < NUM_DRAINS; drain++) {
+        // now and then, take long enough over the events for the queue to fill up.
+        uint32_t interrupts = drain % 128 == 0 ? MOVEMENT_EVENT_QUEUE_SIZE : _rand() % 4;
+        for (uint32_t i = 0; i < interrupts; i++) _interrupt();
+
+        memset(events, CANARY, sizeof(events));
+        uint8_t count = movement_event_queue_drain(&queue, events);
+        CHECK(count <= MOVEMENT_EVENT_QUEUE_MAX_DRAIN);
+        for (size_t i = MOVEMENT_EVENT_QUEUE_MAX_DRAIN * sizeof(movement_queued_event_t); i < sizeof(events); i++) {
+            CHECK(((uint8_t *)events)[i] == CANARY);
+        }
+        CHECK(num_delivered + count <= MAX_PUSHES);
+        memcpy(&delivered[num_delivered], events, count * sizeof(movement_queued_event_t));
+        num_delivered += count;
+        CHECK(num_pushes < MAX_PUSHES - 64 * MOVEMENT_EVENT_QUEUE_SIZE);
+    }
+    interrupts_enabled = false;
+    num_delivered += movement_event_queue_drain(&queue, &delivered[num_delivered]);
+
+    // replay the log to get what should have come out of the queue.
+    uint32_t num_expected = 0;
+    uint32_t num_dropped = 0;
+    uint32_t num_coalesced = 0;
+    for (uint32_t i = 0; i < num_pushes; i++) {
+        switch (pushes[i].result) {
+            case MOVEMENT_EVENT_QUEUED:
+                expected[num_expected].event_type = pushes[i].event_type;
+                expected[num_expected].counter = pushes[i].counter;
+                num_expected++;
+                break;
+            case MOVEMENT_EVENT_COALESCED:
+                // the tick it refreshed must still have been waiting, so it comes out with the new counter.
+                CHECK(num_expected > 0);
+                CHECK(pushes[i].event_type == EVENT_TICK);
+                CHECK(expected[num_expected - 1].event_type == EVENT_TICK);
+                expected[num_expected - 1].counter = pushes[i].counter;
+                num_coalesced++;
+                break;
+            case MOVEMENT_EVENT_DROPPED:
+                num_dropped++;
+                break;
+        }
+    }
+    CHECK(num_expected == num_delivered);
+    for (uint32_t i = 0; i < num_delivered; i++) {
+        CHECK(delivered[i].event_type == expected[i].event_type);
+        CHECK(delivered[i].counter == expected[i].counter);
+    }
+    CHECK(num_dropped == queue.overflow_count);
+    for (uint32_t i = 1; i < num_delivered; i++) CHECK(delivered[i].counter > delivered[i - 1].counter);
+
+    CHECK(num_interrupts_in_drain > 0);
+    CHECK(num_dropped > 0);
+    CHECK(num_coalesced > 0);
+    printf("    %u interrupts (%u during a drain), %u events pushed: %u delivered over %u drains, %u coalesced, %u dropped\n",
+           num_interrupts, num_interrupts_in_drain, num_pushes, num_delivered, NUM_DRAINS, num_coalesced, num_dropped);
+}
+
+int main(void) {
+    _test_single_threaded();
+    _test_hammer();
+    TEST_PASSED();
+}
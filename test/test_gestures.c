@@ -0,0 +1,251 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Drives the gesture recognizer with button events at chosen RTC counters, and checks what it emits and when.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "movement_gestures.h"
+#include "test.h"
+
+#define LIGHT (0)
+#define MODE (1)
+#define ALARM (2)
+
+static movement_gesture_state_t state;
+static movement_gesture_output_t out;
+
+static movement_event_type_t _event(uint8_t button, uint8_t kind) {
+    return EVENT_LIGHT_BUTTON_DOWN + button * 5 + kind;
+}
+
+static void _reset(uint16_t gestures) {
+    movement_gesture_reset(&state);
+    movement_gesture_set_enabled(&state, gestures);
+}
+
+static uint8_t _down(uint8_t button, rtc_counter_t counter) {
+    out.count = 0;
+    movement_gesture_feed(&state, _event(button, 0), counter, &out);
+    return out.count;
+}
+
+// releases the button the way Movement reports it: an up, or a long up once it was held long enough.
+static uint8_t _up(uint8_t button, rtc_counter_t counter) {
+    rtc_counter_t held = counter - state.buttons[button].down_counter;
+    out.count = 0;
+    movement_gesture_feed(&state, _event(button, held < MOVEMENT_LONG_PRESS_TICKS ? 1 : 3), counter, &out);
+    return out.count;
+}
+
+static uint8_t _click(uint8_t button, rtc_counter_t counter) {
+    CHECK(_down(button, counter) == 0);
+    return _up(button, counter + 5);
+}
+
+static uint8_t _expire(rtc_counter_t counter) {
+    out.count = 0;
+    movement_gesture_expire(&state, counter, &out);
+    return out.count;
+}
+
+static void _check_event(uint8_t index, movement_event_type_t event_type, rtc_counter_t counter) {
+    CHECK(index < out.count);
+    CHECK(out.events[index].event_type == event_type);
+    CHECK(out.events[index].counter == counter);
+}
+
+static void _test_double_click(void) {
+    rtc_counter_t deadline;
+
+    _reset(MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK);
+    CHECK(_click(LIGHT, 100) == 0);
+    CHECK(_click(LIGHT, 130) == 1);
+    _check_event(0, EVENT_LIGHT_DOUBLE_CLICK, 135);
+    CHECK(!movement_gesture_get_next_deadline(&state, &deadline));
+
+    // a fourth click starts a new double click, rather than finishing one
+    CHECK(_click(LIGHT, 160) == 0);
+
+    // too slow: the second click starts over
+    _reset(MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK);
+    CHECK(_click(LIGHT, 100) == 0);
+    CHECK(_click(LIGHT, 105 + MOVEMENT_MULTI_CLICK_WINDOW_TICKS + 1) == 0);
+
+    // a long press is not a click
+    _reset(MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK);
+    CHECK(_down(LIGHT, 100) == 0);
+    CHECK(_up(LIGHT, 100 + MOVEMENT_LONG_PRESS_TICKS) == 0);
+    CHECK(_click(LIGHT, 180) == 0);
+    CHECK(_click(LIGHT, 200) == 1);
+
+    // only the buttons that were opted in
+    CHECK(_click(MODE, 300) == 0);
+    CHECK(_click(MODE, 320) == 0);
+}
+
+static void _test_triple_click(void) {
+    rtc_counter_t deadline;
+
+    // the double click is held back until the window for a third click closes
+    _reset(MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK | MOVEMENT_GESTURE_ALARM_TRIPLE_CLICK);
+    CHECK(_click(ALARM, 100) == 0);
+    CHECK(_click(ALARM, 120) == 0);
+    CHECK(movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK(deadline == 125 + MOVEMENT_MULTI_CLICK_WINDOW_TICKS);
+    CHECK(_expire(deadline - 1) == 0);
+    CHECK(_expire(deadline) == 1);
+    _check_event(0, EVENT_ALARM_DOUBLE_CLICK, deadline);
+    CHECK(!movement_gesture_get_next_deadline(&state, &deadline));
+
+    // a third click in time turns it into a triple click, and the double click never comes
+    _reset(MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK | MOVEMENT_GESTURE_ALARM_TRIPLE_CLICK);
+    CHECK(_click(ALARM, 100) == 0);
+    CHECK(_click(ALARM, 120) == 0);
+    CHECK(_down(ALARM, 140) == 0);
+    CHECK(!movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK(_up(ALARM, 145) == 1);
+    _check_event(0, EVENT_ALARM_TRIPLE_CLICK, 145);
+    CHECK(_expire(1000) == 0);
+
+    // a third press that turns into a long press cancels the double click
+    _reset(MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK | MOVEMENT_GESTURE_ALARM_TRIPLE_CLICK);
+    CHECK(_click(ALARM, 100) == 0);
+    CHECK(_click(ALARM, 120) == 0);
+    CHECK(_down(ALARM, 140) == 0);
+    CHECK(_up(ALARM, 140 + MOVEMENT_LONG_PRESS_TICKS) == 0);
+    CHECK(_expire(1000) == 0);
+
+    // turning the gestures off drops the held back double click
+    _reset(MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK | MOVEMENT_GESTURE_ALARM_TRIPLE_CLICK);
+    CHECK(_click(ALARM, 100) == 0);
+    CHECK(_click(ALARM, 120) == 0);
+    movement_gesture_set_enabled(&state, 0);
+    CHECK(!movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK(_expire(1000) == 0);
+}
+
+static void _test_repeat(void) {
+    rtc_counter_t deadline;
+
+    _reset(MOVEMENT_GESTURE_MODE_REPEAT);
+    CHECK(_down(MODE, 100) == 0);
+    CHECK(movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK(deadline == 100 + MOVEMENT_REPEAT_DELAY_TICKS);
+    CHECK(_expire(deadline - 1) == 0);
+    CHECK(_expire(deadline) == 1);
+    _check_event(0, EVENT_MODE_REPEAT, deadline);
+
+    // the repeats speed up from there
+    rtc_counter_t previous = deadline;
+    rtc_counter_t previous_interval = UINT32_MAX;
+    for (uint8_t i = 0; i < 12; i++) {
+        CHECK(movement_gesture_get_next_deadline(&state, &deadline));
+        CHECK(deadline - previous <= previous_interval);
+        CHECK(_expire(deadline) == 1);
+        _check_event(0, EVENT_MODE_REPEAT, deadline);
+        previous_interval = deadline - previous;
+        previous = deadline;
+    }
+    CHECK(previous_interval > 0);
+
+    // waking up late gives one repeat, not a burst of them
+    CHECK(_expire(previous + 1000) == 1);
+    CHECK(movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK((int32_t)(deadline - (previous + 1000)) > 0);
+
+    // letting go stops it, and doesn't count as a click
+    CHECK(_up(MODE, previous + 1001) == 0);
+    CHECK(!movement_gesture_get_next_deadline(&state, &deadline));
+}
+
+static void _test_chord(void) {
+    _reset(MOVEMENT_GESTURE_LIGHT_ALARM_CHORD | MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK | MOVEMENT_GESTURE_ALARM_DOUBLE_CLICK | MOVEMENT_GESTURE_ALARM_REPEAT);
+    CHECK(_down(ALARM, 100) == 0);
+    CHECK(_down(LIGHT, 110) == 1);
+    _check_event(0, EVENT_LIGHT_ALARM_CHORD, 110);
+
+    // neither the repeat nor the clicks that make up the chord count for anything else
+    rtc_counter_t deadline;
+    CHECK(!movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK(_up(LIGHT, 115) == 0);
+    CHECK(_up(ALARM, 118) == 0);
+    CHECK(_click(LIGHT, 130) == 0);
+    CHECK(_click(ALARM, 130) == 0);
+
+    // too far apart to be a chord
+    _reset(MOVEMENT_GESTURE_LIGHT_ALARM_CHORD);
+    CHECK(_down(ALARM, 100) == 0);
+    CHECK(_down(LIGHT, 101 + MOVEMENT_CHORD_WINDOW_TICKS) == 0);
+
+    // only the chords that were opted in
+    _reset(MOVEMENT_GESTURE_LIGHT_ALARM_CHORD);
+    CHECK(_down(MODE, 100) == 0);
+    CHECK(_down(LIGHT, 105) == 0);
+}
+
+static void _test_counter_wraparound(void) {
+    rtc_counter_t start = UINT32_MAX - 20;
+    rtc_counter_t deadline;
+
+    _reset(MOVEMENT_GESTURE_LIGHT_DOUBLE_CLICK | MOVEMENT_GESTURE_LIGHT_TRIPLE_CLICK | MOVEMENT_GESTURE_LIGHT_REPEAT);
+    CHECK(_click(LIGHT, start) == 0);
+    CHECK(_click(LIGHT, start + 15) == 0);
+    CHECK(movement_gesture_get_next_deadline(&state, &deadline));
+    CHECK(deadline == start + 20 + MOVEMENT_MULTI_CLICK_WINDOW_TICKS);
+    CHECK(_expire(deadline - 1) == 0);
+    CHECK(_expire(deadline) == 1);
+    _check_event(0, EVENT_LIGHT_DOUBLE_CLICK, deadline);
+
+    CHECK(_down(LIGHT, start) == 0);
+    CHECK(_expire(start + MOVEMENT_REPEAT_DELAY_TICKS) == 1);
+    _check_event(0, EVENT_LIGHT_REPEAT, start + MOVEMENT_REPEAT_DELAY_TICKS);
+}
+
+static void _test_output_bound(void) {
+    // the most that can come due at once: a button is either up with a double click held back, or down and
+    // repeating, so that's one event per button.
+    _reset(0xFFFF);
+    CHECK(_click(LIGHT, 100) == 0);
+    CHECK(_click(LIGHT, 130) == 0);
+    // far enough apart that these don't make a chord
+    CHECK(_down(MODE, 140) == 0);
+    CHECK(_down(ALARM, 165) == 0);
+    CHECK(_expire(1000) == MOVEMENT_GESTURE_NUM_BUTTONS);
+    // feeding a press can add a chord to those.
+    CHECK(MOVEMENT_GESTURE_NUM_BUTTONS + 1 <= MOVEMENT_GESTURE_MAX_EVENTS);
+}
+
+int main(void) {
+    _test_double_click();
+    _test_triple_click();
+    _test_repeat();
+    _test_chord();
+    _test_counter_wraparound();
+    _test_output_bound();
+
+    TEST_PASSED();
+}
@@ -0,0 +1,199 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Checks the generated glyph tables against the code they replaced: for both LCD types, every position and every
+ * printable character, drawn over a spread of display contents, watch_display_character must leave the display
+ * exactly as the old segment-by-segment version did.
+ */
+
+#include <string.h>
+#include "watch.h"
+#include "watch_common_display.h"
+#include "test.h"
+
+#define NUM_COMS (4)
+#define NUM_STATES (64)
+
+static watch_lcd_type_t _lcd_type;
+static uint32_t _pixels[NUM_COMS];
+
+watch_lcd_type_t watch_get_lcd_type(void) {
+    return _lcd_type;
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    _pixels[com] |= 1UL << seg;
+}
+
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    _pixels[com] &= ~(1UL << seg);
+}
+
+void watch_update_pixels(uint8_t com, uint32_t clear_mask, uint32_t set_mask) {
+    _pixels[com] = (_pixels[com] & ~clear_mask) | set_mask;
+}
+
+// watch_display_character as it was before the glyph tables, unchanged apart from its name.
+static void _reference_display_character(uint8_t character, uint8_t position) {
+    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        if (character == 'R' && position > 1 && position < 8) character = 'r'; // We can't display uppercase R in these positions
+        else if (character == 'T' && position > 1 && position < 8) character = 't'; // lowercase t is the only option for these positions
+    } else {
+        // special cases for positions 4 and 6
+        if (position == 4 || position == 6) {
+            if (character == '7') character = '&'; // "lowercase" 7
+            else if (character == 'A') character = 'a'; // A needs to be lowercase
+            else if (character == 'o') character = 'O'; // O needs to be uppercase
+            else if (character == 'L') character = '!'; // L needs to be in top half
+            else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
+            else if (character == 'c') character = 'C'; // C needs to be uppercase
+            else if (character == 'J') character = 'j'; // same
+            else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
+            else if (character == 't' || character == 'T') character = '+'; // avoid confusion with uppercase E
+        } else {
+            if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
+            else if (character == 'j') character = 'J'; // same but just display a normal J
+            else if (character == '.') character = '_'; // we can use the bottom segment; make dot an underscore
+        }
+        if (position > 1) {
+            if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
+        }
+        if (position == 1) {
+            if (character == 'a') character = 'A'; // A needs to be uppercase
+            else if (character == 'o') character = 'O'; // O needs to be uppercase
+            else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
+            else if (character == 'n') character = 'N'; // N needs to be uppercase
+            else if (character == 'r') character = 'R'; // R needs to be uppercase
+            else if (character == 'd') character = 'D'; // D needs to be uppercase
+            else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
+            else if (character == 'b') character = 'B'; // B needs to be uppercase
+            else if (character == 'c') character = 'C'; // C needs to be uppercase
+        } else {
+            if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
+        }
+        if (position == 0) {
+            watch_clear_pixel(0, 15); // clear funky ninth segment
+        } else {
+            if (character == 'I') character = 'l'; // uppercase I only works in position 0
+        }
+    }
+
+    digit_mapping_t segmap;
+    uint8_t segdata;
+
+    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        segmap = Custom_LCD_Display_Mapping[position];
+        segdata = Custom_LCD_Character_Set[character - 0x20];
+    } else {
+        segmap = Classic_LCD_Display_Mapping[position];
+        segdata = Classic_LCD_Character_Set[character - 0x20];
+    }
+
+    for (int i = 0; i < 8; i++) {
+        if (segmap.segment[i].value == segment_does_not_exist) {
+            // Segment does not exist; skip it.
+            segdata = segdata >> 1;
+            continue;
+        }
+        uint8_t com = segmap.segment[i].address.com;
+        uint8_t seg = segmap.segment[i].address.seg;
+
+        if (segdata & 1) {
+            watch_set_pixel(com, seg);
+        }
+        else {
+            watch_clear_pixel(com, seg);
+        }
+
+        segdata = segdata >> 1;
+    }
+
+    if (character == 'T' && position == 1) watch_set_pixel(1, 12); // add descender
+    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 15); // add funky ninth segment
+    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
+}
+
+// xorshift32, so that every run draws over the same display contents.
+static uint32_t _rand(void) {
+    static uint32_t x = 2463534242UL;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// a blank display, a full one, and random contents in between.
+static void _fill_state(uint32_t state[NUM_COMS], int index) {
+    for (int com = 0; com < NUM_COMS; com++) {
+        if (index == 0) state[com] = 0;
+        else if (index == 1) state[com] = 0xFFFFFFFF;
+        else state[com] = _rand();
+    }
+}
+
+static uint32_t _check_lcd_type(watch_lcd_type_t lcd_type, uint8_t num_positions) {
+    uint32_t cases = 0;
+    uint32_t states[NUM_STATES][NUM_COMS];
+    uint32_t expected[NUM_COMS];
+
+    _lcd_type = lcd_type;
+    _watch_update_indicator_segments();
+
+    for (int index = 0; index < NUM_STATES; index++) _fill_state(states[index], index);
+
+    for (uint8_t position = 0; position < num_positions; position++) {
+        for (uint8_t character = 0x20; character <= 0x7E; character++) {
+            for (int index = 0; index < NUM_STATES; index++) {
+                memcpy(_pixels, states[index], sizeof(_pixels));
+                _reference_display_character(character, position);
+                memcpy(expected, _pixels, sizeof(expected));
+
+                memcpy(_pixels, states[index], sizeof(_pixels));
+                watch_display_character(character, position);
+                if (memcmp(_pixels, expected, sizeof(expected)) != 0) {
+                    fprintf(stderr, "%s LCD, position %d, '%c', state %d: %08x %08x %08x %08x, expected %08x %08x %08x %08x\n",
+                            lcd_type == WATCH_LCD_TYPE_CUSTOM ? "custom" : "classic", position, character, index,
+                            _pixels[0], _pixels[1], _pixels[2], _pixels[3],
+                            expected[0], expected[1], expected[2], expected[3]);
+                }
+                CHECK(memcmp(_pixels, expected, sizeof(expected)) == 0);
+                cases++;
+            }
+        }
+    }
+
+    return cases;
+}
+
+int main(void) {
+    uint32_t cases = 0;
+
+    cases += _check_lcd_type(WATCH_LCD_TYPE_CUSTOM, sizeof(Custom_LCD_Display_Mapping) / sizeof(Custom_LCD_Display_Mapping[0]));
+    cases += _check_lcd_type(WATCH_LCD_TYPE_CLASSIC, sizeof(Classic_LCD_Display_Mapping) / sizeof(Classic_LCD_Display_Mapping[0]));
+    printf("    %u cases checked\n", cases);
+    CHECK(cases == (11 + 10) * 95 * NUM_STATES);
+
+    TEST_PASSED();
+}
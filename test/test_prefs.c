@@ -0,0 +1,220 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Checks the prefs cache against an in-memory stand-in for the filesystem that counts file writes, and compares a
+ * settings session written through prefs with the same session written the way the faces used to: reading the file
+ * back and rewriting it on every change.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "prefs.h"
+#include "filesystem.h"
+#include "test.h"
+
+#define MAX_FILES (16)
+#define MAX_KEYS (4)
+
+typedef struct {
+    char name[16];
+    uint32_t value;
+    bool exists;
+} fake_file_t;
+
+static fake_file_t files[MAX_FILES];
+static uint32_t file_writes;
+static filesystem_change_callback_t change_callback;
+static uint32_t changed_calls;
+
+static fake_file_t *_find(const char *name, bool create) {
+    fake_file_t *free_file = NULL;
+    for (uint8_t i = 0; i < MAX_FILES; i++) {
+        if (files[i].exists && !strcmp(files[i].name, name)) return &files[i];
+        if (free_file == NULL && !files[i].exists) free_file = &files[i];
+    }
+    CHECK(!create || free_file != NULL);
+    if (!create) return NULL;
+    strcpy(free_file->name, name);
+    free_file->exists = true;
+
+    return free_file;
+}
+
+bool filesystem_file_exists(char *filename) {
+    return _find(filename, false) != NULL;
+}
+
+bool filesystem_read_file(char *filename, char *buf, int32_t length) {
+    fake_file_t *f = _find(filename, false);
+    CHECK(length == sizeof(uint32_t));
+    if (f == NULL) return false;
+    memcpy(buf, &f->value, sizeof(uint32_t));
+
+    return true;
+}
+
+bool filesystem_write_file(char *filename, char *text, int32_t length) {
+    CHECK(length == sizeof(uint32_t));
+    memcpy(&_find(filename, true)->value, text, sizeof(uint32_t));
+    file_writes++;
+
+    return true;
+}
+
+void filesystem_set_change_callback(filesystem_change_callback_t callback) {
+    change_callback = callback;
+}
+
+// what the shell does to a file behind the cache's back.
+static void _shell_write(const char *name, uint32_t value) {
+    _find(name, true)->value = value;
+    change_callback(name);
+}
+
+static void _shell_format(void) {
+    memset(files, 0, sizeof(files));
+    change_callback(NULL);
+}
+
+static void _changed(void) {
+    changed_calls++;
+}
+
+static void _test_basics(void) {
+    uint32_t value = 0;
+
+    CHECK(!prefs_get("settings.u32", &value));
+    prefs_set("settings.u32", 1);
+    CHECK(prefs_is_dirty() && changed_calls == 1);
+    CHECK(prefs_get("settings.u32", &value) && value == 1);
+    CHECK(file_writes == 0);
+
+    CHECK(prefs_flush() && !prefs_is_dirty());
+    CHECK(file_writes == 1 && _find("settings.u32", false)->value == 1);
+
+    // setting what the file already holds, or changing a value and back, writes nothing.
+    prefs_set("settings.u32", 1);
+    CHECK(!prefs_is_dirty() && changed_calls == 1);
+    prefs_set("settings.u32", 2);
+    prefs_set("settings.u32", 1);
+    CHECK(!prefs_is_dirty() && changed_calls == 2);
+    CHECK(prefs_flush() && file_writes == 1);
+}
+
+static void _test_reload(void) {
+    uint32_t value = 0;
+
+    // a clean entry picks up what the shell wrote.
+    _shell_write("settings.u32", 7);
+    CHECK(prefs_get("settings.u32", &value) && value == 7);
+
+    // a value that wasn't flushed yet wins over the file, and is still written.
+    prefs_set("settings.u32", 8);
+    _shell_write("settings.u32", 9);
+    CHECK(prefs_is_dirty());
+    CHECK(prefs_get("settings.u32", &value) && value == 8);
+
+    // unless the file now holds it anyway.
+    _shell_write("settings.u32", 8);
+    CHECK(!prefs_is_dirty());
+
+    // after a format, clean values are gone, and unflushed ones are written to the new filesystem.
+    prefs_set("location.u32", 3);
+    _shell_format();
+    CHECK(!prefs_get("settings.u32", &value));
+    CHECK(prefs_get("location.u32", &value) && value == 3);
+    uint32_t writes = file_writes;
+    CHECK(prefs_flush() && file_writes == writes + 1 && _find("location.u32", false)->value == 3);
+}
+
+static void _test_full(void) {
+    uint32_t value = 0;
+    char key[PREFS_MAX_KEY_LENGTH + 1];
+
+    // fill the cache with unflushed values, starting from an empty one.
+    _shell_format();
+    for (uint8_t i = 0; i < MAX_KEYS; i++) {
+        sprintf(key, "full%d.u32", i);
+        prefs_set(key, i);
+    }
+    uint32_t writes = file_writes;
+
+    // a key past the end goes straight to its file, and nothing in the cache is evicted to make room for it.
+    prefs_set("extra.u32", 42);
+    CHECK(file_writes == writes + 1 && _find("extra.u32", false)->value == 42);
+    CHECK(prefs_get("extra.u32", &value) && value == 42);
+    CHECK(prefs_get("full0.u32", &value) && value == 0);
+    CHECK(_find("full0.u32", false) == NULL);
+
+    CHECK(prefs_flush() && file_writes == writes + 1 + MAX_KEYS);
+}
+
+// A session in the settings faces: the same handful of files, changed many times, some of them back and forth.
+#define SESSION_CHANGES (30)
+
+static const char *session_keys[] = { "settings.u32", "location.u32", "wclk_003.u32" };
+
+static uint32_t _session_value(uint8_t i) {
+    // values wrap around, so some changes land back on what the file already holds.
+    return (i * 7) % 5;
+}
+
+static void _test_session(void) {
+    uint32_t before, after;
+
+    _shell_format();
+    file_writes = 0;
+    for (uint8_t i = 0; i < SESSION_CHANGES; i++) {
+        const char *key = session_keys[i % 3];
+        uint32_t value = _session_value(i);
+        fake_file_t *f = _find(key, false);
+        if (f == NULL || f->value != value) filesystem_write_file((char *)key, (char *)&value, sizeof(value));
+    }
+    before = file_writes;
+
+    _shell_format();
+    file_writes = 0;
+    for (uint8_t i = 0; i < SESSION_CHANGES; i++) {
+        prefs_set(session_keys[i % 3], _session_value(i));
+    }
+    CHECK(prefs_flush());
+    after = file_writes;
+
+    CHECK(after <= 3 && after < before);
+    printf("    %d changes to 3 files: %u file writes read-compare-write, %u through prefs\n",
+           SESSION_CHANGES, before, after);
+}
+
+int main(void) {
+    CHECK(prefs_init(MAX_KEYS, _changed));
+    CHECK(change_callback != NULL);
+
+    _test_basics();
+    _test_reload();
+    _test_full();
+    _test_session();
+
+    TEST_PASSED();
+}
@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Checks the background task list against a plain array that is searched for the earliest deadline, the way
+ * Movement used to keep it, over a fixed sequence of schedules, cancels and pops.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "movement_task_list.h"
+#include "test.h"
+
+#define NUM_FACES (40)
+#define NUM_STEPS (200000)
+
+static movement_scheduled_task_t tasks[NUM_FACES];
+static movement_task_list_t list;
+
+// the reference: a deadline per face, and the order it was scheduled in to break ties
+static unix_timestamp_t ref_timestamp[NUM_FACES];
+static uint32_t ref_order[NUM_FACES];
+static uint32_t next_order;
+
+static uint8_t _ref_pop_due(unix_timestamp_t now) {
+    uint8_t found = MOVEMENT_NO_SCHEDULED_TASK;
+    for (uint8_t i = 0; i < NUM_FACES; i++) {
+        if (!ref_order[i] || ref_timestamp[i] > now) continue;
+        if (found == MOVEMENT_NO_SCHEDULED_TASK || ref_timestamp[i] < ref_timestamp[found] ||
+            (ref_timestamp[i] == ref_timestamp[found] && ref_order[i] < ref_order[found])) found = i;
+    }
+    if (found != MOVEMENT_NO_SCHEDULED_TASK) ref_order[found] = 0;
+
+    return found;
+}
+
+static void _check_order(void) {
+    uint8_t count = 0;
+    for (uint8_t i = list.head; i != MOVEMENT_NO_SCHEDULED_TASK; i = tasks[i].next) {
+        CHECK(tasks[i].is_scheduled);
+        if (tasks[i].next != MOVEMENT_NO_SCHEDULED_TASK) CHECK(tasks[i].timestamp <= tasks[tasks[i].next].timestamp);
+        CHECK(++count <= NUM_FACES);
+    }
+    for (uint8_t i = 0; i < NUM_FACES; i++) if (tasks[i].is_scheduled) count--;
+    CHECK(count == 0);
+}
+
+static void _test_basics(void) {
+    unix_timestamp_t deadline;
+
+    movement_task_list_init(&list, tasks, NUM_FACES);
+    CHECK(!movement_task_list_get_next_deadline(&list, &deadline));
+    CHECK(movement_task_list_pop_due(&list, UINT32_MAX) == MOVEMENT_NO_SCHEDULED_TASK);
+
+    movement_task_list_schedule(&list, 3, 300);
+    movement_task_list_schedule(&list, 1, 100);
+    movement_task_list_schedule(&list, 2, 300);
+    movement_task_list_schedule(&list, 0, 200);
+    CHECK(movement_task_list_get_next_deadline(&list, &deadline) && deadline == 100);
+
+    // rescheduling moves the task rather than adding a second one
+    movement_task_list_schedule(&list, 1, 400);
+    CHECK(movement_task_list_get_next_deadline(&list, &deadline) && deadline == 200);
+    _check_order();
+
+    // cancelling one in the middle, and one that isn't scheduled
+    movement_task_list_cancel(&list, 3);
+    movement_task_list_cancel(&list, 3);
+    movement_task_list_cancel(&list, NUM_FACES);
+    _check_order();
+
+    CHECK(movement_task_list_pop_due(&list, 199) == MOVEMENT_NO_SCHEDULED_TASK);
+    CHECK(movement_task_list_pop_due(&list, 200) == 0);
+    CHECK(movement_task_list_pop_due(&list, 1000) == 2);
+    CHECK(movement_task_list_pop_due(&list, 1000) == 1);
+    CHECK(movement_task_list_pop_due(&list, 1000) == MOVEMENT_NO_SCHEDULED_TASK);
+
+    // equal deadlines run in the order they were scheduled
+    movement_task_list_schedule(&list, 5, 500);
+    movement_task_list_schedule(&list, 4, 500);
+    movement_task_list_schedule(&list, 6, 500);
+    CHECK(movement_task_list_pop_due(&list, 500) == 5);
+    CHECK(movement_task_list_pop_due(&list, 500) == 4);
+    CHECK(movement_task_list_pop_due(&list, 500) == 6);
+}
+
+static void _test_against_array(void) {
+    unix_timestamp_t now = 1000;
+    uint32_t pops = 0;
+
+    movement_task_list_init(&list, tasks, NUM_FACES);
+    srand(1);
+    for (uint32_t step = 0; step < NUM_STEPS; step++) {
+        uint8_t face = rand() % NUM_FACES;
+        switch (rand() % 4) {
+            case 0:
+            case 1:
+                // a small spread of deadlines, so that ties are common
+                ref_timestamp[face] = now + rand() % 16;
+                ref_order[face] = ++next_order;
+                movement_task_list_schedule(&list, face, ref_timestamp[face]);
+                break;
+            case 2:
+                ref_order[face] = 0;
+                movement_task_list_cancel(&list, face);
+                break;
+            case 3:
+                now += rand() % 4;
+                uint8_t expected;
+                do {
+                    expected = _ref_pop_due(now);
+                    CHECK(movement_task_list_pop_due(&list, now) == expected);
+                    if (expected != MOVEMENT_NO_SCHEDULED_TASK) pops++;
+                } while (expected != MOVEMENT_NO_SCHEDULED_TASK);
+                break;
+        }
+        if (step % 64 == 0) _check_order();
+    }
+
+    printf("    %u steps, %u tasks run\n", NUM_STEPS, pops);
+}
+
+int main(void) {
+    _test_basics();
+    _test_against_array();
+
+    TEST_PASSED();
+}
@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Walks every zone through 2020-2083 the way Movement's minute handler does, and checks the cached offsets against
+ * the implementation the next-transition cache replaced, which evaluated every zone's rules at every :00 and :30.
+ * Each transition the cache finds is also checked to be on the exact minute the rules change.
+ */
+
+#include <stdio.h>
+#include "movement_tz.h"
+#include "watch_utility.h"
+#include "utz.h"
+#include "zones.h"
+#include "test.h"
+
+#define SWEEP_START (1577836800) // 2020-01-01 00:00 UTC
+#define SWEEP_END (3597436800) // 2083-12-31 00:00 UTC; past that, local dates run off the end of the RTC's years
+#define SWEEP_STEP (30 * 60)
+
+// _movement_update_dst_offset_cache as it was before the cache, for one zone.
+static int32_t _reference_offset(uint8_t zone_index, unix_timestamp_t now) {
+    uzone_t local_zone;
+    unpack_zone(&zone_defns[zone_index], "", &local_zone);
+
+    if (!local_zone.rules_len) return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
+
+    watch_date_time_t system_date_time = watch_utility_date_time_from_unix_time(now, 0);
+    watch_date_time_t date_time = watch_utility_date_time_convert_zone(system_date_time, 0, local_zone.offset.hours * 3600 + local_zone.offset.minutes * 60);
+    udatetime_t udate_time = {
+        .date.dayofmonth = date_time.unit.day,
+        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR), date_time.unit.month, date_time.unit.day),
+        .date.month = date_time.unit.month,
+        .date.year = UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR),
+        .time.hour = date_time.unit.hour,
+        .time.minute = date_time.unit.minute,
+        .time.second = date_time.unit.second
+    };
+    uoffset_t offset;
+    get_current_offset(&local_zone, &udate_time, &offset);
+
+    return (int32_t)((offset.hours * 60 + offset.minutes) / 15) * OFFSET_INCREMENT * 60;
+}
+
+int main(void) {
+    uint32_t num_updates = 0;
+    uint32_t num_transitions = 0;
+    uint32_t num_steps = 0;
+    uint8_t num_dst_zones = 0;
+
+    movement_tz_update(SWEEP_START, true);
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        CHECK(movement_tz_get_current_offset(i) == _reference_offset(i, SWEEP_START));
+        if (movement_tz_observes_dst(i)) num_dst_zones++;
+    }
+
+    for (unix_timestamp_t now = SWEEP_START + SWEEP_STEP; now < SWEEP_END; now += SWEEP_STEP) {
+        num_steps++;
+
+        // the minute handler runs every minute, so each update happens right at the transition that was due.
+        unix_timestamp_t transition;
+        while ((transition = movement_tz_get_next_transition()) <= now) {
+            int32_t before[NUM_ZONE_NAMES];
+            for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) before[i] = movement_tz_get_current_offset(i);
+
+            movement_tz_update(transition, false);
+            num_updates++;
+
+            // the zones that changed did so on the minute the cache said they would.
+            for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+                if (movement_tz_get_current_offset(i) == before[i]) continue;
+                num_transitions++;
+                CHECK(movement_tz_get_offset_from_rules(transition - 60, i) == before[i]);
+                CHECK(movement_tz_get_offset_from_rules(transition, i) == movement_tz_get_current_offset(i));
+            }
+        }
+
+        // the cache has to agree with the old code at every point the old code would have looked.
+        for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+            if (!movement_tz_observes_dst(i)) continue;
+            int32_t offset = movement_tz_get_current_offset(i);
+            if (offset != _reference_offset(i, now)) {
+                fprintf(stderr, "zone %u at %u: cached %d, rules say %d\n", i, now, offset, _reference_offset(i, now));
+                CHECK(offset == _reference_offset(i, now));
+            }
+        }
+    }
+
+    CHECK(num_transitions > 0);
+    printf("    %u zones (%u with DST), %u half hours: %u transitions, found with %u updates\n",
+           NUM_ZONE_NAMES, num_dst_zones, num_steps, num_transitions, num_updates);
+
+    TEST_PASSED();
+}
@@ -0,0 +1,302 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host tool for logs in the deltalog format, built from the encoder and decoder in lib/deltalog. No watch face
+ * writes deltalog yet, so the firmware doesn't build it.
+ *
+ *     deltalog_tool dump FILE BLOCK_SIZE
+ *
+ * decodes a log, whether a littlefs file or a dump of storage rows, and prints it as CSV.
+ * Erased or empty blocks are skipped.
+ *
+ *     deltalog_tool bench
+ *
+ * encodes synthetic week-long traces, checks that they decode back to what went in, and reports:
+ *  - the size of each trace next to the 6-byte records tslog stores 9 to a page, and the 8 bytes per sample of a
+ *    watch_date_time_t and a float, at 64-byte (page) and 256-byte (row) blocks;
+ *  - decode speed on the host, in samples per second over the whole log;
+ *  - how many block headers deltalog_seek reads to find a timestamp, against a linear scan, over random queries.
+ *
+ * The temperature trace is a reading every 5 minutes, in hundredths of a degree, following a daily swing of a few
+ * degrees with a little noise, and one reading in a hundred missed. The activity trace is the number of active
+ * minutes in every 5 minutes: nothing at night, bursts of movement during the day.
+ *
+ * Build from the root of the repository:
+ *
+ *     cc -O2 -Ilib/deltalog utils/deltalog/deltalog_tool.c lib/deltalog/deltalog.c -lm -o deltalog_tool
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "deltalog.h"
+
+#define TRACE_START (1760000000)
+#define TRACE_DAYS (7)
+#define TRACE_INTERVAL (300)
+#define TRACE_MAX_SAMPLES (TRACE_DAYS * 86400 / TRACE_INTERVAL)
+#define NUM_SEEKS (10000)
+#define DECODE_PASSES (200)
+
+typedef struct {
+    uint32_t timestamp;
+    int32_t value;
+} sample_t;
+
+typedef struct {
+    uint8_t *blocks;
+    uint16_t block_size;
+    uint32_t num_blocks;
+    uint32_t header_reads;
+} log_t;
+
+static uint32_t _rand_state = 1;
+
+// a fixed LCG, so that every run measures the same traces.
+static uint32_t _rand(void) {
+    _rand_state = _rand_state * 1103515245 + 12345;
+    return (_rand_state >> 16) & 0x7FFF;
+}
+
+static double _now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t _make_temperature_trace(sample_t *samples) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < TRACE_MAX_SAMPLES; i++) {
+        if (_rand() % 100 == 0) continue;
+        uint32_t timestamp = TRACE_START + i * TRACE_INTERVAL;
+        double day = (double)(timestamp % 86400) / 86400.0;
+        double celsius = 22.0 + 3.0 * sin(2 * M_PI * (day - 0.375)) + (_rand() % 21 - 10) / 100.0;
+        samples[count].timestamp = timestamp;
+        samples[count].value = (int32_t)lround(celsius * 100);
+        count++;
+    }
+    return count;
+}
+
+static uint32_t _make_activity_trace(sample_t *samples) {
+    uint32_t count = 0;
+    uint32_t burst = 0;
+    for (uint32_t i = 0; i < TRACE_MAX_SAMPLES; i++) {
+        uint32_t timestamp = TRACE_START + i * TRACE_INTERVAL;
+        uint32_t hour = (timestamp % 86400) / 3600;
+        int32_t minutes = 0;
+        if (hour >= 7 && hour < 23) {
+            if (burst) {
+                burst--;
+                minutes = 3 + _rand() % 3;
+            } else if (_rand() % 8 == 0) {
+                burst = _rand() % 6;
+                minutes = 1 + _rand() % 5;
+            } else {
+                minutes = _rand() % 3 == 0 ? 1 : 0;
+            }
+        }
+        samples[count].timestamp = timestamp;
+        samples[count].value = minutes;
+        count++;
+    }
+    return count;
+}
+
+static void _encode(log_t *log, const sample_t *samples, uint32_t count, uint16_t block_size) {
+    deltalog_encoder_t encoder;
+
+    log->block_size = block_size;
+    log->num_blocks = 0;
+    log->header_reads = 0;
+    log->blocks = malloc((size_t)block_size * (count + 1));
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (i == 0 || !deltalog_encoder_append(&encoder, samples[i].timestamp, samples[i].value)) {
+            uint8_t *block = log->blocks + (size_t)block_size * log->num_blocks++;
+            // what the storage area erases to, as it would be on the watch.
+            memset(block, 0xFF, block_size);
+            deltalog_encoder_init(&encoder, block, block_size);
+            if (!deltalog_encoder_append(&encoder, samples[i].timestamp, samples[i].value)) {
+                fprintf(stderr, "sample %u doesn't fit in an empty block\n", i);
+                exit(1);
+            }
+        }
+    }
+}
+
+static uint32_t _decode_all(const log_t *log, sample_t *out) {
+    deltalog_decoder_t decoder;
+    uint32_t count = 0;
+    uint32_t timestamp;
+    int32_t value;
+
+    for (uint32_t block = 0; block < log->num_blocks; block++) {
+        if (!deltalog_decoder_init(&decoder, log->blocks + (size_t)log->block_size * block, log->block_size)) continue;
+        while (deltalog_decoder_next(&decoder, &timestamp, &value)) {
+            if (out) {
+                out[count].timestamp = timestamp;
+                out[count].value = value;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+static bool _read_header(uint32_t block_index, uint8_t *header, void *context) {
+    log_t *log = (log_t *)context;
+    log->header_reads++;
+    memcpy(header, log->blocks + (size_t)log->block_size * block_index, DELTALOG_HEADER_SIZE);
+    return true;
+}
+
+// Returns the first sample at or after timestamp, starting from the block deltalog_seek found.
+static bool _find(log_t *log, uint32_t timestamp, sample_t *found) {
+    deltalog_decoder_t decoder;
+    uint32_t sample_timestamp;
+    int32_t value;
+
+    for (uint32_t block = deltalog_seek(log->num_blocks, timestamp, _read_header, log); block < log->num_blocks; block++) {
+        if (!deltalog_decoder_init(&decoder, log->blocks + (size_t)log->block_size * block, log->block_size)) continue;
+        while (deltalog_decoder_next(&decoder, &sample_timestamp, &value)) {
+            if (sample_timestamp >= timestamp) {
+                found->timestamp = sample_timestamp;
+                found->value = value;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void _bench_trace(const char *name, const sample_t *samples, uint32_t count) {
+    static sample_t decoded[TRACE_MAX_SAMPLES];
+    // tslog: a 6-byte header and 9 records of 6 bytes in every 64-byte page.
+    uint32_t tslog_size = (count + 8) / 9 * 64;
+    uint32_t raw_size = count * 8;
+
+    printf("%s: %u samples over %u days\n", name, count, TRACE_DAYS);
+    printf("    %-22s %7u bytes  %5.2f bytes/sample\n", "date_time + float", raw_size, (double)raw_size / count);
+    printf("    %-22s %7u bytes  %5.2f bytes/sample\n", "tslog pages", tslog_size, (double)tslog_size / count);
+
+    const uint16_t block_sizes[] = {64, 256};
+    for (uint8_t i = 0; i < sizeof(block_sizes) / sizeof(block_sizes[0]); i++) {
+        log_t log;
+        _encode(&log, samples, count, block_sizes[i]);
+
+        if (_decode_all(&log, decoded) != count || memcmp(decoded, samples, count * sizeof(sample_t)) != 0) {
+            fprintf(stderr, "%s: %u-byte blocks don't decode back to the trace\n", name, log.block_size);
+            exit(1);
+        }
+
+        uint32_t size = log.num_blocks * log.block_size;
+        char label[32];
+        snprintf(label, sizeof(label), "deltalog %u-byte blocks", log.block_size);
+        printf("    %-22s %7u bytes  %5.2f bytes/sample  %4.1fx smaller than tslog, %u blocks\n",
+               label, size, (double)size / count, (double)tslog_size / size, log.num_blocks);
+
+        double start = _now();
+        uint32_t decoded_count = 0;
+        for (uint32_t pass = 0; pass < DECODE_PASSES; pass++) decoded_count += _decode_all(&log, NULL);
+        double elapsed = _now() - start;
+        printf("        decode: %.1f million samples/s\n", decoded_count / elapsed / 1e6);
+
+        uint32_t span = samples[count - 1].timestamp - samples[0].timestamp;
+        uint32_t max_reads = 0;
+        uint64_t total_reads = 0;
+        _rand_state = 42;
+        for (uint32_t query = 0; query < NUM_SEEKS; query++) {
+            uint32_t timestamp = samples[0].timestamp + (uint32_t)(((uint64_t)_rand() << 15 | _rand()) % (span + 1));
+            sample_t found;
+            log.header_reads = 0;
+            if (!_find(&log, timestamp, &found)) {
+                fprintf(stderr, "%s: nothing found at or after %u\n", name, timestamp);
+                exit(1);
+            }
+            // the first sample at or after the timestamp, by a linear scan of the trace.
+            uint32_t expected = 0;
+            while (samples[expected].timestamp < timestamp) expected++;
+            if (found.timestamp != samples[expected].timestamp || found.value != samples[expected].value) {
+                fprintf(stderr, "%s: seek to %u found the wrong sample\n", name, timestamp);
+                exit(1);
+            }
+            total_reads += log.header_reads;
+            if (log.header_reads > max_reads) max_reads = log.header_reads;
+        }
+        printf("        seek: %.1f header reads on average, %u at most, against %.1f for a linear scan\n",
+               (double)total_reads / NUM_SEEKS, max_reads, (log.num_blocks + 1) / 2.0);
+
+        free(log.blocks);
+    }
+    printf("\n");
+}
+
+static int _bench(void) {
+    static sample_t samples[TRACE_MAX_SAMPLES];
+
+    _rand_state = 1;
+    _bench_trace("temperature", samples, _make_temperature_trace(samples));
+    _rand_state = 2;
+    _bench_trace("activity", samples, _make_activity_trace(samples));
+
+    return 0;
+}
+
+static int _dump(const char *filename, uint16_t block_size) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) {
+        perror(filename);
+        return 1;
+    }
+
+    uint8_t *block = malloc(block_size);
+    deltalog_decoder_t decoder;
+    uint32_t timestamp;
+    int32_t value;
+
+    printf("timestamp,value\n");
+    while (fread(block, 1, block_size, f) == block_size) {
+        if (!deltalog_decoder_init(&decoder, block, block_size)) continue;
+        while (deltalog_decoder_next(&decoder, &timestamp, &value)) printf("%u,%d\n", timestamp, value);
+    }
+
+    free(block);
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 2 && strcmp(argv[1], "bench") == 0) return _bench();
+    if (argc == 4 && strcmp(argv[1], "dump") == 0) {
+        int block_size = atoi(argv[3]);
+        if (block_size >= DELTALOG_HEADER_SIZE && block_size <= 0xFFFF) return _dump(argv[2], block_size);
+    }
+
+    fprintf(stderr, "usage: %s dump FILE BLOCK_SIZE\n       %s bench\n", argv[0], argv[0]);
+    return 1;
+}
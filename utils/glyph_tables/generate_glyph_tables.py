@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""Generates watch_glyph_tables.h.
+
+For every LCD type, position and printable character, the table holds the segments the character sets and clears,
+with the per-position character substitutions already applied, so that watch_display_character comes down to one
+masked update per COM. The character sets and segment mappings are read from watch_common_display.h; the
+substitution rules live here.
+
+The header is not checked in: the Makefile runs this script whenever it or watch_common_display.h changes. Each table
+is wrapped in a guard, so a build with DISPLAY=classic or DISPLAY=custom only carries the table for that display.
+The Makefile passes the output path; run without one, it writes the header next to watch_common_display.h:
+
+    utils/glyph_tables/generate_glyph_tables.py [output]
+"""
+import os
+import re
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+SOURCE = os.path.join(ROOT, 'watch-library', 'shared', 'watch', 'watch_common_display.h')
+OUTPUT = os.path.join(ROOT, 'watch-library', 'shared', 'watch', 'watch_glyph_tables.h')
+
+FIRST_CHAR = 0x20
+LAST_CHAR = 0x7E
+
+
+def parse_character_set(source, name):
+    body = source[source.index(name + '[] ='):]
+    body = body[body.index('{') + 1:body.index('};')]
+    return [int(bits, 2) for bits in re.findall(r'0b([01]{8})', body)]
+
+
+def parse_display_mapping(source, name):
+    body = source[source.index(name + '[] = {'):]
+    body = body[:body.index('\n};')]
+    positions = []
+    for block in re.findall(r'\.segment = \{(.*?)\n        \},', body, re.S):
+        segments = []
+        for line in block.strip().splitlines():
+            match = re.search(r'\.com = (\d+), \.seg = +(\d+)', line)
+            segments.append((int(match.group(1)), int(match.group(2))) if match else None)
+        positions.append(segments)
+    return positions
+
+
+def substitute_custom(char, position):
+    if char == 'R' and 1 < position < 8:
+        return 'r'  # We can't display uppercase R in these positions
+    if char == 'T' and 1 < position < 8:
+        return 't'  # lowercase t is the only option for these positions
+    return char
+
+
+def substitute_classic(char, position):
+    if position in (4, 6):
+        char = {
+            '7': '&',  # "lowercase" 7
+            'A': 'a',  # A needs to be lowercase
+            'o': 'O',  # O needs to be uppercase
+            'L': '!',  # L needs to be in top half
+            'M': 'n', 'm': 'n', 'N': 'n',  # M and uppercase N need to be lowercase n
+            'c': 'C',  # C needs to be uppercase
+            'J': 'j',  # same
+            'v': 'u', 'V': 'u', 'U': 'u', 'W': 'u', 'w': 'u',  # bottom segment duplicated, so show in top half
+            't': '+', 'T': '+',  # avoid confusion with uppercase E
+        }.get(char, char)
+    else:
+        char = {
+            'u': 'v',  # we can use the bottom segment; move to lower half
+            'j': 'J',  # same but just display a normal J
+            '.': '_',  # we can use the bottom segment; make dot an underscore
+        }.get(char, char)
+    if position > 1 and char == 'T':
+        char = 't'  # uppercase T only works in positions 0 and 1
+    if position == 1:
+        char = {
+            'a': 'A',  # A needs to be uppercase
+            'o': 'O',  # O needs to be uppercase
+            'i': 'l',  # I needs to be uppercase (use an l, it looks the same)
+            'n': 'N',  # N needs to be uppercase
+            'r': 'R',  # R needs to be uppercase
+            'd': 'D',  # D needs to be uppercase
+            'v': 'U', 'V': 'U', 'u': 'U',  # side segments shared, make uppercase
+            'b': 'B',  # B needs to be uppercase
+            'c': 'C',  # C needs to be uppercase
+        }.get(char, char)
+    elif char == 'R':
+        char = 'r'  # R needs to be lowercase almost everywhere
+    if position != 0 and char == 'I':
+        char = 'l'  # uppercase I only works in position 0
+    return char
+
+
+def render(is_custom, character_set, mapping, char, position):
+    """Returns the (com, seg, on) writes for a character, in the order they take effect."""
+    char = substitute_custom(char, position) if is_custom else substitute_classic(char, position)
+    writes = []
+    if not is_custom and position == 0:
+        writes.append((0, 15, False))  # clear funky ninth segment
+    segdata = character_set[ord(char) - FIRST_CHAR]
+    for i, segment in enumerate(mapping[position]):
+        if segment is not None:
+            writes.append((segment[0], segment[1], bool(segdata & (1 << i))))
+    if char == 'T' and position == 1:
+        writes.append((1, 12, True))  # add descender
+    elif position == 0 and char in 'BD@':
+        writes.append((0, 15, True))  # add funky ninth segment
+    elif position == 1 and char in 'BD@':
+        writes.append((0, 12, True))  # add funky ninth segment
+    return writes
+
+
+def build(is_custom, character_set, mapping, num_coms):
+    num_positions = len(mapping)
+    touched = [[0] * num_coms for _ in range(num_positions)]
+    sets = []
+    for position in range(num_positions):
+        position_sets = []
+        for code in range(FIRST_CHAR, LAST_CHAR + 1):
+            masks = [0] * num_coms
+            for com, seg, on in render(is_custom, character_set, mapping, chr(code), position):
+                touched[position][com] |= 1 << seg
+                if on:
+                    masks[com] |= 1 << seg
+                else:
+                    masks[com] &= ~(1 << seg)
+            position_sets.append(masks)
+        sets.append(position_sets)
+
+    # Segments that are only ever set (the ninth segments and the descender) stay out of the clear mask, since the
+    # character that doesn't use them never touched them either.
+    clears = [[0] * num_coms for _ in range(num_positions)]
+    for position in range(num_positions):
+        for com in range(num_coms):
+            for segment in mapping[position]:
+                if segment is not None and segment[0] == com:
+                    clears[position][com] |= 1 << segment[1]
+    if not is_custom:
+        clears[0][0] |= 1 << 15
+
+    shifts = [[0] * num_coms for _ in range(num_positions)]
+    for position in range(num_positions):
+        for com in range(num_coms):
+            mask = touched[position][com]
+            if mask == 0:
+                continue
+            shift = (mask & -mask).bit_length() - 1
+            if (mask >> shift) > 0xFFFF:
+                sys.exit(f'position {position}, COM {com}: segments span more than 16 bits')
+            shifts[position][com] = shift
+
+    return shifts, clears, sets
+
+
+def emit_table(out, prefix, shifts, clears, sets, num_coms):
+    num_positions = len(shifts)
+    out.append(f'static const uint8_t {prefix}_Glyph_Shifts[{num_positions}][{num_coms}] = {{')
+    for position in range(num_positions):
+        out.append('    { ' + ', '.join(f'{s:2d}' for s in shifts[position]) + f' }}, // {position}')
+    out.append('};')
+    out.append('')
+    out.append(f'static const uint16_t {prefix}_Glyph_Clear_Masks[{num_positions}][{num_coms}] = {{')
+    for position in range(num_positions):
+        masks = [clears[position][com] >> shifts[position][com] for com in range(num_coms)]
+        out.append('    { ' + ', '.join(f'0x{m:04x}' for m in masks) + f' }}, // {position}')
+    out.append('};')
+    out.append('')
+    num_chars = LAST_CHAR - FIRST_CHAR + 1
+    out.append(f'static const uint16_t {prefix}_Glyph_Set_Masks[{num_positions}][{num_chars}][{num_coms}] = {{')
+    for position in range(num_positions):
+        out.append('    {')
+        for index, masks in enumerate(sets[position]):
+            relative = [masks[com] >> shifts[position][com] for com in range(num_coms)]
+            char = chr(FIRST_CHAR + index)
+            label = {' ': '[space]', '\\': '[backslash]'}.get(char, char)  # a trailing backslash would continue the comment
+            out.append('        { ' + ', '.join(f'0x{m:04x}' for m in relative) + f' }}, // {position} {label}')
+        out.append('    },')
+    out.append('};')
+    out.append('')
+    out.append(f'static const watch_glyph_table_t {prefix}_Glyph_Table = {{')
+    out.append(f'    .num_positions = {num_positions},')
+    out.append(f'    .num_coms = {num_coms},')
+    out.append(f'    .shifts = &{prefix}_Glyph_Shifts[0][0],')
+    out.append(f'    .clear_masks = &{prefix}_Glyph_Clear_Masks[0][0],')
+    out.append(f'    .set_masks = &{prefix}_Glyph_Set_Masks[0][0][0],')
+    out.append('};')
+    out.append('')
+
+
+def main():
+    with open(SOURCE) as f:
+        source = f.read()
+
+    out = [
+        '// Generated by utils/glyph_tables/generate_glyph_tables.py from watch_common_display.h. Do not edit.',
+        '',
+        '#pragma once',
+        '',
+        '#include "watch_common_display.h"',
+        '',
+    ]
+    tables = (
+        ('Custom_LCD', True, 4, 'FORCE_CLASSIC_LCD_TYPE'),
+        ('Classic_LCD', False, 3, 'FORCE_CUSTOM_LCD_TYPE'),
+    )
+    for prefix, is_custom, num_coms, excluded_by in tables:
+        character_set = parse_character_set(source, prefix + '_Character_Set')
+        mapping = parse_display_mapping(source, prefix + '_Display_Mapping')
+        if len(character_set) != LAST_CHAR - FIRST_CHAR + 1:
+            sys.exit(f'{prefix}_Character_Set: expected {LAST_CHAR - FIRST_CHAR + 1} characters')
+        out.append(f'// {prefix}: {len(mapping)} positions, {num_coms} COMs')
+        out.append('')
+        out.append(f'#if !defined({excluded_by})')
+        out.append('')
+        emit_table(out, prefix, *build(is_custom, character_set, mapping, num_coms), num_coms)
+        out.append(f'#endif // !defined({excluded_by})')
+        out.append('')
+
+    output = sys.argv[1] if len(sys.argv) > 1 else OUTPUT
+    with open(output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Decodes the output of the `wakelog` shell command.
+
+Paste the dump (from "=== WAKELOG" to "=== END ===") into a file, or pipe it in:
+
+    decode_wakelog.py dump.txt
+    pbpaste | decode_wakelog.py
+
+Prints a histogram of wake causes, followed by a timeline with the time between wakes.
+"""
+import sys
+from collections import Counter
+
+RTC_PER_NAMES = {1 << i: f'{128 >> i} Hz' for i in range(8)}
+CMP_SLOT_NAMES = {0xFF: 'timer'}
+
+
+def describe(cause, detail):
+    if cause == 'per':
+        return 'tick ' + ', '.join(name for bit, name in RTC_PER_NAMES.items() if detail & bit)
+    if cause == 'cmp':
+        return 'comp ' + CMP_SLOT_NAMES.get(detail, f'slot {detail}')
+    if cause == 'tamper':
+        return f'extwake TAMPID {detail:#04x}'
+    if cause == 'eic':
+        return f'EIC channel {detail}'
+    if cause == 'reset':
+        return f'reset RCAUSE {detail:#04x}'
+    return cause
+
+
+def parse(lines):
+    freq = 128
+    entries = []
+    for line in lines:
+        line = line.strip()
+        if line.startswith('=== WAKELOG'):
+            freq = int(line.split()[3])
+            entries = []
+        elif line.startswith('=== END'):
+            break
+        elif line:
+            fields = line.split()
+            if len(fields) != 4:
+                continue
+            entries.append((int(fields[0]), int(fields[1]), fields[2], int(fields[3])))
+    return freq, entries
+
+
+def main():
+    if not sys.stdin.isatty():
+        input_stream = sys.stdin
+    else:
+        try:
+            input_stream = open(sys.argv[1], 'r')
+        except IndexError:
+            raise IndexError('need filename as first argument if stdin is not full')
+
+    freq, entries = parse(input_stream)
+    if not entries:
+        print('no entries')
+        return
+
+    histogram = Counter(describe(cause, detail) for _, _, cause, detail in entries)
+    span = ((entries[-1][1] - entries[0][1]) & 0xFFFFFFFF) / freq
+    print(f'{len(entries)} entries over {span:.1f} s')
+    print()
+    width = max(len(name) for name in histogram)
+    for name, count in histogram.most_common():
+        rate = f'{count * 3600 / span:8.1f}/h' if span > 0 else ''
+        print(f'{name:<{width}} {count:6} {rate}')
+
+    print()
+    previous = None
+    for sequence, counter, cause, detail in entries:
+        if previous is None:
+            delta = ''
+        else:
+            if (sequence - previous[0]) & 0xFFFF != 1:
+                print('    ... entries lost')
+            delta = f'+{((counter - previous[1]) & 0xFFFFFFFF) / freq:.3f} s'
+        print(f'{sequence:5} {counter / freq:12.3f} {delta:>14}  {describe(cause, detail)}')
+        previous = (sequence, counter)
+
+
+if __name__ == '__main__':
+    main()
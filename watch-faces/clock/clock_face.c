@@ -105,9 +105,16 @@ static void clock_check_battery_periodically(clock_state_t *state, watch_date_ti
     clock_indicate_low_available_power(state);
 }
 
+static void clock_update_wake_intent(clock_state_t *state) {
+    // the time signal only ever chimes at the top of the hour
+    movement_wake_intent_t intent = { .type = state->time_signal_enabled ? MOVEMENT_WAKE_TOP_OF_HOUR : MOVEMENT_WAKE_NEVER };
+    movement_set_wake_intent(state->watch_face_index, intent);
+}
+
 static void clock_toggle_time_signal(clock_state_t *state) {
     state->time_signal_enabled = !state->time_signal_enabled;
     clock_indicate_time_signal(state);
+    clock_update_wake_intent(state);
 }
 
 static void clock_display_all(watch_date_time_t date_time) {
@@ -210,11 +217,13 @@ void clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(clock_state_t));
+        *context_ptr = movement_context_alloc(sizeof(clock_state_t));
         clock_state_t *state = (clock_state_t *) *context_ptr;
         state->time_signal_enabled = false;
         state->watch_face_index = watch_face_index;
     }
+
+    clock_update_wake_intent((clock_state_t *) *context_ptr);
 }
 
 void clock_face_activate(void *context) {
@@ -230,6 +239,10 @@ void clock_face_activate(void *context) {
 
     // this ensures that none of the timestamp fields will match, so we can re-render them all.
     state->date_time.previous.reg = 0xFFFFFFFF;
+
+    // the display library keeps the seconds ticking, so we only need to redraw when the minute changes.
+    watch_start_seconds_counter();
+    movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
 }
 
 bool clock_face_loop(movement_event_t event, void *context) {
@@ -77,7 +77,7 @@ static void clock_indicate(watch_indicator_t indicator, bool on) {
 void close_enough_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(close_enough_state_t));
+        *context_ptr = movement_context_alloc(sizeof(close_enough_state_t));
         memset(*context_ptr, 0, sizeof(close_enough_state_t));
     }
 }
@@ -93,6 +93,9 @@ void close_enough_face_activate(void *context) {
     // this ensures that none of the five_minute_periods will match, so we always rerender when the face activates
     state->prev_five_minute_period = -1;
     state->prev_min_checked = -1;
+
+    // nothing on this face changes more often than once a minute.
+    movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
 }
 
 static void clock_check_battery_periodically(close_enough_state_t *state) {
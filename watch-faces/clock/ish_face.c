@@ -128,7 +128,7 @@ static void ish_face_stop_tick_tock_animation(void) {
 void ish_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(ish_face_state_t));
+        *context_ptr = movement_context_alloc(sizeof(ish_face_state_t));
         memset(*context_ptr, 0, sizeof(ish_face_state_t));
         ish_face_state_t *state = (ish_face_state_t *)*context_ptr;
         state->vagueness_level = 1; // Default to level 1 on initial load
@@ -59,11 +59,10 @@ static void _display_time(ke_decimal_time_state_t *state, watch_date_time_t date
 void ke_decimal_time_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(ke_decimal_time_state_t));
+        *context_ptr = movement_context_alloc(sizeof(ke_decimal_time_state_t));
         memset(*context_ptr, 0, sizeof(ke_decimal_time_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
-    // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
 void ke_decimal_time_face_activate(void *context) {
@@ -31,7 +31,7 @@
 #include "solar_time_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "filesystem.h"
+#include "prefs.h"
 
 #if __EMSCRIPTEN__
 #include <emscripten.h>
@@ -57,7 +57,7 @@
 
 static movement_location_t _load_location(void) {
     movement_location_t loc = {0};
-    filesystem_read_file("location.u32", (char *)&loc.reg, sizeof(loc.reg));
+    prefs_get("location.u32", &loc.reg);
     return loc;
 }
 
@@ -158,7 +158,7 @@ static void _update_display(solar_time_state_t *state, watch_date_time_t dt) {
 void solar_time_face_setup(uint8_t watch_face_index, void **context_ptr) {
     (void)watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(solar_time_state_t));
+        *context_ptr = movement_context_alloc(sizeof(solar_time_state_t));
         memset(*context_ptr, 0, sizeof(solar_time_state_t));
         /* last_calc_d == 0 guarantees recomputation on first tick */
     }
@@ -174,11 +174,11 @@ void solar_time_face_activate(void *context) {
     int16_t browser_lon = EM_ASM_INT({ return lon; });
     if (browser_lat || browser_lon) {
         movement_location_t browser_loc = {0};
-        filesystem_read_file("location.u32", (char *)&browser_loc.reg, sizeof(browser_loc.reg));
+        prefs_get("location.u32", &browser_loc.reg);
         if (browser_loc.reg == 0) {
             browser_loc.bit.latitude  = browser_lat;
             browser_loc.bit.longitude = browser_lon;
-            filesystem_write_file("location.u32", (char *)&browser_loc.reg, sizeof(browser_loc.reg));
+            prefs_set("location.u32", browser_loc.reg);
         }
     }
 #endif
@@ -28,22 +28,17 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_common_display.h"
-#include "filesystem.h"
+#include "prefs.h"
 #include "zones.h"
 
 static int world_clock_instances;
 
 static void persist_world_clock_settings(world_clock_state_t *state) {
-    world_clock_settings_t maybe_settings;
     char filename[13];
 
-    maybe_settings.reg = 0xFFFFFFFF;
     sprintf(filename, "wclk_%03d.u32", state->clock_index);
 
-    filesystem_read_file(filename, (char *) &maybe_settings.reg, sizeof(world_clock_settings_t));
-    if (state->settings.reg != maybe_settings.reg) {
-        filesystem_write_file(filename, (char *) &state->settings.reg, sizeof(world_clock_settings_t));
-    }
+    prefs_set(filename, state->settings.reg);
 }
 
 static void advance_character_at_position(char *character, uint8_t position) {
@@ -127,7 +122,7 @@ static void _update_timezone_offset(world_clock_state_t *state) {
 void world_clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(world_clock_state_t));
+        *context_ptr = movement_context_alloc(sizeof(world_clock_state_t));
         memset(*context_ptr, 0, sizeof(world_clock_state_t));
         world_clock_state_t *state = (world_clock_state_t *)*context_ptr;
         state->clock_index = world_clock_instances++;
@@ -135,9 +130,7 @@ void world_clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         // load settings from file if it exists
         char filename[13];
         sprintf(filename, "wclk_%03d.u32", state->clock_index);
-        if (filesystem_file_exists(filename)) {
-            filesystem_read_file(filename, (char *) &state->settings.reg, sizeof(world_clock_settings_t));
-        } else {
+        if (!prefs_get(filename, &state->settings.reg)) {
             // otherwise make all characters blank by default, and set to UTC time
             state->settings.bit.char_0 = ' ';
             state->settings.bit.char_1 = ' ';
@@ -221,7 +214,6 @@ static bool world_clock_face_do_display_mode(movement_event_t event, world_clock
             }
             break;
         case EVENT_ALARM_LONG_PRESS:
-            movement_request_tick_frequency(4);
             state->current_screen = 1;
             break;
         default:
@@ -243,7 +235,7 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, world_clo
             state->current_screen++;
             is_custom_lcd = watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM;
             if ((is_custom_lcd && state->current_screen > 4) || (!is_custom_lcd && state->current_screen > 3)) {
-                movement_request_tick_frequency(1);
+                watch_blink_positions(0, 0);
                 _update_timezone_offset(state);
                 state->current_screen = 0;
                 persist_world_clock_settings(state);
@@ -288,27 +280,27 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, world_clo
         watch_utility_time_zone_name_at_index(state->settings.bit.timezone_index),
         state->settings.bit.char_2);
     watch_clear_indicator(WATCH_INDICATOR_PM);
+    watch_display_text(WATCH_POSITION_FULL, buf);
 
     // blink up the parameter we're setting
-    if (event.subsecond % 2) {
-        switch (state->current_screen) {
-            case 1:
-            case 2:
-                buf[state->current_screen - 1] = '_';
-                break;
-            case 3:
-                if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-                    buf[10] = '_';
-                    break;
-                }
-                // fall through
-            case 4:
-                memcpy(buf + 4, "      ", 6);
+    uint16_t positions = 0;
+    switch (state->current_screen) {
+        case 1:
+        case 2:
+            positions = 1 << (state->current_screen - 1);
+            break;
+        case 3:
+            if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+                positions = 1 << 10;
                 break;
-        }
+            }
+            // fall through
+        case 4:
+            positions = WATCH_BLINK_BOTTOM;
+            break;
     }
-
-    watch_display_text(WATCH_POSITION_FULL, buf);
+    watch_blink_positions(positions, 500);
+    if (event.event_type == EVENT_ALARM_BUTTON_DOWN) watch_restart_blink_positions();
 
     return true;
 }
@@ -71,7 +71,7 @@ static void _alarm_show_alarm_on_text(alarm_state_t *state) {
     watch_display_text(WATCH_POSITION_SECONDS, state->alarm[state->alarm_idx].enabled ? "on" : "--");
 }
 
-static void _advanced_alarm_face_draw(alarm_state_t *state, uint8_t subsecond) {
+static void _advanced_alarm_face_draw(alarm_state_t *state) {
     char buf[12];
     bool set_leading_zero = movement_clock_mode_24h() == MOVEMENT_CLOCK_MODE_024H;
 
@@ -94,70 +94,75 @@ static void _advanced_alarm_face_draw(alarm_state_t *state, uint8_t subsecond) {
         watch_set_indicator(WATCH_INDICATOR_24H);
     }
 
-    // blink items if in settings mode
-    bool blinking = state->is_setting && subsecond % 2 && state->setting_state < alarm_setting_idx_pitch && !state->alarm_quick_ticks;
-    if (state->setting_state == alarm_setting_idx_alarm && blinking) {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
-    } else {
-        sprintf(buf, "%2d", (state->alarm_idx + 1));
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-    }
-    if (state->setting_state == alarm_setting_idx_day && blinking) {
-        watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "   ", "  ");
-    } else {
-        watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, _dow_strings_custom[i], _dow_strings_classic[i]);
-    }
-    if (state->setting_state == alarm_setting_idx_hour && blinking) {
-        watch_display_text(WATCH_POSITION_HOURS, "  ");
-    } else {
-        sprintf(buf, set_leading_zero? "%02d" : "%2d", h);
-        watch_display_text(WATCH_POSITION_HOURS, buf);
-    }
-    if (state->setting_state == alarm_setting_idx_minute && blinking) {
-        watch_display_text(WATCH_POSITION_MINUTES, "  ");
-    } else {
-        sprintf(buf, "%02d", state->alarm[state->alarm_idx].minute);
-        watch_display_text(WATCH_POSITION_MINUTES, buf);
-    }
+    sprintf(buf, "%2d", (state->alarm_idx + 1));
+    watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+    watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, _dow_strings_custom[i], _dow_strings_classic[i]);
+    sprintf(buf, set_leading_zero? "%02d" : "%2d", h);
+    watch_display_text(WATCH_POSITION_HOURS, buf);
+    sprintf(buf, "%02d", state->alarm[state->alarm_idx].minute);
+    watch_display_text(WATCH_POSITION_MINUTES, buf);
 
     if (state->is_setting) {
         watch_display_text(WATCH_POSITION_SECONDS, "  ");
-    // draw pitch level indicator
-        if ((subsecond % 2) == 0 || (state->setting_state != alarm_setting_idx_pitch)) {
+        // draw pitch level indicator
         for (i = 0; i <= state->alarm[state->alarm_idx].pitch && i < 3; i++)
             watch_set_pixel(_buzzer_segdata[i][0], _buzzer_segdata[i][1]);
-        }
         // draw beep rounds indicator
-        if ((subsecond % 2) == 0 || (state->setting_state != alarm_setting_idx_beeps)) {
-            if (state->alarm[state->alarm_idx].beeps == ALARM_MAX_BEEP_ROUNDS - 1)
-                watch_display_character('L', _beeps_blink_idx);
-            else {
-                if (state->alarm[state->alarm_idx].beeps == 0)
-                    watch_display_character('o', _beeps_blink_idx);
-                else
-                    watch_display_character(state->alarm[state->alarm_idx].beeps + 48, _beeps_blink_idx);
-            }
+        if (state->alarm[state->alarm_idx].beeps == ALARM_MAX_BEEP_ROUNDS - 1)
+            watch_display_character('L', _beeps_blink_idx);
+        else {
+            if (state->alarm[state->alarm_idx].beeps == 0)
+                watch_display_character('o', _beeps_blink_idx);
+            else
+                watch_display_character(state->alarm[state->alarm_idx].beeps + 48, _beeps_blink_idx);
         }
     }
     else {
         _alarm_show_alarm_on_text(state);
     }
 
+    // blink items if in settings mode; hour and minute hold steady while they're cycling fast
+    uint16_t positions = 0;
+    if (state->is_setting) {
+        switch (state->setting_state) {
+            case alarm_setting_idx_alarm:
+                positions = WATCH_BLINK_TOP_RIGHT;
+                break;
+            case alarm_setting_idx_day:
+                positions = WATCH_BLINK_TOP_LEFT;
+                break;
+            case alarm_setting_idx_hour:
+                if (!state->alarm_quick_ticks) positions = WATCH_BLINK_HOURS;
+                break;
+            case alarm_setting_idx_minute:
+                if (!state->alarm_quick_ticks) positions = WATCH_BLINK_MINUTES;
+                break;
+            case alarm_setting_idx_pitch:
+                // the pitch level segments all belong to position 8
+                positions = 1 << 8;
+                break;
+            case alarm_setting_idx_beeps:
+                positions = 1 << _beeps_blink_idx;
+                break;
+            default:
+                break;
+        }
+    }
+    watch_blink_positions(positions, 500);
+
     // set alarm indicator
     _alarm_set_signal(state);
 }
 
-static void _alarm_initiate_setting(alarm_state_t *state, uint8_t subsecond) {
+static void _alarm_initiate_setting(alarm_state_t *state) {
     state->is_setting = true;
     state->setting_state = 0;
-    movement_request_tick_frequency(4);
-    _advanced_alarm_face_draw(state, subsecond);
+    _advanced_alarm_face_draw(state);
 }
 
-static void _alarm_resume_setting(alarm_state_t *state, uint8_t subsecond) {
+static void _alarm_resume_setting(alarm_state_t *state) {
     state->is_setting = false;
-    movement_request_tick_frequency(1);
-    _advanced_alarm_face_draw(state, subsecond);
+    _advanced_alarm_face_draw(state);
 }
 
 static void _alarm_update_alarm_enabled(alarm_state_t *state) {
@@ -230,7 +235,7 @@ static void _abort_quick_ticks(alarm_state_t *state) {
     if (state->alarm_quick_ticks) {
         state->alarm[state->alarm_idx].enabled = true;
         state->alarm_quick_ticks = false;
-        movement_request_tick_frequency(4);
+        movement_request_tick_frequency(1);
     }
 }
 
@@ -238,7 +243,7 @@ void advanced_alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(alarm_state_t));
+        *context_ptr = movement_context_alloc(sizeof(alarm_state_t));
         alarm_state_t *state = (alarm_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(alarm_state_t));
         // initialize the default alarm values
@@ -334,6 +339,7 @@ bool advanced_alarm_face_loop(movement_event_t event, void *context) {
                     state->alarm[state->alarm_idx].enabled ^= 1;
                     _alarm_set_signal(state);
                     _alarm_show_alarm_on_text(state);
+                    watch_display_commit();
                     delay_ms(275);
                     state->alarm_idx = 0;
                 }
@@ -341,25 +347,27 @@ bool advanced_alarm_face_loop(movement_event_t event, void *context) {
         }
         // fall through
     case EVENT_ACTIVATE:
-        _advanced_alarm_face_draw(state, event.subsecond);
+        _advanced_alarm_face_draw(state);
         break;
     case EVENT_LIGHT_BUTTON_UP:
         if (!state->is_setting) {
             movement_illuminate_led();
-            _alarm_initiate_setting(state, event.subsecond);
+            _alarm_initiate_setting(state);
             break;
         }
         state->setting_state += 1;
         if (state->setting_state >= ALARM_SETTING_STATES) {
             // we have done a full settings cycle, so resume to normal
-            _alarm_resume_setting(state, event.subsecond);
+            _alarm_resume_setting(state);
+        } else {
+            _advanced_alarm_face_draw(state);
         }
         break;
     case EVENT_LIGHT_LONG_PRESS:
         if (state->is_setting) {
-            _alarm_resume_setting(state, event.subsecond);
+            _alarm_resume_setting(state);
         } else {
-            _alarm_initiate_setting(state, event.subsecond);
+            _alarm_initiate_setting(state);
         }
         break;
     case EVENT_ALARM_BUTTON_UP:
@@ -407,7 +415,7 @@ bool advanced_alarm_face_loop(movement_event_t event, void *context) {
             // auto enable an alarm if user sets anything
             if (state->setting_state > alarm_setting_idx_alarm) state->alarm[state->alarm_idx].enabled = true;
         }
-        _advanced_alarm_face_draw(state, event.subsecond);
+        _advanced_alarm_face_draw(state);
         break;
     case EVENT_ALARM_LONG_PRESS:
         if (!state->is_setting) {
@@ -432,12 +440,14 @@ bool advanced_alarm_face_loop(movement_event_t event, void *context) {
                 break;
             }
         }
-        _advanced_alarm_face_draw(state, event.subsecond);
+        _advanced_alarm_face_draw(state);
         break;
     case EVENT_ALARM_LONG_UP:
         if (state->is_setting) {
-            if (state->setting_state == alarm_setting_idx_hour || state->setting_state == alarm_setting_idx_minute)
+            if (state->setting_state == alarm_setting_idx_hour || state->setting_state == alarm_setting_idx_minute) {
                 _abort_quick_ticks(state);
+                _advanced_alarm_face_draw(state);
+            }
         } else _wait_ticks = -1;
         break;
     case EVENT_BACKGROUND_TASK:
@@ -63,7 +63,7 @@ void alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(alarm_face_state_t));
+        *context_ptr = movement_context_alloc(sizeof(alarm_face_state_t));
         alarm_face_state_t *state = (alarm_face_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(alarm_face_state_t));
 
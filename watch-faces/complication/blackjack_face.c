@@ -396,7 +396,7 @@ void blackjack_face_setup(uint8_t watch_face_index, void **context_ptr) {
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(blackjack_face_state_t));
+        *context_ptr = movement_context_alloc(sizeof(blackjack_face_state_t));
         memset(*context_ptr, 0, sizeof(blackjack_face_state_t));
         blackjack_face_state_t *state = (blackjack_face_state_t *)*context_ptr;
         state->tap_control_on = false;
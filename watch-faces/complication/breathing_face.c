@@ -48,7 +48,7 @@ static const uint16_t OUT_HOLD_DUR[] = { NOTE_LENGTH, NOTE_LENGTH, NOTE_LENGTH }
 void breathing_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index; // Unused parameter
     if (*context_ptr == NULL) {
-        breathing_state_t *state = malloc(sizeof(breathing_state_t));
+        breathing_state_t *state = movement_context_alloc(sizeof(breathing_state_t));
         state->current_stage = 0;
         state->indication_mode = 0; // Start with sound only
         state->led_on_state = 0;
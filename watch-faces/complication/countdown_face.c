@@ -36,13 +36,10 @@
 
 static bool quick_ticks_running;
 
-static void abort_quick_ticks(countdown_state_t *state) {
+static void abort_quick_ticks() {
     if (quick_ticks_running) {
         quick_ticks_running = false;
-        if (state->mode == cd_setting)
-            movement_request_tick_frequency(4);
-        else
-            movement_request_tick_frequency(1);
+        movement_request_tick_frequency(1);
     }
 }
 
@@ -94,7 +91,29 @@ static void start(countdown_state_t *state) {
 
 
 
-static void draw(countdown_state_t *state, uint8_t subsecond) {
+static void blink_selection(countdown_state_t *state, bool restart) {
+    // blink the field being set, but hold it steady while it's racing ahead
+    uint16_t positions = 0;
+    if (state->mode == cd_setting && !quick_ticks_running) {
+        switch(state->selection) {
+            case 0:
+                positions = WATCH_BLINK_HOURS;
+                break;
+            case 1:
+                positions = WATCH_BLINK_MINUTES;
+                break;
+            case 2:
+                positions = WATCH_BLINK_SECONDS;
+                break;
+            default:
+                break;
+        }
+    }
+    watch_blink_positions(positions, 500);
+    if (restart) watch_restart_blink_positions();
+}
+
+static void draw(countdown_state_t *state, bool restart_blink) {
     char buf[16];
 
     uint32_t delta;
@@ -120,25 +139,11 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
             break;
         case cd_setting:
             sprintf(buf, "%2d%02d%02d", state->hours, state->minutes, state->seconds);
-            if (!quick_ticks_running && subsecond % 2) {
-                switch(state->selection) {
-                    case 0:
-                        buf[0] = buf[1] = ' ';
-                        break;
-                    case 1:
-                        buf[2] = buf[3] = ' ';
-                        break;
-                    case 2:
-                        buf[4] = buf[5] = ' ';
-                        break;
-                    default:
-                        break;
-                }
-            }
             break;
     }
 
     watch_display_text(WATCH_POSITION_BOTTOM, buf);
+    blink_selection(state, restart_blink);
 
     if (state->tap_detection_ticks) {
         watch_set_indicator(WATCH_INDICATOR_SIGNAL);
@@ -195,7 +200,7 @@ void countdown_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(countdown_state_t));
+        *context_ptr = movement_context_alloc(sizeof(countdown_state_t));
         countdown_state_t *state = (countdown_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(countdown_state_t));
         state->minutes = DEFAULT_MINUTES;
@@ -231,14 +236,14 @@ bool countdown_face_loop(movement_event_t event, void *context) {
         case EVENT_ACTIVATE:
             if (watch_sleep_animation_is_running()) watch_stop_sleep_animation();
             watch_display_text_with_fallback(WATCH_POSITION_TOP, "TIMER", "CD");
-            draw(state, event.subsecond);
+            draw(state, true);
             break;
         case EVENT_TICK:
             if (quick_ticks_running) {
                 if (HAL_GPIO_BTN_ALARM_read())
                     settings_increment(state);
                 else
-                    abort_quick_ticks(state);
+                    abort_quick_ticks();
             }
 
             if (state->mode == cd_running) {
@@ -250,10 +255,10 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                 if (state->tap_detection_ticks == 0) movement_disable_tap_detection_if_available();
             }
 
-            draw(state, event.subsecond);
+            draw(state, false);
             break;
         case EVENT_MODE_BUTTON_UP:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
             movement_move_to_next_face();
             break;
         case EVENT_LIGHT_BUTTON_UP:
@@ -277,7 +282,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                     }
                     break;
             }
-            draw(state, event.subsecond);
+            draw(state, true);
             break;
         case EVENT_ALARM_BUTTON_UP:
             switch(state->mode) {
@@ -299,7 +304,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                     settings_increment(state);
                     break;
             }
-            draw(state, event.subsecond);
+            draw(state, true);
             break;
         case EVENT_ALARM_LONG_PRESS:
             switch(state->mode) {
@@ -307,7 +312,6 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                     // long press in reset mode enters settings
                     abort_tap_detection(state);
                     state->mode = cd_setting;
-                    movement_request_tick_frequency(4);
                     button_beep();
                     break;
                 case cd_setting:
@@ -320,6 +324,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                     // do nothing
                     break;
             }
+            draw(state, true);
             break;
         case EVENT_LIGHT_LONG_PRESS:
             if (state->mode == cd_setting) {
@@ -334,6 +339,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                         state->seconds = 0;
                         break;
                 }
+                draw(state, true);
             } else {
                 // Toggle auto-repeat
                 button_beep();
@@ -346,7 +352,8 @@ bool countdown_face_loop(movement_event_t event, void *context) {
             }
             break;
         case EVENT_ALARM_LONG_UP:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
+            draw(state, true);
             break;
         case EVENT_BACKGROUND_TASK:
             times_up(state);
@@ -386,7 +393,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
             }
             // reset the tap detection timer
             state->tap_detection_ticks = TAP_DETECTION_SECONDS;
-            draw(state, event.subsecond);
+            draw(state, true);
             break;
         default:
             movement_default_loop_handler(event);
@@ -27,12 +27,11 @@
 #include "days_since_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "filesystem.h"
+#include "prefs.h"
 
 static int days_since_instances;
 
 static void persist_date(days_since_state_t *state) {
-    days_since_date_t maybe_date;
     days_since_date_t current_date = {0};
     current_date.bit.year = state->working_year;
     current_date.bit.month = state->working_month;
@@ -40,13 +39,9 @@ static void persist_date(days_since_state_t *state) {
 
     char filename[13];
 
-    maybe_date.reg = 0xFFFFFFFF;
     sprintf(filename, "since%03d.u32", state->face_index);
 
-    filesystem_read_file(filename, (char *) &maybe_date.reg, sizeof(days_since_date_t));
-    if (current_date.reg != maybe_date.reg) {
-        filesystem_write_file(filename, (char *) &current_date.reg, sizeof(days_since_date_t));
-    }
+    prefs_set(filename, current_date.reg);
 }
 
 static uint32_t _days_since_face_juliandaynum(uint16_t year, uint16_t month, uint16_t day) {
@@ -56,7 +51,7 @@ static uint32_t _days_since_face_juliandaynum(uint16_t year, uint16_t month, uin
 
 static void _days_since_face_update(days_since_state_t *state) {
     char buf[15];
-    watch_date_time_t date_time = watch_rtc_get_date_time();
+    watch_date_time_t date_time = movement_get_utc_date_time();
     uint32_t julian_now_date = _days_since_face_juliandaynum(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day);
     uint32_t julian_since_date = _days_since_face_juliandaynum(state->working_year, state->working_month, state->working_day);
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "DAY", "DA");
@@ -97,7 +92,7 @@ static void _days_since_face_increment(days_since_state_t *state) {
 void days_since_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(days_since_state_t));
+        *context_ptr = movement_context_alloc(sizeof(days_since_state_t));
         memset(*context_ptr, 0, sizeof(days_since_state_t));
         days_since_date_t since_date = {0};
         days_since_state_t *state = (days_since_state_t *)*context_ptr;
@@ -106,9 +101,7 @@ void days_since_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         // load date from file if it exists
         char filename[13];
         sprintf(filename, "since%03d.u32", state->face_index);
-        if (filesystem_file_exists(filename)) {
-            filesystem_read_file(filename, (char *) &since_date, sizeof(days_since_date_t));
-        } else {
+        if (!prefs_get(filename, &since_date.reg)) {
             // if birth date is not set, set a reasonable starting date. this works well for anyone under 65, but
             // you can keep pressing to go back to 1900; just go past the year 2080.
             since_date.bit.year = 1959;
@@ -128,6 +121,9 @@ void days_since_face_activate(void *context) {
     state->current_page = PAGE_DISPLAY;
     state->quick_cycle = false;
     state->ticks = 0;
+
+    // the display only changes at midnight, so there's no need to wake up every second.
+    movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
 }
 
 bool days_since_face_loop(movement_event_t event, void *context) {
@@ -179,7 +175,7 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                     break;
                 // otherwise, check if we have to update. the display only needs to change at midnight!
                 case PAGE_DISPLAY: {
-                    watch_date_time_t date_time = watch_rtc_get_date_time();
+                    watch_date_time_t date_time = movement_get_utc_date_time();
                     if (date_time.unit.hour == 0 &&  date_time.unit.minute == 0 && date_time.unit.second == 0) {
                         _days_since_face_update(state);
                     }
@@ -189,6 +185,7 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                         state->ticks--;
                     } else {
                         state->current_page = PAGE_DISPLAY;
+                        movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
                         _days_since_face_update(state);
                     }
                     break;
@@ -220,7 +217,7 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                     state->current_page = (state->current_page + 1) % 4;
                     if (state->current_page == PAGE_DISPLAY) {
                         // ...unless we've been pushed back to display mode.
-                        movement_request_tick_frequency(1);
+                        movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
                         // save the date if it changed
                         persist_date(state);
                         // and force display since it normally won't update til midnight.
@@ -244,7 +241,7 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                     break;
                 case PAGE_DISPLAY:
                 {
-                    watch_date_time_t date_time = watch_rtc_get_date_time();
+                    watch_date_time_t date_time = movement_get_utc_date_time();
                     uint32_t julian_now_date = _days_since_face_juliandaynum(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day);
                     uint32_t julian_since_date = _days_since_face_juliandaynum(state->working_year, state->working_month, state->working_day);
                     if (julian_now_date < julian_since_date) {
@@ -253,6 +250,8 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                         watch_display_text_with_fallback(WATCH_POSITION_TOP, "SINCE", "DA");
                     }
                     state->current_page = PAGE_DATE;
+                    // we need the 1 Hz tick to count down back to the display page.
+                    movement_request_tick_frequency(1);
                     sprintf(buf, "%02d%02d%02d", state->working_year % 100, state->working_month % 100, state->working_day % 100);
                     watch_display_text(WATCH_POSITION_BOTTOM, buf);
                     state->ticks = 2;
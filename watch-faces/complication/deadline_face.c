@@ -49,8 +49,7 @@ static bool _deadline_running_loop(movement_event_t event, void *context);
 static void _deadline_running_display(movement_event_t event, deadline_state_t * state);
 static void _deadline_settings_init(deadline_state_t * state);
 static bool _deadline_settings_loop(movement_event_t event, void *context);
-static void _deadline_settings_display(movement_event_t event, deadline_state_t * state,
-                                       watch_date_time_t date);
+static void _deadline_settings_display(deadline_state_t * state, watch_date_time_t date_time);
 
 /* Check for leap year */
 static inline bool _is_leap(int16_t y)
@@ -313,6 +312,7 @@ static void _deadline_running_init(deadline_state_t *state)
     watch_clear_indicator(WATCH_INDICATOR_24H);
     watch_clear_indicator(WATCH_INDICATOR_PM);
     watch_set_colon();
+    watch_blink_positions(0, 0);
 
     /* Ensure 1Hz updates only */
     _change_tick_freq(1, state);
@@ -363,8 +363,7 @@ static bool _deadline_running_loop(movement_event_t event, void *context)
 }
 
 /* Update display in settings mode */
-static void _deadline_settings_display(movement_event_t event,
-                                       deadline_state_t *state, watch_date_time_t date_time)
+static void _deadline_settings_display(deadline_state_t *state, watch_date_time_t date_time)
 {
     char buf[7];
 
@@ -396,24 +395,26 @@ static void _deadline_settings_display(movement_event_t event,
                 date_time.unit.year + 20, date_time.unit.month, date_time.unit.day);
     }
 
-    /* Blink up the parameter we are setting */
-    if (event.subsecond % 2) {
+    watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf);
+
+    /* Blink up the parameter we are setting, unless it is cycling fast */
+    uint16_t positions = 0;
+    if (state->tick_freq != 8) {
         switch (state->current_page) {
             case 0:
             case 3:
-                buf[0] = buf[1] = ' ';
+                positions = WATCH_BLINK_HOURS;
                 break;
             case 1:
             case 4:
-                buf[2] = buf[3] = ' ';
+                positions = WATCH_BLINK_MINUTES;
                 break;
             case 2:
-                buf[4] = buf[5] = ' ';
+                positions = WATCH_BLINK_SECONDS;
                 break;
         }
     }
-
-    watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf);
+    watch_blink_positions(positions, 500);
 }
 
 /* Init setting mode */
@@ -438,16 +439,17 @@ static bool _deadline_settings_loop(movement_event_t event, void *context)
     date_time = watch_utility_date_time_from_unix_time(state->deadlines[state->current_index], 0);
 
     if (event.event_type != EVENT_BACKGROUND_TASK)
-        _deadline_settings_display(event, state, date_time);
+        _deadline_settings_display(state, date_time);
 
     switch (event.event_type) {
         case EVENT_TICK:
             if (state->tick_freq == 8) {
                 if (HAL_GPIO_BTN_ALARM_read()) {
                     _increment_date(state, date_time);
-                    _deadline_settings_display(event, state, date_time);
+                    _deadline_settings_display(state, date_time);
                 } else {
-                    _change_tick_freq(4, state);
+                    _change_tick_freq(1, state);
+                    _deadline_settings_display(state, date_time);
                 }
             }
             break;
@@ -455,7 +457,8 @@ static bool _deadline_settings_loop(movement_event_t event, void *context)
             _change_tick_freq(8, state);
             break;
         case EVENT_ALARM_LONG_UP:
-            _change_tick_freq(4, state);
+            _change_tick_freq(1, state);
+            _deadline_settings_display(state, date_time);
             break;
         case EVENT_LIGHT_LONG_PRESS:
             _beep(BEEP_BUTTON);
@@ -465,12 +468,12 @@ static bool _deadline_settings_loop(movement_event_t event, void *context)
             break;
         case EVENT_LIGHT_BUTTON_UP:
             state->current_page = (state->current_page + 1) % SETTINGS_NUM;
-            _deadline_settings_display(event, state, date_time);
+            _deadline_settings_display(state, date_time);
             break;
         case EVENT_ALARM_BUTTON_UP:
-            _change_tick_freq(4, state);
+            _change_tick_freq(1, state);
             _increment_date(state, date_time);
-            _deadline_settings_display(event, state, date_time);
+            _deadline_settings_display(state, date_time);
             break;
         case EVENT_TIMEOUT:
             _beep(BEEP_BUTTON);
@@ -502,7 +505,7 @@ void deadline_face_setup(uint8_t watch_face_index, void **context_ptr)
         return; /* Skip setup if context available */
 
     /* Allocate state */
-    *context_ptr = malloc(sizeof(deadline_state_t));
+    *context_ptr = movement_context_alloc(sizeof(deadline_state_t));
     memset(*context_ptr, 0, sizeof(deadline_state_t));
 
     /* Store face index for background tasks */
@@ -289,7 +289,7 @@ static uint32_t elapsed_time(fast_stopwatch_state_t *state, rtc_counter_t counte
 void fast_stopwatch_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(fast_stopwatch_state_t));
+        *context_ptr = movement_context_alloc(sizeof(fast_stopwatch_state_t));
         memset(*context_ptr, 0, sizeof(fast_stopwatch_state_t));
         fast_stopwatch_state_t *state = (fast_stopwatch_state_t *)*context_ptr;
         state->start_counter = 0;
@@ -344,12 +344,11 @@ void higher_lower_game_face_setup(uint8_t watch_face_index, void **context_ptr)
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(higher_lower_game_face_state_t));
+        *context_ptr = movement_context_alloc(sizeof(higher_lower_game_face_state_t));
         memset(*context_ptr, 0, sizeof(higher_lower_game_face_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
         memset(game_board, 0, sizeof(game_board));
     }
-    // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
 void higher_lower_game_face_activate(void *context) {
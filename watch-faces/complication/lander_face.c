@@ -143,7 +143,7 @@ static void write_to_lander_EEPROM(lander_state_t *state) {
 void lander_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(lander_state_t));
+        *context_ptr = movement_context_alloc(sizeof(lander_state_t));
         memset(*context_ptr, 0, sizeof(lander_state_t));
         lander_state_t *state = (lander_state_t *)*context_ptr;
         state->led_enabled = false;
@@ -44,19 +44,21 @@ static const float phase_changes[] = {0, 1, 6.38264692644, 8.38264692644, 13.765
 void moon_phase_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(moon_phase_state_t));
+        *context_ptr = movement_context_alloc(sizeof(moon_phase_state_t));
         memset(*context_ptr, 0, sizeof(moon_phase_state_t));
     }
 }
 
 void moon_phase_face_activate(void *context) {
     (void) context;
+    // we only update once an hour, so a tick at the top of each minute is plenty.
+    movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
 }
 
 static void _update(moon_phase_state_t *state, uint32_t offset) {
     (void)state;
     char buf[4];
-    watch_date_time_t date_time = watch_rtc_get_date_time();
+    watch_date_time_t date_time = movement_get_utc_date_time();
     uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_get_current_timezone_offset()) + offset;
     date_time = watch_utility_date_time_from_unix_time(now, movement_get_current_timezone_offset());
     double currentfrac = fmod(now - FIRST_MOON, LUNAR_SECONDS) / LUNAR_SECONDS;
@@ -163,13 +165,13 @@ bool moon_phase_face_loop(movement_event_t event, void *context) {
             break;
         case EVENT_TICK:
             // only update once an hour
-            date_time = watch_rtc_get_date_time();
+            date_time = movement_get_utc_date_time();
             if ((date_time.unit.minute == 0) && (date_time.unit.second == 0)) _update(state, state->offset);
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             // update at the top of the hour OR if we're entering sleep mode with an offset.
             // also, in sleep mode, always show the current moon phase (offset = 0).
-            if (state->offset || (watch_rtc_get_date_time().unit.minute == 0)) _update(state, 0);
+            if (state->offset || (movement_get_utc_date_time().unit.minute == 0)) _update(state, 0);
             // and kill the offset so when the wearer wakes up, it matches what's on screen.
             state->offset = 0;
             if (watch_get_lcd_type() == WATCH_LCD_TYPE_CLASSIC) {
@@ -31,12 +31,11 @@
 #include "periodic_table_face.h"
 
 #define FREQ_FAST 8
-#define FREQ 2
+#define FREQ 1
+#define SCROLL_FRAME_MS 500
 
 static bool _quick_ticks_running;
 static uint8_t _ts_ticks = 0;
-static int16_t _text_pos;
-static const char* _text_looping;
 static const char title_text[] = "Periodic table";
 
 void periodic_table_face_setup(uint8_t watch_face_index, void **context_ptr)
@@ -44,7 +43,7 @@ void periodic_table_face_setup(uint8_t watch_face_index, void **context_ptr)
     (void)watch_face_index;
     if (*context_ptr == NULL)
     {
-        *context_ptr = malloc(sizeof(periodic_table_state_t));
+        *context_ptr = movement_context_alloc(sizeof(periodic_table_state_t));
         memset(*context_ptr, 0, sizeof(periodic_table_state_t));
     }
 }
@@ -342,12 +341,7 @@ static void _display_name(periodic_table_state_t *state)
     }
 
 
-    _text_looping = elm_name;
-    _text_pos = 0;
-
-    char buf[7];
-    sprintf(buf, "%.6s", elm_name);
-    watch_display_text(WATCH_POSITION_BOTTOM, buf); 
+    movement_animate_marquee(4, 6, elm_name, SCROLL_FRAME_MS, true);
 }
 
 static void _display_electronegativity(periodic_table_state_t *state)
@@ -384,43 +378,20 @@ static void stop_quick_cyc(void){
     movement_request_tick_frequency(FREQ);
 }
 
-static int16_t _loop_text(const char* text, int8_t curr_loc, bool shift){
-    // if curr_loc, then use that many ticks as a delay before looping
-    char buf[15];
-    uint8_t text_len = strlen(text);
-    if (curr_loc == -1) curr_loc = 0;  // To avoid double-showing the 0
-    if (text_len <= 6 || curr_loc < 0) {
-        if (shift)
-            sprintf(buf, " %.5s", text);
-        else
-            sprintf(buf, "%.6s", text);
-        watch_display_text(WATCH_POSITION_BOTTOM, buf);
-        if (curr_loc < 0) return ++curr_loc;
-        return 0;
-    }
-    else if (curr_loc == (text_len + 1))
-        curr_loc = 0;
-
-    if (shift) // Extra space on title screen on F-91W screen
-        sprintf(buf, " %.6s %.6s", text + curr_loc, text);  // Take wrapping substring
-    else 
-        sprintf(buf, "%.6s %.6s", text + curr_loc, text);  // Take wrapping substring
-
-    buf[6] = '\0'; // Prevent overflow
-    watch_display_text(WATCH_POSITION_BOTTOM, buf);
-    return curr_loc + 1; // Next position
-}
-
 static void _display_title(periodic_table_state_t *state){
     state->atomic_num = 0;
     watch_clear_colon();
     watch_clear_all_indicators();
-    _text_looping = title_text;
-    _text_pos = FREQ * -1;
-    _text_pos = _loop_text(_text_looping, _text_pos, watch_get_lcd_type() != WATCH_LCD_TYPE_CUSTOM);
+    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        movement_animate_marquee(4, 6, title_text, SCROLL_FRAME_MS, true);
+    } else {
+        // Extra space on title screen on F-91W screen
+        movement_animate_marquee(5, 5, title_text, SCROLL_FRAME_MS, true);
+    }
 }
 
 static void _display_screen(periodic_table_state_t *state, bool should_sound){
+    movement_stop_animation();
     watch_clear_display();
     watch_clear_all_indicators();
     switch (state->mode)
@@ -484,7 +455,7 @@ static void _handle_mode_still_pressed(periodic_table_state_t *state, bool shoul
                 _display_screen(state, should_sound);
                 break;
             }
-            _ts_ticks = 2;
+            _ts_ticks = FREQ;
         }
     }
 }
@@ -499,10 +470,6 @@ bool periodic_table_face_loop(movement_event_t event, void *context)
         _display_screen(state, false);
         break;
     case EVENT_TICK:
-        if (state->mode == SCREEN_TITLE) _text_pos = _loop_text(_text_looping, _text_pos, watch_get_lcd_type() != WATCH_LCD_TYPE_CUSTOM);
-        else if (state->mode == SCREEN_FULL_NAME && 
-            !(watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM && table[state->atomic_num - 1].name[0] == 'I' && strlen(table[state->atomic_num - 1].name) <= 7)) 
-                _text_pos = _loop_text(_text_looping, _text_pos, false);
         if (_quick_ticks_running) {
             if (HAL_GPIO_BTN_LIGHT_read()) _handle_backward(state, false);
             else if (HAL_GPIO_BTN_ALARM_read()) _handle_forward(state, false);
@@ -570,7 +537,7 @@ bool periodic_table_face_loop(movement_event_t event, void *context)
             _display_screen(state, movement_button_should_sound());
             break;
         }
-        _ts_ticks = 2;
+        _ts_ticks = FREQ;
         break;
     case EVENT_TIMEOUT:
         // Display title after timeout
@@ -448,6 +448,7 @@ static void display_lose_screen(ping_state_t *state) {
     watch_clear_display();
     watch_display_text(WATCH_POSITION_BOTTOM, " LOSE ");
     if (state -> soundOn) {
+        watch_display_commit();
         watch_buzzer_play_sequence(lose_tune, NULL);
         delay_ms(600);
     }
@@ -474,7 +475,7 @@ static void update_game(ping_state_t *state) {
 void ping_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(ping_state_t));
+        *context_ptr = movement_context_alloc(sizeof(ping_state_t));
         memset(*context_ptr, 0, sizeof(ping_state_t));
         ping_state_t *state = (ping_state_t *)*context_ptr;
         state->difficulty = DIFF_NORM;
@@ -214,7 +214,7 @@ void probability_face_setup(uint8_t watch_face_index, void **context_ptr)
     (void)watch_face_index;
     if (*context_ptr == NULL)
     {
-        *context_ptr = malloc(sizeof(probability_state_t));
+        *context_ptr = movement_context_alloc(sizeof(probability_state_t));
         memset(*context_ptr, 0, sizeof(probability_state_t));
     }
 // Emulator only: Seed random number generator
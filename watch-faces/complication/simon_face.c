@@ -116,6 +116,7 @@ static void _simon_display_note(SimonNote note, simon_state_t *state) {
 
 static void _simon_play_note(SimonNote note, simon_state_t *state, bool skip_rest) {
     _simon_display_note(note, state);
+    watch_display_commit();
     switch (note) {
         case SIMON_LED_NOTE:
             if (!state->lightOff) watch_set_led_yellow();
@@ -141,6 +142,7 @@ static void _simon_play_note(SimonNote note, simon_state_t *state, bool skip_res
 
     if (note != SIMON_WRONG_NOTE) {
         _simon_clear_display(state);
+        watch_display_commit();
         if (!skip_rest) {
             delay_ms((_delay_beep * 2)/3);
         }
@@ -201,13 +203,11 @@ void simon_face_setup(uint8_t watch_face_index,
         void **context_ptr) {
     (void)watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(simon_state_t));
+        *context_ptr = movement_context_alloc(sizeof(simon_state_t));
         memset(*context_ptr, 0, sizeof(simon_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens
         // only at boot.
     }
-    // Do any pin or peripheral setup here; this will be called whenever the watch
-    // wakes from deep sleep.
 #if __EMSCRIPTEN__
     // simulator only: seed the randon number generator
     time_t t;
@@ -31,7 +31,7 @@
 void simple_coin_flip_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(simple_coin_flip_face_state_t));
+        *context_ptr = movement_context_alloc(sizeof(simple_coin_flip_face_state_t));
         memset(*context_ptr, 0, sizeof(simple_coin_flip_face_state_t));
     }
 }
@@ -65,6 +65,7 @@ static void set_pixels(int pixels[3][4][2], int j_len) {
             for(int j = 0; j<j_len; j++){
                 watch_set_pixel(pixels[i][j][0], pixels[i][j][1]);
             }
+            watch_display_commit();
             delay_ms(150);
         }
     }
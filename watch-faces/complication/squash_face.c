@@ -104,7 +104,7 @@ void squash_face_setup(uint8_t watch_face_index, void **context_ptr) {
     (void)watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(squash_state_t));
+        *context_ptr = movement_context_alloc(sizeof(squash_state_t));
         memset(*context_ptr, 0, sizeof(squash_state_t));
     }
 }
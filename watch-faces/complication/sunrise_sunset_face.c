@@ -32,7 +32,7 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "watch_common_display.h"
-#include "filesystem.h"
+#include "prefs.h"
 #include "sunriset.h"
 
 #if __EMSCRIPTEN__
@@ -42,18 +42,13 @@
 static const uint8_t _location_count = sizeof(longLatPresets) / sizeof(long_lat_presets_t);
 
 static void persist_location_to_filesystem(movement_location_t new_location) {
-    movement_location_t maybe_location = {0};
-
-    filesystem_read_file("location.u32", (char *) &maybe_location.reg, sizeof(movement_location_t));
-    if (new_location.reg != maybe_location.reg) {
-        filesystem_write_file("location.u32", (char *) &new_location.reg, sizeof(movement_location_t));
-    }
+    prefs_set("location.u32", new_location.reg);
 }
 
 static movement_location_t load_location_from_filesystem() {
     movement_location_t location = {0};
 
-    filesystem_read_file("location.u32", (char *) &location.reg, sizeof(movement_location_t));
+    prefs_get("location.u32", &location.reg);
 
     return location;
 }
@@ -449,7 +444,7 @@ static void _sunrise_sunset_face_advance_digit(sunrise_sunset_state_t *state) {
 void sunrise_sunset_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(sunrise_sunset_state_t));
+        *context_ptr = movement_context_alloc(sizeof(sunrise_sunset_state_t));
         memset(*context_ptr, 0, sizeof(sunrise_sunset_state_t));
     }
 }
@@ -476,6 +471,9 @@ void sunrise_sunset_face_activate(void *context) {
     movement_location_t movement_location = load_location_from_filesystem();
     state->working_latitude = _sunrise_sunset_face_struct_from_latlon(movement_location.bit.latitude);
     state->working_longitude = _sunrise_sunset_face_struct_from_latlon(movement_location.bit.longitude);
+
+    // rise and set times have minute resolution, so we only need to check for expiry at the top of the minute.
+    movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
 }
 
 bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
@@ -524,7 +522,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
                 movement_illuminate_led();
             }
             if (state->page == 0) {
-                movement_request_tick_frequency(1);
+                movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
                 _sunrise_sunset_face_update(state);
             }
             break;
@@ -563,6 +561,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
             else {
                 state->active_digit = 0;
                 state->page = 0;
+                movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
                 _sunrise_sunset_face_update_location_register(state);
                 _sunrise_sunset_face_update(state);
             }
@@ -575,7 +574,7 @@ bool sunrise_sunset_face_loop(movement_event_t event, void *context) {
                 // otherwise on timeout, exit settings mode and return to the next sunrise or sunset
                 state->page = 0;
                 state->rise_index = 0;
-                movement_request_tick_frequency(1);
+                movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
                 _sunrise_sunset_face_update(state);
             }
             break;
@@ -84,7 +84,7 @@ void tide_face_setup(uint8_t watch_face_index, void** state_ptr) {
     (void) watch_face_index;
     if (*state_ptr == NULL) {
         // Boot time initialization.
-        *state_ptr = malloc(sizeof(tide_state_t));
+        *state_ptr = movement_context_alloc(sizeof(tide_state_t));
         tide_state_t* state = (tide_state_t*)*state_ptr;
         state->mode = TIDE_SCREEN_EMPTY;
     }
@@ -45,7 +45,7 @@ static void _signal_callback() {
 
 static void _start(timer_state_t *state, bool with_beep) {
     if (state->timers[state->current_timer].value == 0) return;
-    watch_date_time_t now = watch_rtc_get_date_time();
+    watch_date_time_t now = movement_get_utc_date_time();
     state->now_ts = watch_utility_date_time_to_unix_time(now, movement_get_current_timezone_offset());
     if (state->mode == pausing)
         state->target_ts = state->now_ts + state->paused_left;
@@ -193,7 +193,7 @@ static inline bool _check_for_signal() {
 void timer_face_setup(uint8_t watch_face_index, void ** context_ptr) {
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(timer_state_t));
+        *context_ptr = movement_context_alloc(sizeof(timer_state_t));
         timer_state_t *state = (timer_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(timer_state_t));
         state->watch_face_index = watch_face_index;
@@ -208,7 +208,7 @@ void timer_face_activate(void *context) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "TMR", "TR");
     watch_set_colon();
     if(state->mode == running) {
-        watch_date_time_t now = watch_rtc_get_date_time();
+        watch_date_time_t now = movement_get_utc_date_time();
         state->now_ts = watch_utility_date_time_to_unix_time(now, movement_get_current_timezone_offset());
         watch_set_indicator(WATCH_INDICATOR_BELL);
     } else {
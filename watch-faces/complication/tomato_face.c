@@ -106,7 +106,7 @@ static void tomato_ring(tomato_state_t *state) {
 
 void tomato_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(tomato_state_t));
+        *context_ptr = movement_context_alloc(sizeof(tomato_state_t));
         tomato_state_t *state = (tomato_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(tomato_state_t));
         state->mode = tomato_ready;
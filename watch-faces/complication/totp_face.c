@@ -176,8 +176,8 @@ void totp_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     totp_validate_key_lengths();
 
     if (*context_ptr == NULL) {
-        totp_state_t *totp = malloc(sizeof(totp_state_t));
-        totp->current_decoded_key = malloc(TOTP_FACE_MAX_KEY_LENGTH);
+        totp_state_t *totp = movement_context_alloc(sizeof(totp_state_t));
+        totp->current_decoded_key = movement_context_alloc(TOTP_FACE_MAX_KEY_LENGTH);
         *context_ptr = totp;
     }
 }
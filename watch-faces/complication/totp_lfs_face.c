@@ -131,14 +131,15 @@ static void totp_lfs_face_read_file(char *filename) {
     // For 'format' of file, see comment at top.
     const size_t uri_start_len = strlen(TOTP_URI_START);
 
-    if (!filesystem_file_exists(filename)) {
+    filesystem_file_t *file = filesystem_file_exists(filename) ? filesystem_open(filename, FILESYSTEM_MODE_READ) : NULL;
+    if (file == NULL) {
         printf("TOTP file error: %s\n", filename);
         return;
     }
 
     char line[256];
-    int32_t offset = 0, old_offset = 0;
-    while (old_offset = offset, filesystem_read_line(filename, line, &offset, 255) && strlen(line)) {
+    int32_t old_offset = 0;
+    while (old_offset = filesystem_tell(file), filesystem_readline(file, line, sizeof(line)) > 0) {
         if (num_totp_records == MAX_TOTP_RECORDS) {
             printf("TOTP max records: %d\n", MAX_TOTP_RECORDS);
             break;
@@ -187,12 +188,14 @@ static void totp_lfs_face_read_file(char *filename) {
             printf("TOTP missing secret: %s\n", line);
         }
     }
+
+    filesystem_close(file);
 }
 
 void totp_lfs_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(totp_lfs_state_t));
+        *context_ptr = movement_context_alloc(sizeof(totp_lfs_state_t));
     }
 
 #if !(__EMSCRIPTEN__)
@@ -204,18 +207,23 @@ void totp_lfs_face_setup(uint8_t watch_face_index, void ** context_ptr) {
 
 static uint8_t *totp_lfs_face_get_file_secret(struct totp_record *record) {
     char buffer[BASE32_LEN(MAX_TOTP_SECRET_SIZE) + 1];
-    int32_t file_secret_offset = record->file_secret_offset;
 
-    /* TODO filesystem_read_line is quite inefficient. Consider writing a new function,
-     * and keeping the file open?
-     */
-    if (!filesystem_read_line(TOTP_FILE, buffer, &file_secret_offset, record->file_secret_length + 1)) {
+    filesystem_file_t *file = filesystem_open(TOTP_FILE, FILESYSTEM_MODE_READ);
+    int32_t length = -1;
+    if (file != NULL) {
+        if (filesystem_seek(file, record->file_secret_offset)) {
+            length = filesystem_read(file, buffer, record->file_secret_length);
+        }
+        filesystem_close(file);
+    }
+    if (length != record->file_secret_length) {
         /* Shouldn't happen at this point. Return current_secret, which is misleading but will not cause a crash. */
-        printf("TOTP can't read expected secret from totp_uris.txt (failed readline)\n");
+        printf("TOTP can't read expected secret from totp_uris.txt (failed read)\n");
         return current_secret;
     }
+    buffer[length] = '\0';
     if (base32_decode((unsigned char *)buffer, current_secret) != record->secret_size) {
-        printf("TOTP can't properly decode secret '%s' from totp_uris.txt; failed at offset %d; read to %ld\n", buffer, record->file_secret_offset, file_secret_offset);
+        printf("TOTP can't properly decode secret '%s' from totp_uris.txt; failed at offset %d\n", buffer, record->file_secret_offset);
     }
     return current_secret;
 }
@@ -41,21 +41,8 @@ void wareki_setup(uint8_t watch_face_index, void ** context_ptr) {
     //printf("wareki_setup() \n");
     
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(wareki_state_t));
+        *context_ptr = movement_context_alloc(sizeof(wareki_state_t));
         memset(*context_ptr, 0, sizeof(wareki_state_t));
-
-        //debug code 
-        // watch_date_time datetime = watch_rtc_get_date_time();
-        // datetime.unit.year  = 2022 - WATCH_RTC_REFERENCE_YEAR;
-        // datetime.unit.month = 12;
-        // datetime.unit.day   = 31;
-        // datetime.unit.hour  = 23;
-        // datetime.unit.minute= 59;
-        // datetime.unit.second= 30;
-        // watch_rtc_set_date_time(datetime);
-        // settings->bit.clock_mode_24h = true; //24時間表記
-        // settings->bit.to_interval = 1;//0=60sec 1=2m 2=5m 3=30m
-        // watch_store_backup_data(settings->reg, 0);
     }
 }
 
@@ -151,11 +138,12 @@ void wareki_activate(void *context) {
     _alarm_button_press = false;
     _light_button_press = false;
 
-    state->real_year = watch_rtc_get_date_time().unit.year + WATCH_RTC_REFERENCE_YEAR;
+    state->real_year = movement_get_utc_date_time().unit.year + WATCH_RTC_REFERENCE_YEAR;
     state->start_year = state->real_year;
     state->disp_year = state->real_year;
 
-    movement_request_tick_frequency(1);
+    // the year only changes at the top of the minute, or when a button is pressed.
+    movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
 }
 
 
@@ -186,7 +174,7 @@ void subYear(wareki_state_t* state,int count){
 bool wareki_loop(movement_event_t event, void *context) {
     wareki_state_t *state = (wareki_state_t *)context;
 
-    state->real_year = watch_rtc_get_date_time().unit.year + WATCH_RTC_REFERENCE_YEAR;
+    state->real_year = movement_get_utc_date_time().unit.year + WATCH_RTC_REFERENCE_YEAR;
 
     if( state->real_year != state->start_year ){
         state->start_year = state->real_year;
@@ -197,6 +185,7 @@ bool wareki_loop(movement_event_t event, void *context) {
     switch (event.event_type) {
         case EVENT_ACTIVATE:
             draw_wareki_splash(state);
+            draw_year_and_wareki(state);
             break;
         case EVENT_MODE_BUTTON_UP:
             movement_move_to_next_face();
@@ -232,12 +221,12 @@ bool wareki_loop(movement_event_t event, void *context) {
             }
             
             draw_year_and_wareki(state);
-
             break;
 
         case EVENT_LIGHT_BUTTON_DOWN:
             //printf("LIGHT DOWN\n");
             subYear(state,1);
+            draw_year_and_wareki(state);
             break;
         case EVENT_LIGHT_LONG_PRESS:
             //printf("LIGHTPRESS \n"); 
@@ -247,16 +236,17 @@ bool wareki_loop(movement_event_t event, void *context) {
         case EVENT_LIGHT_LONG_UP:
             //printf("LIGHTPRESS UP\n");
             _light_button_press = false;
-            movement_request_tick_frequency(4);
+            movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
             break;
         case EVENT_LIGHT_BUTTON_UP:
             //printf("LIGHT UP\n");
             _light_button_press = false;
-            movement_request_tick_frequency(4);
+            movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
             break;
         case EVENT_ALARM_BUTTON_DOWN:
             //printf("ALARM DOWN\n");
             addYear(state,1);
+            draw_year_and_wareki(state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             //printf("LONGPRESS \n");
@@ -266,11 +256,11 @@ bool wareki_loop(movement_event_t event, void *context) {
         case EVENT_ALARM_LONG_UP:
             //printf("LONGPRESS UP\n");
             _alarm_button_press = false;
-            movement_request_tick_frequency(4);
+            movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
             break;
         case EVENT_ALARM_BUTTON_UP:
             //printf("ALARM UP\n");
-            movement_request_tick_frequency(4);
+            movement_request_tick_mode(MOVEMENT_TICK_MODE_MINUTE);
             break;
 
         case EVENT_TIMEOUT:
@@ -311,7 +311,7 @@ static void display_wait(wordle_state_t *state) {
 #endif
 
 static uint32_t get_day_unix_time(void) {
-    watch_date_time_t now = watch_rtc_get_date_time();
+    watch_date_time_t now = movement_get_utc_date_time();
 #if WORDLE_USE_DAILY_STREAK == 2
     now.unit.hour = now.unit.minute = now.unit.second = 0;
 #endif
@@ -534,7 +534,7 @@ static void _activate(wordle_state_t *state) {
 void wordle_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(wordle_state_t));
+        *context_ptr = movement_context_alloc(sizeof(wordle_state_t));
         memset(*context_ptr, 0, sizeof(wordle_state_t));
         wordle_state_t *state = (wordle_state_t *)*context_ptr;
         state->curr_screen = WORDLE_SCREEN_TITLE;
@@ -542,7 +542,6 @@ void wordle_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         reset_all_elements(state);
         memset(state->not_to_use, 0xff, sizeof(state->not_to_use));
     }
-    // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
 void wordle_face_activate(void *context) {
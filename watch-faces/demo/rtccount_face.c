@@ -138,7 +138,7 @@ static void _rtccount_face_draw(movement_event_t event, rtccount_state_t* state)
 void rtccount_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(rtccount_state_t));
+        *context_ptr = movement_context_alloc(sizeof(rtccount_state_t));
         memset(*context_ptr, 0, sizeof(rtccount_state_t));
         rtccount_state_t *state = (rtccount_state_t *) *context_ptr;
         state->status = RTCCOUNT_STATUS_COUNTER;
@@ -96,11 +96,9 @@ static uint16_t activity_buffer_size = 0;
 void chirpy_demo_face_setup(uint8_t watch_face_index, void **context_ptr) {
     (void)watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(chirpy_demo_state_t));
+        *context_ptr = movement_context_alloc(sizeof(chirpy_demo_state_t));
         memset(*context_ptr, 0, sizeof(chirpy_demo_state_t));
-        // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
-    // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
 void chirpy_demo_face_activate(void *context) {
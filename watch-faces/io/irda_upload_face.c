@@ -30,13 +30,14 @@
 #include "usb.h"
 #include "uart.h"
 #include "filesystem.h"
+#include "prefs.h"
 
 #ifdef HAS_IR_SENSOR
 
 void irda_upload_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(irda_demo_state_t));
+        *context_ptr = movement_context_alloc(sizeof(irda_demo_state_t));
         memset(*context_ptr, 0, sizeof(irda_demo_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }    
@@ -68,7 +69,7 @@ bool irda_upload_face_loop(movement_event_t event, void *context) {
             size_t bytes_read = uart_read_instance(0, data, 256);
             watch_clear_display();
             watch_set_indicator(WATCH_INDICATOR_ARROWS);
-            if (watch_rtc_get_date_time().unit.second % 4 < 2) watch_display_text_with_fallback(WATCH_POSITION_TOP, "IrDA", "IR");
+            if (movement_get_utc_date_time().unit.second % 4 < 2) watch_display_text_with_fallback(WATCH_POSITION_TOP, "IrDA", "IR");
             else watch_display_text_with_fallback(WATCH_POSITION_TOP, "FREE ", "DF");
 
             if (bytes_read) {
@@ -98,6 +99,7 @@ bool irda_upload_face_loop(movement_event_t event, void *context) {
                     // Success! All we need is a header to delete a file.
                     movement_force_led_on(0, 48, 0);
                     filesystem_rm(filename);
+                    prefs_reload(filename);
                     watch_display_text_with_fallback(WATCH_POSITION_TOP, "FILE ", "FI");
                     watch_display_text_with_fallback(WATCH_POSITION_TOP, "dELETE", " deLet");
                     break;
@@ -118,6 +120,7 @@ bool irda_upload_face_loop(movement_event_t event, void *context) {
 
                 // Valid data! Write it to the file system.
                 filesystem_write_file(filename, data + 16, expected_size);
+                prefs_reload(filename);
                 watch_display_text_with_fallback(WATCH_POSITION_TOP, "RECVd", "RC");
                 movement_force_led_on(0, 48, 0);
 
@@ -46,7 +46,7 @@ static void _accelerometer_status_face_update_display(accel_interrupt_count_stat
 void accelerometer_status_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(accel_interrupt_count_state_t));
+        *context_ptr = movement_context_alloc(sizeof(accel_interrupt_count_state_t));
         memset(*context_ptr, 0, sizeof(accel_interrupt_count_state_t));
     }
 }
@@ -28,6 +28,30 @@
 #include "filesystem.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "tslog.h"
+
+#define ACTIVITY_LOGGING_DAYS_PER_FLUSH (7)
+
+typedef struct {
+    uint16_t skip;
+    tslog_record_t record;
+} activity_logging_lookup_t;
+
+static bool _activity_logging_face_find_record(const tslog_record_t *record, void *context) {
+    activity_logging_lookup_t *lookup = (activity_logging_lookup_t *)context;
+    if (lookup->skip) {
+        lookup->skip--;
+        return true;
+    }
+    lookup->record = *record;
+
+    return false;
+}
+
+// today, plus every day in the log.
+static inline uint16_t _activity_logging_face_num_days(void) {
+    return tslog_count(TSLOG_ACTIVITY) + 1;
+}
 
 static void _activity_logging_face_update_display(activity_logging_state_t *state) {
     char buf[8];
@@ -47,31 +71,40 @@ static void _activity_logging_face_update_display(activity_logging_state_t *stat
     } else {
         // otherwise we need to go into the log.
         watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
-        int32_t pos = ((int16_t)state->data_points - (int32_t)state->display_index) % ACTIVITY_LOGGING_NUM_DAYS;
-        // get day of month for today - display_index
-        uint32_t unixtime = watch_utility_date_time_to_unix_time(timestamp, movement_get_current_timezone_offset());
-        unixtime -= 86400 * state->display_index;
-        timestamp = watch_utility_date_time_from_unix_time(unixtime, movement_get_current_timezone_offset());    
-
-        // display date
-        snprintf(buf, 8, "%2d", timestamp.unit.day);
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-
-        if (pos < 0) {
-            // no data at this index
+        uint16_t count = tslog_count(TSLOG_ACTIVITY);
+
+        if (state->display_index > count) {
+            // no data at this index; get day of month for today - display_index
+            uint32_t unixtime = watch_utility_date_time_to_unix_time(timestamp, movement_get_current_timezone_offset());
+            unixtime -= 86400 * state->display_index;
+            timestamp = watch_utility_date_time_from_unix_time(unixtime, movement_get_current_timezone_offset());
+            snprintf(buf, 8, "%2d", timestamp.unit.day);
+            watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
             watch_display_text(WATCH_POSITION_BOTTOM, "no dat");
         } else {
+            // the log goes oldest first, so skip every day newer than the one on display.
+            activity_logging_lookup_t lookup = { .skip = count - state->display_index };
+            tslog_iterate_since(TSLOG_ACTIVITY, 0, _activity_logging_face_find_record, &lookup);
+
+            // each day is logged at the midnight that ends it, so a minute earlier is still that day.
+            timestamp = watch_utility_date_time_from_unix_time(lookup.record.timestamp - 60, movement_get_current_timezone_offset());
+            snprintf(buf, 8, "%2d", timestamp.unit.day);
+            watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+
             // we are displaying the number active minutes
-            snprintf(buf, 8, "%4d  ", state->activity_log[pos]);
+            snprintf(buf, 8, "%4d  ", lookup.record.value);
             watch_display_text(WATCH_POSITION_BOTTOM, buf);
         }
     }
 }
 
 void activity_logging_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
+    // the log itself is only shuffled at midnight, but active minutes are counted in advise, so we need it every minute.
+    movement_wake_intent_t intent = { .type = MOVEMENT_WAKE_EVERY_MINUTE };
+    movement_set_wake_intent(watch_face_index, intent);
+
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(activity_logging_state_t));
+        *context_ptr = movement_context_alloc(sizeof(activity_logging_state_t));
         memset(*context_ptr, 0, sizeof(activity_logging_state_t));
         // At first run, tell Movement to run the accelerometer in the background. It will now run at this rate forever.
         movement_set_accelerometer_background_rate(LIS2DW_DATA_RATE_LOWEST);
@@ -90,11 +123,11 @@ bool activity_logging_face_loop(movement_event_t event, void *context) {
             movement_illuminate_led();
             break;
         case EVENT_LIGHT_BUTTON_DOWN:
-            state->display_index = (state->display_index + ACTIVITY_LOGGING_NUM_DAYS - 1) % ACTIVITY_LOGGING_NUM_DAYS;
+            state->display_index = (state->display_index + _activity_logging_face_num_days() - 1) % _activity_logging_face_num_days();
             _activity_logging_face_update_display(state);
             break;
         case EVENT_ALARM_BUTTON_DOWN:
-            state->display_index = (state->display_index + 1) % ACTIVITY_LOGGING_NUM_DAYS;
+            state->display_index = (state->display_index + 1) % _activity_logging_face_num_days();
             // fall through
         case EVENT_ACTIVATE:
             if (watch_sleep_animation_is_running()) {
@@ -110,12 +143,14 @@ bool activity_logging_face_loop(movement_event_t event, void *context) {
             }
             break;
         case EVENT_BACKGROUND_TASK:
-            {
-                size_t pos = state->data_points % ACTIVITY_LOGGING_NUM_DAYS;
-                state->activity_log[pos] = state->active_minutes_today;
-                state->data_points++;
-                state->active_minutes_today = 0;
+            // a page holds more than a week of records, so it's written out once a week rather than once a day:
+            // a page per day would have the log go back little more than two weeks.
+            tslog_append(TSLOG_ACTIVITY, movement_get_utc_timestamp(), state->active_minutes_today);
+            if (++state->days_unflushed == ACTIVITY_LOGGING_DAYS_PER_FLUSH) {
+                tslog_flush(TSLOG_ACTIVITY);
+                state->days_unflushed = 0;
             }
+            state->active_minutes_today = 0;
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             // start tick animation if necessary
@@ -30,7 +30,11 @@
  * ACTIVITY LOGGING
  *
  * This watch face works with Movement's built-in tracking of accelerometer state to log activity over time.
- * The watch face shows the number of active minutes counted for each of the last 14 days. Layout:
+ * The watch face shows the number of active minutes counted for each day, and writes them to storage that survives
+ * a reset a week at a time; the days since the last write, up to six of them, are lost on reset. The log holds 16
+ * weeks; when it fills up, the oldest four are dropped at once, so it goes back between 84 and 112 days, plus the
+ * days not yet written. A filesystem from older firmware that was too full to be shrunk keeps the log from being
+ * stored until it is formatted. Layout:
  *
  *  - Top left is display title (ACT or AC for Activity)
  *  - Top right is the day of the month corresponding to the data point shown on screen.
@@ -39,7 +43,7 @@
  *    that the accelerometer sensor is sensing, and the watch face is still counting today's active minutes.
  *
  * A short press of the Alarm button moves backwards in the data log, showing yesterday's active minutes,
- * then the day before, etc. going back 14 days.
+ * then the day before, etc. going back to the oldest day in the log.
  * A short press of the Light button moves forward in the data log, looping around if we're on the most-recent day.
  * Holding the Light button will illuminate the display.
  *
@@ -48,14 +52,11 @@
 #include "movement.h"
 #include "watch.h"
 
-#define ACTIVITY_LOGGING_NUM_DAYS (14)
-
 typedef struct {
-    uint16_t activity_log[ACTIVITY_LOGGING_NUM_DAYS];   // the activity log
-    uint16_t data_points;                               // the number of days logged
-    uint8_t display_index;                              // the index we are displaying on screen
+    uint16_t display_index;                             // the index we are displaying on screen; 0 is today
     uint16_t active_minutes_today;                      // the number of active minutes logged today
     bool previous_minute_was_active;                    // we only want to count two or more consecutive active minutes
+    uint8_t days_unflushed;                             // days logged since the log was last written out
 } activity_logging_state_t;
 
 void activity_logging_face_setup(uint8_t watch_face_index, void ** context_ptr);
@@ -26,35 +26,60 @@
 #include <string.h>
 #include "temperature_logging_face.h"
 #include "watch.h"
+#include "watch_utility.h"
+#include "tslog.h"
 
 static bool skip = false;
 
-static void _temperature_logging_face_log_data(temperature_logging_state_t *logger_state) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-    size_t pos = logger_state->data_points % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
+static void _temperature_logging_face_log_data(void) {
+    // the log keeps hundredths of a degree.
+    float temperature_c = movement_get_temperature();
+    int16_t value = (int16_t)(temperature_c * 100.0f + (temperature_c < 0 ? -0.5f : 0.5f));
 
-    logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = movement_get_temperature();
-    logger_state->data_points++;
+    tslog_append(TSLOG_TEMPERATURE, movement_get_utc_timestamp(), value);
+}
+
+typedef struct {
+    uint16_t skip;
+    tslog_record_t record;
+} temperature_logging_lookup_t;
+
+static bool _temperature_logging_face_find_record(const tslog_record_t *record, void *context) {
+    temperature_logging_lookup_t *lookup = (temperature_logging_lookup_t *)context;
+    if (lookup->skip) {
+        lookup->skip--;
+        return true;
+    }
+    lookup->record = *record;
+
+    return false;
 }
 
 static void _temperature_logging_face_update_display(temperature_logging_state_t *logger_state, bool in_fahrenheit, bool clock_mode_24h) {
-    int8_t pos = (logger_state->data_points - 1 - logger_state->display_index) % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
+    uint16_t count = tslog_count(TSLOG_TEMPERATURE);
+    temperature_logging_lookup_t lookup;
     char buf[7];
 
     watch_clear_indicator(WATCH_INDICATOR_24H);
     watch_clear_indicator(WATCH_INDICATOR_PM);
     watch_clear_colon();
 
-    if (pos < 0) {
+    if (logger_state->display_index >= count) {
         // no data at this index
         watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LOG", "TL");
         watch_display_text(WATCH_POSITION_BOTTOM, "no dat");
-        sprintf(buf, "%2d", logger_state->display_index);
+        sprintf(buf, "%2d", logger_state->display_index % 100);
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-    } else if (logger_state->ts_ticks) {
+        return;
+    }
+
+    // the log goes oldest first, so skip everything newer than the reading on display.
+    lookup.skip = count - 1 - logger_state->display_index;
+    tslog_iterate_since(TSLOG_TEMPERATURE, 0, _temperature_logging_face_find_record, &lookup);
+
+    if (logger_state->ts_ticks) {
         // we are displaying the timestamp in response to a button press
-        watch_date_time_t date_time = logger_state->data[pos].timestamp;
+        watch_date_time_t date_time = watch_utility_date_time_from_unix_time(lookup.record.timestamp, movement_get_current_timezone_offset());
         watch_set_colon();
         if (clock_mode_24h) {
             watch_set_indicator(WATCH_INDICATOR_24H);
@@ -71,24 +96,27 @@ static void _temperature_logging_face_update_display(temperature_logging_state_t
     } else {
         // we are displaying the temperature
         watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LOG", "TL");
-        sprintf(buf, "%2d", logger_state->display_index);
+        sprintf(buf, "%2d", logger_state->display_index % 100);
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+        float temperature_c = lookup.record.value / 100.0f;
         if (in_fahrenheit) {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c * 1.8 + 32.0, "#F");
+            watch_display_float_with_best_effort(temperature_c * 1.8 + 32.0, "#F");
         } else {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c, "#C");
+            watch_display_float_with_best_effort(temperature_c, "#C");
         }
     }
 }
 
 void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
+    // we only log once an hour, so we only need to be advised at the top of the hour.
+    movement_wake_intent_t intent = { .type = MOVEMENT_WAKE_TOP_OF_HOUR };
+    movement_set_wake_intent(watch_face_index, intent);
 
     // if temperature is invalid, we don't have a temperature sensor which means we shouldn't be here.
     if (movement_get_temperature() == 0xFFFFFFFF) skip = true;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(temperature_logging_state_t));
+        *context_ptr = movement_context_alloc(sizeof(temperature_logging_state_t));
         memset(*context_ptr, 0, sizeof(temperature_logging_state_t));
     }
 }
@@ -113,8 +141,16 @@ bool temperature_logging_face_loop(movement_event_t event, void *context) {
             logger_state->ts_ticks = 2;
             _temperature_logging_face_update_display(logger_state, movement_use_imperial_units(), movement_clock_mode_24h());
             break;
+        case EVENT_ALARM_LONG_PRESS:
+            // the button down already went back one reading; go back the rest of the day.
+            logger_state->display_index += 23;
+            if (logger_state->display_index >= tslog_count(TSLOG_TEMPERATURE)) logger_state->display_index = 0;
+            logger_state->ts_ticks = 0;
+            _temperature_logging_face_update_display(logger_state, movement_use_imperial_units(), movement_clock_mode_24h());
+            break;
         case EVENT_ALARM_BUTTON_DOWN:
-            logger_state->display_index = (logger_state->display_index + 1) % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
+            logger_state->display_index++;
+            if (logger_state->display_index >= tslog_count(TSLOG_TEMPERATURE)) logger_state->display_index = 0;
             logger_state->ts_ticks = 0;
             // fall through
         case EVENT_ACTIVATE:
@@ -130,7 +166,7 @@ bool temperature_logging_face_loop(movement_event_t event, void *context) {
             }
             break;
         case EVENT_BACKGROUND_TASK:
-            _temperature_logging_face_log_data(logger_state);
+            _temperature_logging_face_log_data();
             break;
         default:
             movement_default_loop_handler(event);
@@ -148,9 +184,9 @@ movement_watch_face_advisory_t temperature_logging_face_advise(void *context) {
     (void) context;
     movement_watch_face_advisory_t retval = { 0 };
 
-    // this will get called at the top of each minute, so all we check is if we're at the top of the hour as well.
-    // if we are, we ask for a background task.
-    retval.wants_background_task = watch_rtc_get_date_time().unit.minute == 0;
+    // the wake intent has us called at the top of the local hour, which in some time zones isn't the top of the
+    // UTC hour; check the same clock, in case we're called late after the time was set.
+    retval.wants_background_task = movement_get_local_date_time().unit.minute == 0;
 
     return retval;
 }
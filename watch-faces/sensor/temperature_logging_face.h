@@ -30,18 +30,23 @@
  * THERMISTOR LOGGING (aka Temperature Log)
  *
  * This watch face automatically logs the temperature once an hour, and
- * maintains a 36-hour log of readings. This watch face is admittedly rather
- * complex, and bears some explanation.
+ * keeps the readings in storage that survives a reset. The log holds 360
+ * readings, about 15 days; when it fills up, the oldest 36 readings are
+ * dropped at once, so right after that it goes back 13 and a half days.
+ * Readings are stored nine at a time, so a reset loses up to the last
+ * eight hours. A filesystem from older firmware that was too full to be
+ * shrunk keeps the log from being stored until it is formatted.
+ * This watch face is admittedly rather complex, and bears some explanation.
  *
  * The main display shows the letters “TL” in the top left, indicating the
  * name of the watch face. At the top right, it displays the index of the
  * reading; 0 represents the most recent reading taken, 1 represents one
- * hour earlier, etc. The bottom line in this mode displays the logged
- * temperature.
+ * hour earlier, etc. Past 99, only the last two digits of the index fit.
+ * The bottom line in this mode displays the logged temperature.
  *
- * A short press of the “Alarm” button advances to the next oldest reading;
- * you will see the number at the top right advance from 0 to 1 to 2, all
- * the way to 35, the oldest reading available.
+ * A short press of the “Alarm” button advances to the next oldest reading,
+ * wrapping back around to the newest after the oldest one available. A long
+ * press of the “Alarm” button jumps back a whole day, or 24 readings.
  *
  * A short press of the “Light” button will briefly display the timestamp
  * of the reading. The letters at the top left will display the word “At”,
@@ -57,18 +62,9 @@
 #include "movement.h"
 #include "watch.h"
 
-#define TEMPERATURE_LOGGING_NUM_DATA_POINTS (36)
-
-typedef struct {
-    watch_date_time_t timestamp;
-    float temperature_c;
-} thermistor_logger_data_point_t;
-
 typedef struct {
-    uint8_t display_index;  // the index we are displaying on screen
+    uint16_t display_index; // the index we are displaying on screen, counting back from the most recent reading
     uint8_t ts_ticks;       // when the user taps the LIGHT button, we show the timestamp for a few ticks.
-    int32_t data_points;    // the absolute number of data points logged
-    thermistor_logger_data_point_t data[TEMPERATURE_LOGGING_NUM_DATA_POINTS];
 } temperature_logging_state_t;
 
 void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_ptr);
@@ -37,7 +37,6 @@ int8_t finetune_page;
 void finetune_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
     (void) context_ptr;
-    // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
 void finetune_face_activate(void *context) {
@@ -100,6 +99,7 @@ static void finetune_adjust_subseconds(int delta) {
     else
         total_adjustment += delta;
     finetune_update_display();
+    watch_display_commit();
 
     // Then delay clock
     watch_rtc_enable(false);
@@ -70,18 +70,40 @@ static void _handle_alarm_button(watch_date_time_t date_time, uint8_t current_pa
 static void _abort_quick_ticks() {
     if (_quick_ticks_running) {
         _quick_ticks_running = false;
-        movement_request_tick_frequency(4);
+        movement_request_tick_frequency(1);
     }
 }
 
+static void _blink_current_page(uint8_t current_page, bool restart) {
+    // blink up the parameter we're setting, but hold it steady while it's racing ahead
+    uint16_t positions = 0;
+    if (!_quick_ticks_running) {
+        switch (current_page) {
+            case 0:
+            case 4:
+                positions = WATCH_BLINK_HOURS;
+                break;
+            case 1:
+            case 5:
+                positions = WATCH_BLINK_MINUTES;
+                break;
+            case 2:
+            case 6:
+                positions = WATCH_BLINK_SECONDS;
+                break;
+        }
+    }
+    watch_blink_positions(positions, 500);
+    if (restart) watch_restart_blink_positions();
+}
+
 void set_time_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
-    if (*context_ptr == NULL) *context_ptr = malloc(sizeof(uint8_t));
+    if (*context_ptr == NULL) *context_ptr = movement_context_alloc(sizeof(uint8_t));
 }
 
 void set_time_face_activate(void *context) {
     *((uint8_t *)context) = 0;
-    movement_request_tick_frequency(4);
     _quick_ticks_running = false;
     current_offset = movement_get_current_timezone_offset();
 }
@@ -131,7 +153,7 @@ bool set_time_face_loop(movement_event_t event, void *context) {
         watch_display_text(WATCH_POSITION_TOP_RIGHT, " Z");
         if (current_offset < 0) watch_display_text(WATCH_POSITION_TOP_LEFT, "- ");
         else watch_display_text(WATCH_POSITION_TOP_LEFT, "* ");
-        if (event.subsecond % 2) {
+        if (date_time.unit.second % 2) {
             uint8_t hours = abs(current_offset) / 3600;
             uint8_t minutes = (abs(current_offset) % 3600) / 60;
 
@@ -159,24 +181,7 @@ bool set_time_face_loop(movement_event_t event, void *context) {
     }
 
     watch_display_text(WATCH_POSITION_BOTTOM, buf);
-
-    // blink up the parameter we're setting
-    if (event.subsecond % 2 && !_quick_ticks_running) {
-        switch (current_page) {
-            case 0:
-            case 4:
-                watch_display_text(WATCH_POSITION_HOURS, "  ");
-                break;
-            case 1:
-            case 5:
-                watch_display_text(WATCH_POSITION_MINUTES, "  ");
-                break;
-            case 2:
-            case 6:
-                watch_display_text(WATCH_POSITION_SECONDS, "  ");
-                break;
-        }
-    }
+    _blink_current_page(current_page, event.event_type == EVENT_ALARM_BUTTON_UP);
 
     return true;
 }
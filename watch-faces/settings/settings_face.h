@@ -79,7 +79,7 @@
 #include "movement.h"
 
 typedef struct {
-    void (*display)(uint8_t subsecond);
+    void (*display)(void);
     void (*advance)();
 } settings_screen_t;
 
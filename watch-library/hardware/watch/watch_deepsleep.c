@@ -36,8 +36,15 @@ void sleep(const uint8_t mode) {
     // SLEEPCFG register reads the wanted value before issuing WFI instruction."
     while(PM->SLEEPCFG.bit.SLEEPMODE != mode);
 
+    watch_wakelog_arm();
+
     __DSB();
 	__WFI();
+
+    // the interrupt that woke us has run by now; if it didn't record a cause, it came from a handler we don't own.
+    if (watch_wakelog_is_armed()) {
+        watch_wakelog_record(USB->DEVICE.CTRLA.bit.ENABLE ? WATCH_WAKE_CAUSE_USB : WATCH_WAKE_CAUSE_OTHER, 0);
+    }
 }
 
 void watch_register_extwake_callback(uint8_t pin, watch_cb_t callback, bool level) {
@@ -163,6 +170,12 @@ static void _watch_disable_all_peripherals_except_slcd(void) {
 }
 
 void watch_enter_sleep_mode(void) {
+    // the display stays on while we sleep, so make sure it shows the latest frame.
+    watch_display_commit();
+
+    // standby would stop a queued storage write partway, so wait in idle sleep for the NVM to finish first.
+    watch_storage_sync();
+
     // disable all other peripherals
     _watch_disable_all_peripherals_except_slcd();
 
@@ -61,6 +61,7 @@ void watch_register_interrupt_callback(const uint8_t pin, watch_cb_t callback, e
 }
 
 void watch_eic_callback(uint8_t channel) {
+    watch_wakelog_record(WATCH_WAKE_CAUSE_EIC, channel);
     if (eic_callbacks[channel] != NULL) {
         eic_callbacks[channel]();
     }
@@ -83,6 +83,9 @@ void _watch_init(void) {
     // External wake depends on RTC; calendar is a required module.
     _watch_rtc_init();
 
+    // the wake log timestamps its entries with the RTC counter, so it comes up after the RTC.
+    watch_wakelog_init(RSTC->RCAUSE.reg);
+
     // set up state
     btn_alarm_callback = NULL;
     a2_callback = NULL;
@@ -44,16 +44,14 @@ static const int TB_BKUP_REG = 7;
 
 #define WATCH_RTC_N_COMP_CB 8
 
-typedef struct {
-    volatile uint32_t counter;
-    volatile watch_cb_t callback;
-    volatile bool enabled;
-} comp_cb_t;
-
 volatile uint32_t scheduled_comp_counter;
 
 watch_cb_t tick_callbacks[8];
-comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
+// the indexed comp callbacks are just timers whose memory we own
+static watch_rtc_comp_t comp_slots[WATCH_RTC_N_COMP_CB];
+static watch_cb_t comp_slot_callbacks[WATCH_RTC_N_COMP_CB];
+// all registered timers, sorted by target counter
+static watch_rtc_comp_t *volatile comp_head;
 watch_cb_t alarm_callback;
 watch_cb_t btn_alarm_callback;
 watch_cb_t a2_callback;
@@ -74,10 +72,10 @@ void _watch_rtc_init(void) {
     rtc_configure_callback(watch_rtc_callback);
 
     for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        comp_callbacks[index].counter = 0;
-        comp_callbacks[index].callback = NULL;
-        comp_callbacks[index].enabled = false;
+        comp_slots[index].enabled = false;
+        comp_slot_callbacks[index] = NULL;
     }
+    comp_head = NULL;
 
     scheduled_comp_counter = 0;
 
@@ -90,19 +88,9 @@ void watch_rtc_set_date_time(rtc_date_time_t date_time) {
 }
 
 rtc_date_time_t watch_rtc_get_date_time(void) {
-    static struct {
-        unix_timestamp_t timestamp;
-        rtc_date_time_t datetime;
-    } cached_date_time = {.datetime.reg=0, .timestamp=0};
-
-    unix_timestamp_t timestamp = watch_rtc_get_unix_time();
-
-    if (timestamp != cached_date_time.timestamp) {
-        cached_date_time.timestamp = timestamp;
-        cached_date_time.datetime = watch_utility_date_time_from_unix_time(timestamp, 0);
-    }
+    static watch_date_time_cache_t cached_date_time = {0};
 
-    return cached_date_time.datetime;
+    return watch_utility_date_time_from_unix_time_cached(&cached_date_time, watch_rtc_get_unix_time(), 0);
 }
 
 void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
@@ -127,8 +115,11 @@ void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
 }
 
 unix_timestamp_t watch_rtc_get_unix_time(void) {
+    return watch_rtc_get_unix_time_at_counter(rtc_get_counter());
+}
+
+unix_timestamp_t watch_rtc_get_unix_time_at_counter(rtc_counter_t counter) {
     // unix_time = time_backup + counter / RTC_CNT_HZ - 0.5
-    rtc_counter_t counter = rtc_get_counter();
     unix_timestamp_t tb = watch_get_backup_data(TB_BKUP_REG);
     return tb + (counter >> RTC_CNT_DIV) + ((counter & RTC_CNT_SUBSECOND_MASK) >> (RTC_CNT_DIV - 1)) - 1;
 }
@@ -211,33 +202,61 @@ void watch_rtc_disable_all_periodic_callbacks(void) {
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 }
 
+// The comp list is modified both from thread mode and from interrupts, so mask them while we work on it.
+static inline uint32_t _watch_rtc_comp_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void _watch_rtc_comp_unlock(uint32_t primask) {
+    __set_PRIMASK(primask);
+}
+
+static void _watch_rtc_comp_unlink(watch_rtc_comp_t *comp) {
+    if (!comp->enabled) return;
+
+    watch_rtc_comp_t *volatile *link = &comp_head;
+    while (*link != comp) {
+        link = &(*link)->next;
+    }
+    *link = comp->next;
+    comp->enabled = false;
+}
+
+static void _watch_rtc_comp_insert(watch_rtc_comp_t *comp, rtc_counter_t counter) {
+    // compare relative to each other rather than to now, which is fine as long as all targets are within half the counter range.
+    watch_rtc_comp_t *volatile *link = &comp_head;
+    while (*link != NULL && (int32_t)((*link)->counter - counter) <= 0) {
+        link = &(*link)->next;
+    }
+    comp->counter = counter;
+    comp->next = *link;
+    comp->enabled = true;
+    *link = comp;
+}
+
+static void _watch_rtc_comp_slot_fired(void *context) {
+    watch_cb_t callback = *(watch_cb_t *)context;
+    if (callback != NULL) callback();
+}
+
 void watch_rtc_schedule_next_comp(void) {
+    uint32_t primask = _watch_rtc_comp_lock();
     rtc_counter_t curr_counter = watch_rtc_get_counter();
 
     // We want to ensure we never miss any registered callbacks,
     // so if a callback counter has just passed but didn't fire, give it a chance to fire.
     rtc_counter_t lax_curr_counter = curr_counter - RTC_COMP_GRACE_PERIOD;
 
-    bool schedule_any = false;
-    rtc_counter_t comp_counter;
-    rtc_counter_t min_diff = UINT_MAX;
+    if (comp_head != NULL) {
+        // the list is sorted, so the next comp is always at the front of the line.
+        rtc_counter_t comp_counter = comp_head->counter;
 
-    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        if (comp_callbacks[index].enabled) {
-            rtc_counter_t diff = comp_callbacks[index].counter - lax_curr_counter;
-            if (diff <= min_diff) {
-                min_diff = diff;
-                comp_counter = comp_callbacks[index].counter;
-                schedule_any = true;
-            }
-        }
-    }
-
-    if (schedule_any) {
         // If we are changing the comp counter at the front of the line, don't schedule a comp interrupt for a counter that is too close to now
         if (comp_counter != scheduled_comp_counter) {
             rtc_counter_t earliest_comp_counter = curr_counter + RTC_COMP_GRACE_PERIOD;
-            if ((earliest_comp_counter - lax_curr_counter) > (comp_counter - lax_curr_counter)) {
+            if ((int32_t)(comp_counter - earliest_comp_counter) < 0) {
                 comp_counter = earliest_comp_counter;
             }
             scheduled_comp_counter = comp_counter;
@@ -247,6 +266,27 @@ void watch_rtc_schedule_next_comp(void) {
         scheduled_comp_counter = lax_curr_counter - RTC_COMP_GRACE_PERIOD;
         rtc_disable_compare_interrupt();
     }
+
+    _watch_rtc_comp_unlock(primask);
+}
+
+void watch_rtc_register_comp(watch_rtc_comp_t *comp, watch_rtc_comp_cb_t callback, void *context, rtc_counter_t counter) {
+    uint32_t primask = _watch_rtc_comp_lock();
+    _watch_rtc_comp_unlink(comp);
+    comp->callback = callback;
+    comp->context = context;
+    _watch_rtc_comp_insert(comp, counter);
+    _watch_rtc_comp_unlock(primask);
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_disable_comp(watch_rtc_comp_t *comp) {
+    uint32_t primask = _watch_rtc_comp_lock();
+    _watch_rtc_comp_unlink(comp);
+    _watch_rtc_comp_unlock(primask);
+
+    watch_rtc_schedule_next_comp();
 }
 
 void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
@@ -254,10 +294,7 @@ void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter
         return;
     }
 
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
-
+    watch_rtc_register_comp_callback_no_schedule(callback, counter, index);
     watch_rtc_schedule_next_comp();
 }
 
@@ -266,9 +303,13 @@ void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_count
         return;
     }
 
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
+    uint32_t primask = _watch_rtc_comp_lock();
+    _watch_rtc_comp_unlink(&comp_slots[index]);
+    comp_slot_callbacks[index] = callback;
+    comp_slots[index].callback = _watch_rtc_comp_slot_fired;
+    comp_slots[index].context = &comp_slot_callbacks[index];
+    _watch_rtc_comp_insert(&comp_slots[index], counter);
+    _watch_rtc_comp_unlock(primask);
 }
 
 void watch_rtc_disable_comp_callback(uint8_t index) {
@@ -276,8 +317,7 @@ void watch_rtc_disable_comp_callback(uint8_t index) {
         return;
     }
 
-    comp_callbacks[index].enabled = false;
-
+    watch_rtc_disable_comp_callback_no_schedule(index);
     watch_rtc_schedule_next_comp();
 }
 
@@ -286,7 +326,23 @@ void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
         return;
     }
 
-    comp_callbacks[index].enabled = false;
+    uint32_t primask = _watch_rtc_comp_lock();
+    _watch_rtc_comp_unlink(&comp_slots[index]);
+    _watch_rtc_comp_unlock(primask);
+}
+
+static void _watch_rtc_record_wake(uint16_t interrupt_cause) {
+    if (interrupt_cause & RTC_MODE0_INTFLAG_PER_Msk) {
+        watch_wakelog_record(WATCH_WAKE_CAUSE_RTC_PER, interrupt_cause & RTC_MODE0_INTFLAG_PER_Msk);
+    } else if (interrupt_cause & RTC_MODE0_INTFLAG_TAMPER) {
+        watch_wakelog_record(WATCH_WAKE_CAUSE_RTC_TAMPER, RTC->MODE0.TAMPID.reg);
+    } else if (interrupt_cause & RTC_MODE0_INTFLAG_CMP0) {
+        uint8_t slot = 0xFF;
+        if (comp_head >= comp_slots && comp_head < comp_slots + WATCH_RTC_N_COMP_CB) slot = comp_head - comp_slots;
+        watch_wakelog_record(WATCH_WAKE_CAUSE_RTC_CMP, slot);
+    } else if (interrupt_cause & RTC_MODE0_INTFLAG_OVF) {
+        watch_wakelog_record(WATCH_WAKE_CAUSE_RTC_OVF, 0);
+    }
 }
 
 void watch_rtc_callback(uint16_t interrupt_cause) {
@@ -294,6 +350,8 @@ void watch_rtc_callback(uint16_t interrupt_cause) {
     rtc_counter_t curr_counter = watch_rtc_get_counter();
     uint16_t interrupt_enabled = (uint16_t)RTC->MODE0.INTENSET.reg;
 
+    _watch_rtc_record_wake(interrupt_cause & interrupt_enabled);
+
     if ((interrupt_cause & interrupt_enabled) & RTC_MODE0_INTFLAG_PER_Msk) {
         // handle the tick callback first, it's what we do the most.
         // start from PER7, the 1 Hz tick.
@@ -320,13 +378,11 @@ void watch_rtc_callback(uint16_t interrupt_cause) {
     }
 
     if ((interrupt_cause & interrupt_enabled) & RTC_MODE0_INTFLAG_CMP0) {
-        for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-            if (comp_callbacks[index].enabled &&
-                (curr_counter - comp_callbacks[index].counter) < (RTC_COMP_GRACE_PERIOD * 4)
-            ) {
-                comp_callbacks[index].enabled = false;
-                comp_callbacks[index].callback();
-            }
+        // fire everything that is due, from the front of the line. A callback may register its timer again.
+        while (comp_head != NULL && (int32_t)(curr_counter - comp_head->counter) >= 0) {
+            watch_rtc_comp_t *comp = comp_head;
+            _watch_rtc_comp_unlink(comp);
+            comp->callback(comp->context);
         }
         watch_rtc_schedule_next_comp();
     }
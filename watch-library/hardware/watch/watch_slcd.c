@@ -23,6 +23,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "delay.h"
 #include "usb.h"
 #include "pins.h"
@@ -40,6 +41,37 @@ static uint16_t _slcd_fc_min_ms_bypass = 0;
 
 static watch_lcd_type_t _installed_display = WATCH_LCD_TYPE_UNKNOWN;
 
+/* Shadow copy of the SDATAL registers (segments 0-31 of each COM; the display doesn't use the high segments).
+   The drawing functions only touch the shadow, and watch_display_commit copies the COMs that differ from what the
+   SLCD holds, so a face that redraws the same text every tick costs no register writes at all.
+*/
+#define WATCH_SLCD_NUM_COMS (8)
+
+static uint32_t _slcd_shadow[WATCH_SLCD_NUM_COMS];
+static uint32_t _slcd_committed[WATCH_SLCD_NUM_COMS];
+static uint8_t _slcd_dirty_coms = 0;
+static uint32_t _slcd_segment_writes = 0;
+static uint32_t _slcd_register_writes = 0;
+
+static uint32_t _slcd_blink_masks[WATCH_SLCD_NUM_COMS];  // segments hidden during the off half of the blink
+static uint8_t _slcd_blink_coms = 0;
+static rtc_counter_t _slcd_blink_half_period = 0;
+static uint16_t _slcd_blink_positions = 0;
+static uint32_t _slcd_blink_period = 0;
+static rtc_counter_t _slcd_blink_next = 0;
+static volatile bool _slcd_blink_off = false;
+static volatile bool _slcd_blink_toggled = false;
+static watch_rtc_comp_t _slcd_blink_comp;
+
+static volatile bool _slcd_seconds_due = false;
+static rtc_counter_t _slcd_seconds_next = 0;
+static watch_rtc_comp_t _slcd_seconds_comp;
+
+static volatile uint32_t *_slcd_sdatal(uint8_t com) {
+    // SDATALx and SDATAHx are interleaved, so the SDATAL registers are 8 bytes apart.
+    return &(&SLCD->SDATAL0.reg)[com * 2];
+}
+
 /// NOTE: The function below was commented out because LCD autodetection proved unreliable.
 /// While I would love to fix it, I can't figure it out in time for the product launch.
 /// Instead, this function simply implements the failsafe: red LED glows until one of two
@@ -250,6 +282,9 @@ void watch_enable_display(void) {
     _slcd_fc_min_ms_bypass = 32 * (1000 / _slcd_framerate);
 
     slcd_clear();
+    memset(_slcd_shadow, 0, sizeof(_slcd_shadow));
+    memset(_slcd_committed, 0, sizeof(_slcd_committed));
+    _slcd_dirty_coms = 0;
 
     if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
         slcd_set_contrast(0);
@@ -264,16 +299,152 @@ void watch_disable_display(void) {
     slcd_disable();
 }
 
-inline void watch_set_pixel(uint8_t com, uint8_t seg) {
-    slcd_set_segment(com, seg);
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    _slcd_shadow[com] |= (1ul << seg);
+    _slcd_dirty_coms |= (1 << com);
+    _slcd_segment_writes++;
 }
 
-inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    slcd_clear_segment(com, seg);
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    _slcd_shadow[com] &= ~(1ul << seg);
+    _slcd_dirty_coms |= (1 << com);
+    _slcd_segment_writes++;
+}
+
+void watch_update_pixels(uint8_t com, uint32_t clear_mask, uint32_t set_mask) {
+    _slcd_shadow[com] = (_slcd_shadow[com] & ~clear_mask) | set_mask;
+    _slcd_dirty_coms |= (1 << com);
+    _slcd_segment_writes += __builtin_popcount(clear_mask | set_mask);
 }
 
 void watch_clear_display(void) {
-    slcd_clear();
+    memset(_slcd_shadow, 0, sizeof(_slcd_shadow));
+    _slcd_dirty_coms = (1 << WATCH_SLCD_NUM_COMS) - 1;
+}
+
+static void _slcd_display_seconds(void);
+
+void watch_display_commit(void) {
+    if (_slcd_seconds_due) {
+        _slcd_seconds_due = false;
+        _slcd_display_seconds();
+    }
+    if (_slcd_blink_toggled) {
+        _slcd_blink_toggled = false;
+        _slcd_dirty_coms |= _slcd_blink_coms;
+    }
+    if (!_slcd_dirty_coms) return;
+    bool blink_off = _slcd_blink_off;
+
+    // While the shadow memory is locked, the SLCD keeps showing the previous frame; it picks up all of the new
+    // data at the start of the first frame after the unlock, so a half-written frame never makes it to the glass.
+    SLCD->CTRLC.bit.LOCK = 1;
+    for (uint8_t com = 0; com < WATCH_SLCD_NUM_COMS; com++) {
+        if (!(_slcd_dirty_coms & (1 << com))) continue;
+        uint32_t value = blink_off ? _slcd_shadow[com] & ~_slcd_blink_masks[com] : _slcd_shadow[com];
+        if (value != _slcd_committed[com]) {
+            *_slcd_sdatal(com) = value;
+            _slcd_committed[com] = value;
+            _slcd_register_writes++;
+        }
+    }
+    SLCD->CTRLC.bit.LOCK = 0;
+
+    _slcd_dirty_coms = 0;
+}
+
+// Called from the RTC interrupt: only flip the phase here, watch_display_commit applies it from the main loop.
+static void _slcd_blink_fired(void *context) {
+    (void) context;
+    _slcd_blink_off = !_slcd_blink_off;
+    _slcd_blink_toggled = true;
+    _slcd_blink_next += _slcd_blink_half_period;
+    watch_rtc_register_comp(&_slcd_blink_comp, _slcd_blink_fired, NULL, _slcd_blink_next);
+}
+
+void watch_blink_positions(uint16_t positions, uint32_t period) {
+    if (positions == _slcd_blink_positions && period == _slcd_blink_period) return;
+    _slcd_blink_positions = positions;
+    _slcd_blink_period = period;
+
+    watch_rtc_disable_comp(&_slcd_blink_comp);
+    _slcd_blink_off = false;
+    _slcd_blink_coms = 0;
+    memset(_slcd_blink_masks, 0, sizeof(_slcd_blink_masks));
+
+    _slcd_blink_half_period = (period * watch_rtc_get_frequency()) / 2000;
+    if (_slcd_blink_half_period) {
+        for (uint8_t position = 0; position < 16; position++) {
+            if (!(positions & (1 << position))) continue;
+            for (uint8_t com = 0; com < WATCH_SLCD_NUM_COMS; com++) {
+                _slcd_blink_masks[com] |= _watch_get_position_segments(position, com);
+            }
+        }
+        for (uint8_t com = 0; com < WATCH_SLCD_NUM_COMS; com++) {
+            if (_slcd_blink_masks[com]) _slcd_blink_coms |= (1 << com);
+        }
+    }
+
+    // segments that were hidden by the previous blink have to come back on.
+    _slcd_dirty_coms = (1 << WATCH_SLCD_NUM_COMS) - 1;
+
+    if (_slcd_blink_coms) {
+        _slcd_blink_next = watch_rtc_get_counter() + _slcd_blink_half_period;
+        watch_rtc_register_comp(&_slcd_blink_comp, _slcd_blink_fired, NULL, _slcd_blink_next);
+    }
+}
+
+void watch_restart_blink_positions(void) {
+    if (!_slcd_blink_coms) return;
+
+    watch_rtc_disable_comp(&_slcd_blink_comp);
+    if (_slcd_blink_off) {
+        _slcd_blink_off = false;
+        _slcd_dirty_coms |= _slcd_blink_coms;
+    }
+    _slcd_blink_next = watch_rtc_get_counter() + _slcd_blink_half_period;
+    watch_rtc_register_comp(&_slcd_blink_comp, _slcd_blink_fired, NULL, _slcd_blink_next);
+}
+
+static rtc_counter_t _slcd_next_second(rtc_counter_t counter) {
+    // the RTC's seconds roll over halfway through each second of the counter (see watch_rtc_set_unix_time).
+    uint32_t freq = watch_rtc_get_frequency();
+    return ((counter + freq / 2) / freq + 1) * freq - freq / 2;
+}
+
+static void _slcd_display_seconds(void) {
+    uint8_t second = watch_rtc_get_unix_time() % 60;
+    watch_display_character_lp_seconds('0' + second / 10, 8);
+    watch_display_character_lp_seconds('0' + second % 10, 9);
+}
+
+// Called from the RTC interrupt like the blink: the digits are drawn by watch_display_commit from the main loop.
+static void _slcd_seconds_fired(void *context) {
+    (void) context;
+    _slcd_seconds_due = true;
+    _slcd_seconds_next += watch_rtc_get_frequency();
+    watch_rtc_register_comp(&_slcd_seconds_comp, _slcd_seconds_fired, NULL, _slcd_seconds_next);
+}
+
+watch_seconds_counter_support_t watch_get_seconds_counter_support(void) {
+    return WATCH_SECONDS_COUNTER_SOFTWARE;
+}
+
+void watch_start_seconds_counter(void) {
+    watch_rtc_disable_comp(&_slcd_seconds_comp);
+    _slcd_display_seconds();
+    _slcd_seconds_next = _slcd_next_second(watch_rtc_get_counter());
+    watch_rtc_register_comp(&_slcd_seconds_comp, _slcd_seconds_fired, NULL, _slcd_seconds_next);
+}
+
+void watch_stop_seconds_counter(void) {
+    watch_rtc_disable_comp(&_slcd_seconds_comp);
+    _slcd_seconds_due = false;
+}
+
+void watch_display_get_write_counts(uint32_t *segment_writes, uint32_t *register_writes) {
+    *segment_writes = _slcd_segment_writes;
+    *register_writes = _slcd_register_writes;
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
@@ -288,6 +459,7 @@ void watch_start_character_blink(char character, uint32_t duration) {
 
     watch_display_character(character, 7);
     watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    watch_display_commit();
 
     slcd_disable();
     slcd_set_blink_enabled(false);
@@ -317,6 +489,7 @@ void watch_start_indicator_blink_if_possible(watch_indicator_t indicator, uint32
             return;
         }
         watch_set_indicator(indicator);
+        watch_display_commit();
 
         if (duration <= _slcd_fc_min_ms_bypass) {
             slcd_configure_frame_counter(0, (duration / (1000 / _slcd_framerate)) - 1, false);
@@ -347,6 +520,7 @@ void watch_start_sleep_animation(uint32_t duration) {
         // on classic LCD we do the "tick/tock" animation
         watch_display_character(' ', 8);
         watch_display_character(' ', 9);
+        watch_display_commit();
 
         slcd_disable();
         slcd_set_frame_counter_enabled(1, false);
@@ -369,7 +543,7 @@ bool watch_sleep_animation_is_running(void) {
     // TODO: wrap this in gossamer call
     if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
         // COM3, SEG0 contains the half moon icon
-        return SLCD->SDATAL3.bit.SDATA & 1;
+        return _slcd_shadow[3] & 1;
     } else {
         // CSREN indicates that the tick/tick animation is running
         return SLCD->CTRLD.bit.CSREN;
@@ -47,17 +47,28 @@ bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t
     return true;
 }
 
-bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
-    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset;
-    if (!_is_valid_address(address, size)) return false;
-
-    watch_storage_sync();
-
+// NVMCTRL commands go through the queue when it's in use, so that nothing is issued while another is running.
+typedef struct {
+    watch_storage_cb_t callback;
+    void *context;
+    uint32_t address;
+    uint8_t size;           // 0 for a row erase
+    uint8_t page[NVMCTRL_PAGE_SIZE];
+} watch_storage_op_t;
+
+static watch_storage_op_t _storage_queue[WATCH_STORAGE_QUEUE_LENGTH];
+static volatile uint8_t _storage_queue_head = 0;
+static volatile uint8_t _storage_queue_length = 0;
+static volatile bool _storage_op_running = false;
+
+static void _watch_storage_program_page(uint32_t address, const uint8_t *buffer, uint32_t size) {
     uint32_t nvm_address = address / 2;
     uint16_t i, data;
 
     NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_PBC | NVMCTRL_CTRLA_CMDEX_KEY;
-    watch_storage_sync();
+    while (!NVMCTRL->INTFLAG.bit.READY) {
+        // clearing the page buffer only takes a few cycles
+    }
 
     for (i = 0; i < size; i += 2) {
         data = buffer[i];
@@ -68,6 +79,107 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
     }
     NVMCTRL->ADDR.reg = address / 2;
     NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEWP | NVMCTRL_CTRLA_CMDEX_KEY;
+}
+
+static void _watch_storage_erase_row(uint32_t address) {
+    NVMCTRL->ADDR.reg = address / 2;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEER | NVMCTRL_CTRLA_CMDEX_KEY;
+}
+
+// Finishes the running operation if there is one, and starts the next. Only call this with READY set and interrupts off.
+static void _watch_storage_service(void) {
+    if (_storage_op_running) {
+        watch_storage_op_t *op = &_storage_queue[_storage_queue_head];
+        bool success = !(NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_NVME | NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_PROGE));
+        NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+        _storage_op_running = false;
+        _storage_queue_head = (_storage_queue_head + 1) % WATCH_STORAGE_QUEUE_LENGTH;
+        _storage_queue_length--;
+        if (op->callback) op->callback(success, op->context);
+    }
+
+    if (_storage_queue_length) {
+        watch_storage_op_t *op = &_storage_queue[_storage_queue_head];
+        _storage_op_running = true;
+        if (op->size) _watch_storage_program_page(op->address, op->page, op->size);
+        else _watch_storage_erase_row(op->address);
+    } else {
+        // READY stays set while the NVM is idle, so the interrupt would fire again straight away.
+        NVMCTRL->INTENCLR.reg = NVMCTRL_INTENCLR_READY;
+    }
+}
+
+void irq_handler_nvmctrl(void);
+void irq_handler_nvmctrl(void) {
+    if (NVMCTRL->INTFLAG.bit.READY) _watch_storage_service();
+}
+
+static bool _watch_storage_enqueue(uint32_t address, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback, void *context) {
+    bool queued = false;
+
+    __disable_irq();
+    if (_storage_queue_length < WATCH_STORAGE_QUEUE_LENGTH) {
+        watch_storage_op_t *op = &_storage_queue[(_storage_queue_head + _storage_queue_length) % WATCH_STORAGE_QUEUE_LENGTH];
+        op->callback = callback;
+        op->context = context;
+        op->address = address;
+        op->size = size;
+        if (size) {
+            memset(op->page, 0xFF, sizeof(op->page));
+            memcpy(op->page, buffer, size);
+        }
+        _storage_queue_length++;
+        queued = true;
+
+        // if the NVM is idle, the interrupt fires as soon as it's enabled and starts the operation.
+        NVMCTRL->INTENSET.reg = NVMCTRL_INTENSET_READY;
+        NVIC_EnableIRQ(NVMCTRL_IRQn);
+    }
+    __enable_irq();
+
+    return queued;
+}
+
+// In idle sleep until the next interrupt if we can, or by running the queue ourselves from inside an interrupt
+// handler, where the NVM interrupt might not be able to get in.
+void watch_storage_wait(void) {
+    __disable_irq();
+    if (__get_IPSR()) {
+        if (NVMCTRL->INTFLAG.bit.READY) _watch_storage_service();
+    } else if (_storage_queue_length || !NVMCTRL->INTFLAG.bit.READY) {
+        NVMCTRL->INTENSET.reg = NVMCTRL_INTENSET_READY;
+        NVIC_EnableIRQ(NVMCTRL_IRQn);
+
+        uint8_t mode = PM->SLEEPCFG.bit.SLEEPMODE;
+        PM->SLEEPCFG.bit.SLEEPMODE = PM_SLEEPCFG_SLEEPMODE_IDLE_Val;
+        while (PM->SLEEPCFG.bit.SLEEPMODE != PM_SLEEPCFG_SLEEPMODE_IDLE_Val);
+        // with interrupts masked, WFI still wakes on the pending interrupt, which runs once they're unmasked below.
+        __DSB();
+        __WFI();
+        PM->SLEEPCFG.bit.SLEEPMODE = mode;
+        while (PM->SLEEPCFG.bit.SLEEPMODE != mode);
+    }
+    __enable_irq();
+}
+
+// Waits for the NVM to be free, and returns with interrupts off so that nothing queued from an interrupt can start
+// before the caller has issued its command.
+static void _watch_storage_claim(void) {
+    while (true) {
+        watch_storage_sync();
+        __disable_irq();
+        if (!watch_storage_is_busy()) return;
+        __enable_irq();
+    }
+}
+
+bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset;
+    if (!_is_valid_address(address, size)) return false;
+
+    _watch_storage_claim();
+    _watch_storage_program_page(address, buffer, size);
+    __enable_irq();
 
     return true;
 }
@@ -76,16 +188,35 @@ bool watch_storage_erase(uint32_t row) {
     uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE;
     if (!_is_valid_address(address, NVMCTRL_ROW_SIZE)) return false;
 
-    watch_storage_sync();
-    NVMCTRL->ADDR.reg = address / 2;
-    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEER | NVMCTRL_CTRLA_CMDEX_KEY;
+    _watch_storage_claim();
+    _watch_storage_erase_row(address);
+    __enable_irq();
 
     return true;
 }
 
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback, void *context) {
+    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset;
+    if (!_is_valid_address(address, size)) return false;
+    if (size == 0 || offset % NVMCTRL_PAGE_SIZE + size > NVMCTRL_PAGE_SIZE) return false;
+
+    return _watch_storage_enqueue(address, buffer, size, callback, context);
+}
+
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback, void *context) {
+    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE;
+    if (!_is_valid_address(address, NVMCTRL_ROW_SIZE)) return false;
+
+    return _watch_storage_enqueue(address, NULL, 0, callback, context);
+}
+
+bool watch_storage_is_busy(void) {
+    return _storage_queue_length || !NVMCTRL->INTFLAG.bit.READY;
+}
+
 bool watch_storage_sync(void) {
-    while (!NVMCTRL->INTFLAG.bit.READY) {
-        // wait for flash to become ready
+    while (watch_storage_is_busy()) {
+        watch_storage_wait();
     }
 
     NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
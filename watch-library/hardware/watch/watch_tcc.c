@@ -236,6 +236,7 @@ void watch_buzzer_register_global_callbacks(watch_cb_t cb_start, watch_cb_t cb_s
 
 void irq_handler_tc0(void) {
     // interrupt handler for TC0 (globally!)
+    watch_wakelog_record(WATCH_WAKE_CAUSE_TC0, 0);
     if (_cb_tc0) {
         _cb_tc0();
     }
@@ -24,6 +24,7 @@
 
 #include "watch_slcd.h"
 #include "watch_common_display.h"
+#include "watch_glyph_tables.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -42,121 +43,44 @@ uint8_t IndicatorSegments[8] = {
     SLCD_SEGID(4, 0)   // WATCH_INDICATOR_COLON (does not exist, will set in SDATAL4 which is harmless)
 };
 
-void watch_display_character(uint8_t character, uint8_t position) {
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        if (character == 'R' && position > 1 && position < 8) character = 'r'; // We can't display uppercase R in these positions
-        else if (character == 'T' && position > 1 && position < 8) character = 't'; // lowercase t is the only option for these positions
-    } else {
-        // special cases for positions 4 and 6
-        if (position == 4 || position == 6) {
-            if (character == '7') character = '&'; // "lowercase" 7
-            else if (character == 'A') character = 'a'; // A needs to be lowercase
-            else if (character == 'o') character = 'O'; // O needs to be uppercase
-            else if (character == 'L') character = '!'; // L needs to be in top half
-            else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
-            else if (character == 'c') character = 'C'; // C needs to be uppercase
-            else if (character == 'J') character = 'j'; // same
-            else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
-            else if (character == 't' || character == 'T') character = '+'; // avoid confusion with uppercase E
-        } else {
-            if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
-            else if (character == 'j') character = 'J'; // same but just display a normal J
-            else if (character == '.') character = '_'; // we can use the bottom segment; make dot an underscore
-        }
-        if (position > 1) {
-            if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
-        }
-        if (position == 1) {
-            if (character == 'a') character = 'A'; // A needs to be uppercase
-            else if (character == 'o') character = 'O'; // O needs to be uppercase
-            else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
-            else if (character == 'n') character = 'N'; // N needs to be uppercase
-            else if (character == 'r') character = 'R'; // R needs to be uppercase
-            else if (character == 'd') character = 'D'; // D needs to be uppercase
-            else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
-            else if (character == 'b') character = 'B'; // B needs to be uppercase
-            else if (character == 'c') character = 'C'; // C needs to be uppercase
-        } else {
-            if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
-        }
-        if (position == 0) {
-            watch_clear_pixel(0, 15); // clear funky ninth segment
-        } else {
-            if (character == 'I') character = 'l'; // uppercase I only works in position 0
-        }
-    }
+#if defined(FORCE_CUSTOM_LCD_TYPE)
+static const watch_glyph_table_t *_watch_glyph_table = &Custom_LCD_Glyph_Table;
+#elif defined(FORCE_CLASSIC_LCD_TYPE)
+static const watch_glyph_table_t *_watch_glyph_table = &Classic_LCD_Glyph_Table;
+#else
+// Bound to the table for the installed LCD by _watch_update_indicator_segments, once the LCD type is known.
+static const watch_glyph_table_t *_watch_glyph_table = &Classic_LCD_Glyph_Table;
+#endif
 
-    digit_mapping_t segmap;
-    uint8_t segdata;
-
-    /// TODO: This could be optimized by doing this check once and setting a pointer in watch_discover_lcd_type.
+void watch_display_character(uint8_t character, uint8_t position) {
+    const watch_glyph_table_t *table = _watch_glyph_table;
 
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        segmap = Custom_LCD_Display_Mapping[position];
-        segdata = Custom_LCD_Character_Set[character - 0x20];
-    } else {
-        segmap = Classic_LCD_Display_Mapping[position];
-        segdata = Classic_LCD_Character_Set[character - 0x20];
-    }
+    if (position >= table->num_positions) return;
+    if (character < 0x20 || character > 0x7E) character = ' ';
 
-    for (int i = 0; i < 8; i++) {
-        if (segmap.segment[i].value == segment_does_not_exist) {
-            // Segment does not exist; skip it.
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t com = segmap.segment[i].address.com;
-        uint8_t seg = segmap.segment[i].address.seg;
+    const uint8_t *shifts = &table->shifts[position * table->num_coms];
+    const uint16_t *clear_masks = &table->clear_masks[position * table->num_coms];
+    const uint16_t *set_masks = &table->set_masks[(position * WATCH_GLYPH_NUM_CHARACTERS + (character - 0x20)) * table->num_coms];
 
-        if (segdata & 1) {
-            watch_set_pixel(com, seg);
+    for (uint8_t com = 0; com < table->num_coms; com++) {
+        if (clear_masks[com] | set_masks[com]) {
+            watch_update_pixels(com, (uint32_t)clear_masks[com] << shifts[com], (uint32_t)set_masks[com] << shifts[com]);
         }
-        else {
-            watch_clear_pixel(com, seg);
-        }
-
-        segdata = segdata >> 1;
     }
-
-    if (character == 'T' && position == 1) watch_set_pixel(1, 12); // add descender
-    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 15); // add funky ninth segment
-    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
 }
 
-void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
-    // Will only work for digits and for positions  8 and 9 - but less code & checks to reduce power consumption
-
-    digit_mapping_t segmap;
-    uint8_t segdata;
+uint32_t _watch_get_position_segments(uint8_t position, uint8_t com) {
+    const watch_glyph_table_t *table = _watch_glyph_table;
 
-    /// TODO: See optimization note above.
-
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        segmap = Custom_LCD_Display_Mapping[position];
-        segdata = Custom_LCD_Character_Set[character - 0x20];
-    } else {
-        segmap = Classic_LCD_Display_Mapping[position];
-        segdata = Classic_LCD_Character_Set[character - 0x20];
-    }
+    if (position >= table->num_positions || com >= table->num_coms) return 0;
 
-    for (int i = 0; i < 8; i++) {
-        if (segmap.segment[i].value == segment_does_not_exist) {
-            // Segment does not exist; skip it.
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t com = segmap.segment[i].address.com;
-        uint8_t seg = segmap.segment[i].address.seg;
-
-        if (segdata & 1) {
-            watch_set_pixel(com, seg);
-        }
-        else {
-            watch_clear_pixel(com, seg);
-        }
+    uint8_t index = position * table->num_coms + com;
+    return (uint32_t)table->clear_masks[index] << table->shifts[index];
+}
 
-        segdata = segdata >> 1;
-    }
+void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
+    // Only used for digits in positions 8 and 9, which have no substitutions, so the same tables apply.
+    watch_display_character(character, position);
 }
 
 void watch_display_string(const char *string, uint8_t position) {
@@ -381,6 +305,10 @@ void watch_clear_all_indicators(void) {
 }
 
 void _watch_update_indicator_segments(void) {
+#if !defined(FORCE_CUSTOM_LCD_TYPE) && !defined(FORCE_CLASSIC_LCD_TYPE)
+    _watch_glyph_table = watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM ? &Custom_LCD_Glyph_Table : &Classic_LCD_Glyph_Table;
+#endif
+
     if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
         IndicatorSegments[0] = SLCD_SEGID(0, 21); // WATCH_INDICATOR_SIGNAL
         IndicatorSegments[1] = SLCD_SEGID(1, 21); // WATCH_INDICATOR_BELL
@@ -42,6 +42,19 @@ typedef union digit_mapping_t {
     uint64_t value;
 } digit_mapping_t;
 
+// Segments set and cleared by each printable character in each position of one LCD type, with the substitutions
+// for that position already applied. The tables are in watch_glyph_tables.h, which the build generates with
+// utils/glyph_tables/generate_glyph_tables.py from the character sets and mappings below.
+#define WATCH_GLYPH_NUM_CHARACTERS (95) // printable ASCII, from 0x20 to 0x7E
+
+typedef struct {
+    uint8_t num_positions;
+    uint8_t num_coms;
+    const uint8_t *shifts;          // [position][com]: the masks are relative to this segment
+    const uint16_t *clear_masks;    // [position][com]: segments belonging to the position
+    const uint16_t *set_masks;      // [position][character - 0x20][com]: segments to turn on
+} watch_glyph_table_t;
+
 // Custom extended LCD
 
 // Character set is slightly different since we don't have to work around as much stuff.
@@ -510,3 +523,6 @@ void watch_display_character(uint8_t character, uint8_t position);
 void watch_display_character_lp_seconds(uint8_t character, uint8_t position);
 
 void _watch_update_indicator_segments(void);
+
+// The segments of a character position on the given COM, on the installed LCD.
+uint32_t _watch_get_position_segments(uint8_t position, uint8_t com);
@@ -50,6 +50,20 @@ extern watch_cb_t comp_callback;
 typedef rtc_counter_t watch_counter_t;
 typedef uint32_t unix_timestamp_t;
 
+typedef void (*watch_rtc_comp_cb_t)(void *context);
+
+/** @brief A one-shot timer on the RTC compare channel. The memory is owned by the caller, must be zeroed before first
+  *        use and must stay valid while the timer is registered. Don't touch the fields directly; use
+  *        watch_rtc_register_comp and watch_rtc_disable_comp.
+  */
+typedef struct watch_rtc_comp {
+    rtc_counter_t counter;
+    watch_rtc_comp_cb_t callback;
+    void *context;
+    struct watch_rtc_comp *next;
+    bool enabled;
+} watch_rtc_comp_t;
+
 /** @brief Called by main.c to check if the RTC is enabled.
   * You may call this function, but outside of app_init, it should always return true.
   */
@@ -84,6 +98,10 @@ void watch_rtc_set_unix_time(unix_timestamp_t unix_time);
  */ 
 unix_timestamp_t watch_rtc_get_unix_time(void);
 
+/** @brief Get the UTC unix timestamp at a given value of the hardware counter, without reading the counter again.
+ */
+unix_timestamp_t watch_rtc_get_unix_time_at_counter(rtc_counter_t counter);
+
 /** @brief Get the current value of the internal hardware counter
  *  @details The counter starts at 0 and it increases at a 128Hz rate until it overflows and starts over.
  *           We never manually set the counter. Doing so allows us to calculate absolute elapsed and more.
@@ -104,11 +122,12 @@ uint32_t watch_rtc_get_ticks_per_minute(void);
   * @param callback The function you wish to have called when the target counter is reached. If this value is NULL, the comp
   *                 interrupt will still be enabled, but no callback function will be called.
   * @param counter The time that you wish to match. The date is currently ignored.
-  * @param index We can have up to 8 active callbacks at a time. This parameter specifies which of the 8 callbacks should be set.
+  * @param index We can have up to 8 active indexed callbacks at a time. This parameter specifies which of the 8 callbacks should be set.
+  *              If you need more, use watch_rtc_register_comp.
   * @details The hardware RTC provides us with single interrupt that fires when the RTC counter matches a target counter COMP0.
-  *          With a little bit of logic, we can provide multiple active compare callbacks. Every time a comp callback is 
-  *          registered/disabled/fired we iterate over all the active comp callbacks and set the hardware COMP0 counter
-  *          to the next occurring one.
+  *          With a little bit of logic, we can provide multiple active compare callbacks. The active comp callbacks are
+  *          kept sorted by counter, and every time one is registered/disabled/fired we set the hardware COMP0 counter
+  *          to the first one in line.
   *          With this very simple API, movement can implement one-shot timers to turn off the led and determine button longpresses
   *          as well as the inactivity timeouts for resigning and sleeping, as well as emulating the top of the minute alarm.
   */
@@ -146,6 +165,21 @@ void watch_rtc_disable_comp_callback_no_schedule(uint8_t index);
   */
 void watch_rtc_schedule_next_comp(void);
 
+/** @brief Registers a caller-owned timer that calls back when the RTC counter reaches the target counter.
+  * @param comp The timer. If it is already registered, it is moved to the new target counter.
+  * @param callback The function to call from the RTC interrupt when the target counter is reached.
+  * @param context A pointer that is passed to the callback.
+  * @param counter The target counter. Targets that have already passed fire as soon as possible.
+  * @details Unlike the indexed comp callbacks above, there is no limit to the number of these timers. All the
+  *          registered timers (including the indexed ones) are kept in a single list sorted by target counter,
+  *          so finding the next one to schedule on COMP0 is immediate.
+  */
+void watch_rtc_register_comp(watch_rtc_comp_t *comp, watch_rtc_comp_cb_t callback, void *context, rtc_counter_t counter);
+
+/** @brief Disables a timer registered with watch_rtc_register_comp. Does nothing if it is not registered.
+  */
+void watch_rtc_disable_comp(watch_rtc_comp_t *comp);
+
 /** @brief Disables the alarm callback.
   */
 // void watch_rtc_disable_alarm_callback(void);
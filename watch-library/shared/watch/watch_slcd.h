@@ -116,10 +116,32 @@ void watch_set_pixel(uint8_t com, uint8_t seg);
   */
 void watch_clear_pixel(uint8_t com, uint8_t seg);
 
+/** @brief Updates several pixels on the same common pin at once: clears the segments in clear_mask, then sets the
+  *        segments in set_mask.
+  * @param com the common pin, numbered from 0-3.
+  * @param clear_mask a bit mask of the segments to turn off.
+  * @param set_mask a bit mask of the segments to turn on.
+  */
+void watch_update_pixels(uint8_t com, uint32_t clear_mask, uint32_t set_mask);
+
 /** @brief Clears all segments of the display, including incicators and the colon.
   */
 void watch_clear_display(void);
 
+/** @brief Sends the segments that changed since the last commit to the display.
+  * @details All of the drawing functions, including watch_set_pixel and watch_clear_pixel, only update a copy of the
+  *          display memory in RAM. This function writes the words that differ to the SLCD in one go, and the SLCD
+  *          shows them all starting from the same frame. Movement calls it at the end of every app_loop and before
+  *          going to sleep, so watch faces don't need to call it. Like the drawing functions, it must not be called
+  *          from an interrupt.
+  */
+void watch_display_commit(void);
+
+/** @brief Gets the number of segment updates requested since boot, and the number of display memory words that
+  *        were actually written to commit them.
+  */
+void watch_display_get_write_counts(uint32_t *segment_writes, uint32_t *register_writes);
+
 /** @brief Displays a string at the given position, starting from the top left. There are ten digits.
            A space in any position will clear that digit.
   * @deprecated Use `watch_display_text` and `watch_display_text_with_fallback` instead.
@@ -252,6 +274,33 @@ void watch_start_character_blink(char character, uint32_t duration);
   */
 void watch_start_indicator_blink_if_possible(watch_indicator_t indicator, uint32_t duration);
 
+/// Masks for watch_blink_positions: one bit per character position, as numbered by watch_display_character.
+#define WATCH_BLINK_TOP_LEFT    ((1 << 0) | (1 << 1) | (1 << 10))
+#define WATCH_BLINK_TOP_RIGHT   ((1 << 2) | (1 << 3))
+#define WATCH_BLINK_HOURS       ((1 << 4) | (1 << 5))
+#define WATCH_BLINK_MINUTES     ((1 << 6) | (1 << 7))
+#define WATCH_BLINK_SECONDS     ((1 << 8) | (1 << 9))
+#define WATCH_BLINK_BOTTOM      (WATCH_BLINK_HOURS | WATCH_BLINK_MINUTES | WATCH_BLINK_SECONDS)
+
+/** @brief Blinks whole character positions, typically the value being edited on a settings screen.
+  * @details Keep drawing the positions as usual: whatever they show is hidden for half of each period. The
+  *          toggling is driven by an RTC comparator and applied when the display is committed, so the watch face
+  *          doesn't need a fast tick and its loop isn't called to blink. The SLCD's own blink only reaches the
+  *          segments on SEG0 and SEG1, which don't make up any whole position, so this doesn't use it; the
+  *          character and indicator blinks below still do. Movement stops the blink when the watch face changes.
+  *          Calling this again with the same positions and period does nothing, so a face can call it on every
+  *          redraw without the blink stuttering.
+  * @param positions A mask of the positions to blink (see WATCH_BLINK_BOTTOM and friends), or 0 to stop blinking.
+  * @param period The duration of a full on/off cycle in milliseconds.
+  */
+void watch_blink_positions(uint16_t positions, uint32_t period);
+
+/** @brief Restarts the blink set up by watch_blink_positions in its visible half.
+  * @details Call this after changing the value being blinked, so that the new value shows up right away instead of
+  *          whenever the blink comes back around. Does nothing if nothing is blinking.
+  */
+void watch_restart_blink_positions(void);
+
 /** @brief Stops and clears all blinking segments.
   * @details This will stop all blinking in position 7, and clear all segments in that digit.
   *          On the Pro LCD, this will also stop the blinking of all indicators.
@@ -284,4 +333,31 @@ bool watch_sleep_animation_is_running(void);
   *          On the custom LCD, it will turn off the crescent moon indicator.
   */
 void watch_stop_sleep_animation(void);
+
+/// How watch_start_seconds_counter keeps the seconds digits up to date; see watch_get_seconds_counter_support.
+typedef enum {
+    WATCH_SECONDS_COUNTER_SOFTWARE = 0, ///< An RTC comparator wakes the CPU briefly each second, but no watch face runs.
+    WATCH_SECONDS_COUNTER_HARDWARE,     ///< The SLCD advances the digits by itself and the CPU stays asleep.
+} watch_seconds_counter_support_t;
+
+/** @brief Reports how the seconds counter is driven on this build.
+  * @details The SLCD's automated character mapping can write characters into digits and scroll them, but it
+  *          has no way to carry from the ones digit into the tens, so it can't count seconds by itself. Both
+  *          the hardware and the simulator currently report WATCH_SECONDS_COUNTER_SOFTWARE. A watch face that
+  *          only wants to spare its own loop can use the counter either way; one that is after zero wakes
+  *          should check for WATCH_SECONDS_COUNTER_HARDWARE.
+  */
+watch_seconds_counter_support_t watch_get_seconds_counter_support(void);
+
+/** @brief Keeps positions 8 and 9 showing the current second, without the watch face having to draw it.
+  * @details The digits are drawn right away and then at each rollover of the RTC's seconds, so they stay in
+  *          step with the time Movement reports. Together with MOVEMENT_TICK_MODE_MINUTE, this lets a clock
+  *          show seconds while its loop only runs once a minute. Movement stops the counter when the watch face
+  *          changes and when entering low energy mode.
+  */
+void watch_start_seconds_counter(void);
+
+/** @brief Stops the seconds counter. The digits keep whatever they last showed.
+  */
+void watch_stop_seconds_counter(void);
 /// @}
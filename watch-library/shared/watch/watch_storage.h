@@ -86,7 +86,54 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
   */
 bool watch_storage_erase(uint32_t row);
 
-/** @brief Waits for any pending writes to complete.
+/** @brief Waits for any pending writes and erases to complete, including those queued with
+  *        watch_storage_write_async and watch_storage_erase_async.
+  * @details On hardware the CPU waits in idle sleep rather than spinning, and the NVM controller's
+  *          READY interrupt wakes it up. watch_storage_read, watch_storage_write and
+  *          watch_storage_erase all start by calling this, so they stay in order with the queue.
   */
 bool watch_storage_sync(void);
+
+/// The number of writes and erases that can be waiting in the queue at once.
+#define WATCH_STORAGE_QUEUE_LENGTH (4)
+
+/** @brief Called when a queued write or erase has finished.
+  * @param success false if the NVM controller reported an error.
+  * @param context the context passed in when the operation was queued.
+  * @note On hardware, this is called from the NVM controller's interrupt handler. Keep it short;
+  *       queueing the next operation from it is fine, but calling the blocking functions is not.
+  */
+typedef void (*watch_storage_cb_t)(bool success, void *context);
+
+/** @brief Queues a page write, and returns without waiting for it.
+  * @param row The row containing the page you want to write.
+  * @param offset The offset from the beginning of the row. Must be a multiple of 64.
+  * @param buffer The bytes to write; copied into the queue, so it needn't outlive the call.
+  * @param size The number of bytes to write, at most NVMCTRL_PAGE_SIZE.
+  * @param callback Called when the write has finished; may be NULL.
+  * @param context Passed to callback.
+  * @return true if the write was queued; false if the address is invalid or the queue is full.
+  * @note The queue runs in order, so a write queued after an erase of its row goes to the erased row.
+  *       The queue has to be empty before the watch goes to standby: watch_enter_sleep_mode waits for it,
+  *       and Movement's loop doesn't let the watch sleep until it is.
+  */
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback, void *context);
+
+/** @brief Queues a row erase, and returns without waiting for it.
+  * @param row The row you want to erase.
+  * @param callback Called when the erase has finished; may be NULL.
+  * @param context Passed to callback.
+  * @return true if the erase was queued; false if the row is invalid or the queue is full.
+  */
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback, void *context);
+
+/** @brief Checks whether a write or erase is still in progress or waiting in the queue.
+  */
+bool watch_storage_is_busy(void);
+
+/** @brief Waits in idle sleep for the queue to move along, without waiting for all of it: returns once the NVM
+  *        controller's READY interrupt, or any other interrupt, wakes the CPU. Returns at once if nothing is
+  *        pending. watch_storage_sync is this in a loop.
+  */
+void watch_storage_wait(void);
 /// @}
@@ -273,6 +273,69 @@ watch_date_time_t watch_utility_date_time_from_unix_time(uint32_t timestamp, int
     return retval;
 }
 
+// Past this, the carry loops below stop being cheaper than the full conversion.
+#define WATCH_UTILITY_INCREMENTAL_MAX_DELTA (3600)
+
+watch_date_time_t watch_utility_date_time_from_unix_time_cached(watch_date_time_cache_t *cache, uint32_t timestamp, int32_t utc_offset) {
+    static const uint8_t days_in_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint32_t local_timestamp = timestamp + utc_offset;
+    uint32_t delta = local_timestamp - cache->timestamp;
+
+    if (delta == 0 && cache->date_time.reg != 0) return cache->date_time;
+
+    // a zero date_time is either a cold cache or a time outside our range; either way, start from scratch.
+    if (delta >= WATCH_UTILITY_INCREMENTAL_MAX_DELTA || cache->date_time.reg == 0) {
+        cache->timestamp = local_timestamp;
+        cache->date_time = watch_utility_date_time_from_unix_time(timestamp, utc_offset);
+        return cache->date_time;
+    }
+
+    uint32_t second = cache->date_time.unit.second + delta;
+    uint32_t minute = cache->date_time.unit.minute;
+    uint32_t hour = cache->date_time.unit.hour;
+    uint32_t day = cache->date_time.unit.day;
+    uint32_t month = cache->date_time.unit.month;
+    uint32_t year = cache->date_time.unit.year;
+
+    while (second >= 60) {
+        second -= 60;
+        minute++;
+    }
+    while (minute >= 60) {
+        minute -= 60;
+        hour++;
+    }
+    if (hour >= 24) {
+        hour -= 24;
+        day++;
+        // every fourth year is a leap year through 2083, since 2100 is out of range.
+        uint8_t month_length = days_in_month[month - 1] + (month == 2 && (year & 3) == 0);
+        if (day > month_length) {
+            day = 1;
+            month++;
+            if (month > 12) {
+                month = 1;
+                year++;
+                if (year + WATCH_RTC_REFERENCE_YEAR > 2083) {
+                    cache->timestamp = local_timestamp;
+                    cache->date_time.reg = 0;
+                    return cache->date_time;
+                }
+            }
+        }
+    }
+
+    cache->timestamp = local_timestamp;
+    cache->date_time.unit.second = second;
+    cache->date_time.unit.minute = minute;
+    cache->date_time.unit.hour = hour;
+    cache->date_time.unit.day = day;
+    cache->date_time.unit.month = month;
+    cache->date_time.unit.year = year;
+
+    return cache->date_time;
+}
+
 watch_date_time_t watch_utility_date_time_convert_zone(watch_date_time_t date_time, uint32_t origin_utc_offset, uint32_t destination_utc_offset) {
     uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, origin_utc_offset);
     return watch_utility_date_time_from_unix_time(timestamp, destination_utc_offset);
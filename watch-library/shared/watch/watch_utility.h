@@ -45,6 +45,12 @@ typedef struct {
     uint32_t days;    // 0-4294967295
 } watch_duration_t;
 
+/// @brief The state of an incremental calendar clock. Zero it out before first use. @see watch_utility_date_time_from_unix_time_cached
+typedef struct {
+    uint32_t timestamp;             // the local timestamp (UTC timestamp plus offset) that date_time represents
+    watch_date_time_t date_time;
+} watch_date_time_cache_t;
+
 /** @brief Returns a two-letter weekday for the given timestamp, suitable for display in positions 0-1 of the watch face
   * @param date_time The watch_date_time_t whose weekday you want.
   */
@@ -120,6 +126,17 @@ watch_duration_t watch_utility_seconds_to_duration(uint32_t seconds);
   */
 watch_date_time_t watch_utility_date_time_from_unix_time(uint32_t timestamp, int32_t utc_offset);
 
+/** @brief Like watch_utility_date_time_from_unix_time, but incremental: if the local time moved forward by less
+  *        than an hour since the last call with the same cache, the previous result is advanced field by field,
+  *        which needs no division. Larger jumps, going backwards, or a cold cache fall back to the full conversion.
+  * @param cache The clock state; keep one per view (i.e. one for UTC, one for local time), zeroed before first use.
+  * @param timestamp The UNIX timestamp that you wish to convert.
+  * @param utc_offset The number of seconds that you wish date_time to be offset from UTC. Changing it between
+  *                   calls is fine; it is just another jump.
+  * @return The same value watch_utility_date_time_from_unix_time would return.
+  */
+watch_date_time_t watch_utility_date_time_from_unix_time_cached(watch_date_time_cache_t *cache, uint32_t timestamp, int32_t utc_offset);
+
 /** @brief Converts a watch_date_time_t for 12-hour display.
   * @param date_time A pointer to the watch_date_time_t that you wish to convert for display. Note that this
   *                  function will OVERWRITE the original date/time, rendering it invalid for date/time
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "watch.h"
+#include "watch_wakelog.h"
+
+#define WATCH_WAKELOG_MAGIC (0x57414B45) // "WAKE"
+
+typedef struct {
+    uint32_t magic;
+    uint16_t sequence;
+    uint8_t head;
+    uint8_t count;
+    watch_wakelog_entry_t entries[WATCH_WAKELOG_SIZE];
+} watch_wakelog_t;
+
+// startup code does not zero out .noinit, so whatever we logged before a soft reset is still here.
+#ifndef __EMSCRIPTEN__
+__attribute__((section(".noinit")))
+#endif
+static watch_wakelog_t _wakelog;
+
+static volatile bool _wakelog_armed = false;
+
+static void _watch_wakelog_append(watch_wake_cause_t cause, uint8_t detail) {
+    watch_wakelog_entry_t *entry = &_wakelog.entries[_wakelog.head];
+
+    entry->counter = watch_rtc_get_counter();
+    entry->sequence = _wakelog.sequence++;
+    entry->cause = cause;
+    entry->detail = detail;
+
+    _wakelog.head = (_wakelog.head + 1) % WATCH_WAKELOG_SIZE;
+    if (_wakelog.count < WATCH_WAKELOG_SIZE) _wakelog.count++;
+}
+
+void watch_wakelog_init(uint8_t reset_cause) {
+    if (_wakelog.magic != WATCH_WAKELOG_MAGIC || _wakelog.head >= WATCH_WAKELOG_SIZE || _wakelog.count > WATCH_WAKELOG_SIZE) {
+        watch_wakelog_clear();
+        return;
+    }
+
+    _watch_wakelog_append(WATCH_WAKE_CAUSE_RESET, reset_cause);
+}
+
+void watch_wakelog_arm(void) {
+    _wakelog_armed = true;
+}
+
+bool watch_wakelog_is_armed(void) {
+    return _wakelog_armed;
+}
+
+void watch_wakelog_record(watch_wake_cause_t cause, uint8_t detail) {
+    // only the first interrupt after waking up is the one that woke us.
+    if (!_wakelog_armed) return;
+    _wakelog_armed = false;
+
+    _watch_wakelog_append(cause, detail);
+}
+
+uint8_t watch_wakelog_get_count(void) {
+    return _wakelog.count;
+}
+
+bool watch_wakelog_get_entry(uint8_t index, watch_wakelog_entry_t *entry) {
+    if (index >= _wakelog.count) return false;
+
+    uint8_t oldest = (_wakelog.head + WATCH_WAKELOG_SIZE - _wakelog.count) % WATCH_WAKELOG_SIZE;
+    *entry = _wakelog.entries[(oldest + index) % WATCH_WAKELOG_SIZE];
+
+    return true;
+}
+
+void watch_wakelog_clear(void) {
+    memset(&_wakelog, 0, sizeof(_wakelog));
+    _wakelog.magic = WATCH_WAKELOG_MAGIC;
+}
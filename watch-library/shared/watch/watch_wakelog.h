@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Davide Girardi
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_wakelog.h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup wakelog Wakeup Log
+  * @brief This section covers a small trace buffer that records why the MCU woke from sleep.
+  * @details Every time the watch goes to sleep, the wake log is armed; the first interrupt handler
+  *          to run afterwards records its cause, along with the RTC counter at the time, and disarms
+  *          it again. The log is a ring buffer in a no-init RAM section, so it survives a soft reset
+  *          (i.e. a watchdog or a crash) and can be dumped over USB after the fact with the `wakelog`
+  *          shell command. utils/wakelog/decode_wakelog.py turns that dump into a histogram and a
+  *          timeline.
+  * @note The simulator never sleeps in the hardware sense, so its log stays empty.
+  */
+/// @{
+
+#define WATCH_WAKELOG_SIZE (64)
+
+typedef enum {
+    WATCH_WAKE_CAUSE_NONE = 0,
+    WATCH_WAKE_CAUSE_RESET,         ///< Not a wake: the log survived a reset. Detail is RSTC->RCAUSE.
+    WATCH_WAKE_CAUSE_RTC_PER,       ///< Periodic tick. Detail is the PER interrupt flags that fired.
+    WATCH_WAKE_CAUSE_RTC_CMP,       ///< RTC compare. Detail is the comp slot index, or 0xFF for any other comp node.
+    WATCH_WAKE_CAUSE_RTC_TAMPER,    ///< Extwake pin. Detail is RTC->TAMPID.
+    WATCH_WAKE_CAUSE_RTC_OVF,       ///< RTC counter overflow.
+    WATCH_WAKE_CAUSE_EIC,           ///< External interrupt (buttons, accelerometer). Detail is the EIC channel.
+    WATCH_WAKE_CAUSE_USB,           ///< No handler claimed the wake, but USB was enabled.
+    WATCH_WAKE_CAUSE_TC0,           ///< TC0, which drives buzzer sequences.
+    WATCH_WAKE_CAUSE_OTHER,         ///< No handler claimed the wake.
+} watch_wake_cause_t;
+
+typedef struct {
+    uint32_t counter;   ///< RTC counter when the wake was recorded.
+    uint16_t sequence;  ///< Increments with every entry; gaps in a dump mean the ring wrapped.
+    uint8_t cause;      ///< One of watch_wake_cause_t.
+    uint8_t detail;     ///< Cause specific, see watch_wake_cause_t.
+} watch_wakelog_entry_t;
+
+/** @brief Validates the wake log after a reset, clearing it if its contents are garbage (i.e. after a
+  *        power-on reset), or recording a WATCH_WAKE_CAUSE_RESET entry if it survived.
+  * @param reset_cause The value of the reset cause register, stored as the detail of the reset entry.
+  */
+void watch_wakelog_init(uint8_t reset_cause);
+
+/// @brief Arms the wake log. Call right before going to sleep.
+void watch_wakelog_arm(void);
+
+/// @brief Returns true if the wake log is still armed, i.e. nothing has recorded a cause since going to sleep.
+bool watch_wakelog_is_armed(void);
+
+/** @brief Records a wake cause, if the log is armed, and disarms it. Call from interrupt handlers.
+  * @param cause The cause of the interrupt.
+  * @param detail Extra information about the cause, see watch_wake_cause_t.
+  */
+void watch_wakelog_record(watch_wake_cause_t cause, uint8_t detail);
+
+/// @brief Returns the number of entries in the log, up to WATCH_WAKELOG_SIZE.
+uint8_t watch_wakelog_get_count(void);
+
+/** @brief Reads an entry from the log.
+  * @param index The entry to read, where 0 is the oldest one.
+  * @param entry The entry is copied here.
+  * @return false if there is no such entry.
+  */
+bool watch_wakelog_get_entry(uint8_t index, watch_wakelog_entry_t *entry);
+
+/// @brief Empties the log.
+void watch_wakelog_clear(void);
+
+/// @}
@@ -24,6 +24,7 @@
 
 #include <stddef.h>
 #include "watch_extint.h"
+#include "watch_slcd.h"
 #include "app.h"
 #include <emscripten.h>
 
@@ -76,6 +77,7 @@ uint32_t watch_get_backup_data(uint8_t reg) {
 
 void watch_enter_sleep_mode(void) {
     // TODO: (a2) hook to UI
+    watch_display_commit();
 
     // disable tick interrupt
     watch_rtc_disable_all_periodic_callbacks();
@@ -43,15 +43,13 @@ static double next_tick_time;
 
 #define WATCH_RTC_N_COMP_CB 8
 
-typedef struct {
-    volatile uint32_t counter;
-    volatile watch_cb_t callback;
-    volatile bool enabled;
-} comp_cb_t;
-
 static double time_offset = 0;
 watch_cb_t tick_callbacks[8];
-comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
+// the indexed comp callbacks are just timers whose memory we own
+static watch_rtc_comp_t comp_slots[WATCH_RTC_N_COMP_CB];
+static watch_cb_t comp_slot_callbacks[WATCH_RTC_N_COMP_CB];
+// all registered timers, sorted by target counter
+static watch_rtc_comp_t *comp_head;
 
 static uint32_t scheduled_comp_counter;
 
@@ -77,10 +75,10 @@ void _watch_rtc_init(void) {
     }
 
     for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        comp_callbacks[index].counter = 0;
-        comp_callbacks[index].callback = NULL;
-        comp_callbacks[index].enabled = false;
+        comp_slots[index].enabled = false;
+        comp_slot_callbacks[index] = NULL;
     }
+    comp_head = NULL;
 
     scheduled_comp_counter = 0;
     counter = 0;
@@ -95,7 +93,9 @@ void watch_rtc_set_date_time(rtc_date_time_t date_time) {
 }
 
 rtc_date_time_t watch_rtc_get_date_time(void) {
-    return watch_utility_date_time_from_unix_time(watch_rtc_get_unix_time(), 0);
+    static watch_date_time_cache_t cached_date_time = {0};
+
+    return watch_utility_date_time_from_unix_time_cached(&cached_date_time, watch_rtc_get_unix_time(), 0);
 }
 
 void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
@@ -105,8 +105,11 @@ void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
 }
 
 unix_timestamp_t watch_rtc_get_unix_time(void) {
+    return watch_rtc_get_unix_time_at_counter(watch_rtc_get_counter());
+}
+
+unix_timestamp_t watch_rtc_get_unix_time_at_counter(rtc_counter_t counter) {
     // unix_time = time_backup + counter / RTC_CNT_HZ - 0.5
-    rtc_counter_t counter = watch_rtc_get_counter();
     return reference_timestamp + (counter >> RTC_CNT_DIV) + ((counter & RTC_CNT_SUBSECOND_MASK) >> (RTC_CNT_DIV - 1)) - 1;
 }
 
@@ -242,14 +245,42 @@ static void _watch_process_periodic_callbacks(void) {
     }
 }
 
+static void _watch_rtc_comp_unlink(watch_rtc_comp_t *comp) {
+    if (!comp->enabled) return;
+
+    watch_rtc_comp_t **link = &comp_head;
+    while (*link != comp) {
+        link = &(*link)->next;
+    }
+    *link = comp->next;
+    comp->enabled = false;
+}
+
+static void _watch_rtc_comp_insert(watch_rtc_comp_t *comp, rtc_counter_t counter) {
+    // compare relative to each other rather than to now, which is fine as long as all targets are within half the counter range.
+    watch_rtc_comp_t **link = &comp_head;
+    while (*link != NULL && (int32_t)((*link)->counter - counter) <= 0) {
+        link = &(*link)->next;
+    }
+    comp->counter = counter;
+    comp->next = *link;
+    comp->enabled = true;
+    *link = comp;
+}
+
+static void _watch_rtc_comp_slot_fired(void *context) {
+    watch_cb_t callback = *(watch_cb_t *)context;
+    if (callback != NULL) callback();
+}
+
 static void _watch_process_comp_callbacks(void) {
     // In hardware the interrupt fires one tick after the matching counter
     if (counter == (scheduled_comp_counter + 1)) {
-        for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-            if (comp_callbacks[index].enabled && scheduled_comp_counter == comp_callbacks[index].counter) {
-                comp_callbacks[index].enabled = false;
-                comp_callbacks[index].callback();
-            }
+        // fire everything that is due, from the front of the line. A callback may register its timer again.
+        while (comp_head != NULL && (int32_t)(scheduled_comp_counter - comp_head->counter) >= 0) {
+            watch_rtc_comp_t *comp = comp_head;
+            _watch_rtc_comp_unlink(comp);
+            comp->callback(comp->context);
         }
 
         watch_rtc_schedule_next_comp();
@@ -287,15 +318,27 @@ void watch_rtc_disable_all_periodic_callbacks(void) {
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 }
 
+void watch_rtc_register_comp(watch_rtc_comp_t *comp, watch_rtc_comp_cb_t callback, void *context, rtc_counter_t counter) {
+    _watch_rtc_comp_unlink(comp);
+    comp->callback = callback;
+    comp->context = context;
+    _watch_rtc_comp_insert(comp, counter);
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_disable_comp(watch_rtc_comp_t *comp) {
+    _watch_rtc_comp_unlink(comp);
+
+    watch_rtc_schedule_next_comp();
+}
+
 void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
     if (index >= WATCH_RTC_N_COMP_CB) {
         return;
     }
 
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
-
+    watch_rtc_register_comp_callback_no_schedule(callback, counter, index);
     watch_rtc_schedule_next_comp();
 }
 
@@ -304,9 +347,11 @@ void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_count
         return;
     }
 
-    comp_callbacks[index].counter = counter;
-    comp_callbacks[index].callback = callback;
-    comp_callbacks[index].enabled = true;
+    _watch_rtc_comp_unlink(&comp_slots[index]);
+    comp_slot_callbacks[index] = callback;
+    comp_slots[index].callback = _watch_rtc_comp_slot_fired;
+    comp_slots[index].context = &comp_slot_callbacks[index];
+    _watch_rtc_comp_insert(&comp_slots[index], counter);
 }
 
 void watch_rtc_disable_comp_callback(uint8_t index) {
@@ -314,8 +359,7 @@ void watch_rtc_disable_comp_callback(uint8_t index) {
         return;
     }
 
-    comp_callbacks[index].enabled = false;
-
+    watch_rtc_disable_comp_callback_no_schedule(index);
     watch_rtc_schedule_next_comp();
 }
 
@@ -324,7 +368,7 @@ void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
         return;
     }
 
-    comp_callbacks[index].enabled = false;
+    _watch_rtc_comp_unlink(&comp_slots[index]);
 }
 
 void watch_rtc_schedule_next_comp(void) {
@@ -338,23 +382,13 @@ void watch_rtc_schedule_next_comp(void) {
     // The soonest we can schedule is the next tick
     curr_counter +=1;
 
-    bool schedule_any = false;
-    rtc_counter_t comp_counter;
-    rtc_counter_t min_diff = UINT_MAX;
-
-    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
-        // rtc_counter_t diff = 
-        if (comp_callbacks[index].enabled) {
-            rtc_counter_t diff = comp_callbacks[index].counter - curr_counter;
-            if (diff <= min_diff) {
-                min_diff = diff;
-                comp_counter = comp_callbacks[index].counter;
-                schedule_any = true;
-            }
+    if (comp_head != NULL) {
+        // the list is sorted, so the next comp is always at the front of the line.
+        rtc_counter_t comp_counter = comp_head->counter;
+        // anything that is overdue fires as soon as possible
+        if ((int32_t)(comp_counter - curr_counter) < 0) {
+            comp_counter = curr_counter;
         }
-    }
-
-    if (schedule_any) {
         scheduled_comp_counter = comp_counter;
     } else {
         scheduled_comp_counter = curr_counter - 2;
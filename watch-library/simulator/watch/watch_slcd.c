@@ -25,6 +25,7 @@
 #include "watch_slcd.h"
 #include "watch_common_display.h"
 
+#include <string.h>
 #include <emscripten.h>
 #include <emscripten/html5.h>
 
@@ -37,6 +38,27 @@ static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
 
+// Same shadow framebuffer as on hardware; here a commit updates only the segments that changed in the DOM.
+#define WATCH_SLCD_NUM_COMS (8)
+
+static uint32_t _slcd_shadow[WATCH_SLCD_NUM_COMS];
+static uint32_t _slcd_committed[WATCH_SLCD_NUM_COMS];
+static uint8_t _slcd_dirty_coms = 0;
+static uint32_t _slcd_segment_writes = 0;
+static uint32_t _slcd_register_writes = 0;
+
+static uint32_t _slcd_blink_masks[WATCH_SLCD_NUM_COMS];  // segments hidden during the off half of the blink
+static uint8_t _slcd_blink_coms = 0;
+static rtc_counter_t _slcd_blink_half_period = 0;
+static uint16_t _slcd_blink_positions = 0;
+static uint32_t _slcd_blink_period = 0;
+static rtc_counter_t _slcd_blink_next = 0;
+static bool _slcd_blink_off = false;
+static watch_rtc_comp_t _slcd_blink_comp;
+
+static rtc_counter_t _slcd_seconds_next = 0;
+static watch_rtc_comp_t _slcd_seconds_comp;
+
 watch_lcd_type_t watch_get_lcd_type(void) {
 #if defined(FORCE_CUSTOM_LCD_TYPE)
     return WATCH_LCD_TYPE_CUSTOM;
@@ -58,40 +80,168 @@ void watch_enable_display(void) {
     EM_ASM({document.getElementById("classic").style.display = "";});
 #endif
 
-    watch_clear_display();
+    EM_ASM({
+        document.querySelectorAll("[data-com][data-seg]")
+            .forEach((e) => e.style.opacity = 0);
+    });
+    memset(_slcd_shadow, 0, sizeof(_slcd_shadow));
+    memset(_slcd_committed, 0, sizeof(_slcd_committed));
+    _slcd_dirty_coms = 0;
 }
 
 void watch_disable_display(void) {
     watch_clear_display();
+    watch_display_commit();
     EM_ASM({document.getElementById("classic").style.display = "none";});
     EM_ASM({document.getElementById("custom").style.display = "none";});
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 1);
-    }, com, seg);
+    _slcd_shadow[com] |= (1ul << seg);
+    _slcd_dirty_coms |= (1 << com);
+    _slcd_segment_writes++;
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 0);
-    }, com, seg);
+    _slcd_shadow[com] &= ~(1ul << seg);
+    _slcd_dirty_coms |= (1 << com);
+    _slcd_segment_writes++;
+}
+
+void watch_update_pixels(uint8_t com, uint32_t clear_mask, uint32_t set_mask) {
+    _slcd_shadow[com] = (_slcd_shadow[com] & ~clear_mask) | set_mask;
+    _slcd_dirty_coms |= (1 << com);
+    _slcd_segment_writes += __builtin_popcount(clear_mask | set_mask);
 }
 
 void watch_clear_display(void) {
-    EM_ASM({
-        document.querySelectorAll("[data-com][data-seg]")
-            .forEach((e) => e.style.opacity = 0);
-    });
+    memset(_slcd_shadow, 0, sizeof(_slcd_shadow));
+    _slcd_dirty_coms = (1 << WATCH_SLCD_NUM_COMS) - 1;
+}
+
+void watch_display_commit(void) {
+    if (!_slcd_dirty_coms) return;
+
+    for (uint8_t com = 0; com < WATCH_SLCD_NUM_COMS; com++) {
+        if (!(_slcd_dirty_coms & (1 << com))) continue;
+        uint32_t value = _slcd_blink_off ? _slcd_shadow[com] & ~_slcd_blink_masks[com] : _slcd_shadow[com];
+        uint32_t changed = value ^ _slcd_committed[com];
+        if (!changed) continue;
+
+        while (changed) {
+            uint8_t seg = __builtin_ctz(changed);
+            EM_ASM({
+                document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
+                    .forEach((e) => e.style.opacity = $2);
+            }, com, seg, (value >> seg) & 1);
+            changed &= ~(1ul << seg);
+        }
+        _slcd_committed[com] = value;
+        _slcd_register_writes++;
+    }
+
+    _slcd_dirty_coms = 0;
+}
+
+// There are no interrupts to race with in the browser, so the phase change is committed right away.
+static void _slcd_blink_fired(void *context) {
+    (void) context;
+    _slcd_blink_off = !_slcd_blink_off;
+    _slcd_dirty_coms |= _slcd_blink_coms;
+    watch_display_commit();
+    _slcd_blink_next += _slcd_blink_half_period;
+    watch_rtc_register_comp(&_slcd_blink_comp, _slcd_blink_fired, NULL, _slcd_blink_next);
+}
+
+void watch_blink_positions(uint16_t positions, uint32_t period) {
+    if (positions == _slcd_blink_positions && period == _slcd_blink_period) return;
+    _slcd_blink_positions = positions;
+    _slcd_blink_period = period;
+
+    watch_rtc_disable_comp(&_slcd_blink_comp);
+    _slcd_blink_off = false;
+    _slcd_blink_coms = 0;
+    memset(_slcd_blink_masks, 0, sizeof(_slcd_blink_masks));
+
+    _slcd_blink_half_period = (period * watch_rtc_get_frequency()) / 2000;
+    if (_slcd_blink_half_period) {
+        for (uint8_t position = 0; position < 16; position++) {
+            if (!(positions & (1 << position))) continue;
+            for (uint8_t com = 0; com < WATCH_SLCD_NUM_COMS; com++) {
+                _slcd_blink_masks[com] |= _watch_get_position_segments(position, com);
+            }
+        }
+        for (uint8_t com = 0; com < WATCH_SLCD_NUM_COMS; com++) {
+            if (_slcd_blink_masks[com]) _slcd_blink_coms |= (1 << com);
+        }
+    }
+
+    // segments that were hidden by the previous blink have to come back on.
+    _slcd_dirty_coms = (1 << WATCH_SLCD_NUM_COMS) - 1;
+
+    if (_slcd_blink_coms) {
+        _slcd_blink_next = watch_rtc_get_counter() + _slcd_blink_half_period;
+        watch_rtc_register_comp(&_slcd_blink_comp, _slcd_blink_fired, NULL, _slcd_blink_next);
+    }
+}
+
+void watch_restart_blink_positions(void) {
+    if (!_slcd_blink_coms) return;
+
+    watch_rtc_disable_comp(&_slcd_blink_comp);
+    if (_slcd_blink_off) {
+        _slcd_blink_off = false;
+        _slcd_dirty_coms |= _slcd_blink_coms;
+    }
+    _slcd_blink_next = watch_rtc_get_counter() + _slcd_blink_half_period;
+    watch_rtc_register_comp(&_slcd_blink_comp, _slcd_blink_fired, NULL, _slcd_blink_next);
+}
+
+static rtc_counter_t _slcd_next_second(rtc_counter_t counter) {
+    // the RTC's seconds roll over halfway through each second of the counter (see watch_rtc_set_unix_time).
+    uint32_t freq = watch_rtc_get_frequency();
+    return ((counter + freq / 2) / freq + 1) * freq - freq / 2;
+}
+
+static void _slcd_display_seconds(void) {
+    uint8_t second = watch_rtc_get_unix_time() % 60;
+    watch_display_character_lp_seconds('0' + second / 10, 8);
+    watch_display_character_lp_seconds('0' + second % 10, 9);
+}
+
+static void _slcd_seconds_fired(void *context) {
+    (void) context;
+    _slcd_display_seconds();
+    watch_display_commit();
+    _slcd_seconds_next += watch_rtc_get_frequency();
+    watch_rtc_register_comp(&_slcd_seconds_comp, _slcd_seconds_fired, NULL, _slcd_seconds_next);
+}
+
+watch_seconds_counter_support_t watch_get_seconds_counter_support(void) {
+    return WATCH_SECONDS_COUNTER_SOFTWARE;
+}
+
+void watch_start_seconds_counter(void) {
+    watch_rtc_disable_comp(&_slcd_seconds_comp);
+    _slcd_display_seconds();
+    _slcd_seconds_next = _slcd_next_second(watch_rtc_get_counter());
+    watch_rtc_register_comp(&_slcd_seconds_comp, _slcd_seconds_fired, NULL, _slcd_seconds_next);
+}
+
+void watch_stop_seconds_counter(void) {
+    watch_rtc_disable_comp(&_slcd_seconds_comp);
+}
+
+void watch_display_get_write_counts(uint32_t *segment_writes, uint32_t *register_writes) {
+    *segment_writes = _slcd_segment_writes;
+    *register_writes = _slcd_register_writes;
 }
 
 static void watch_invoke_blink_callback(void *userData) {
     blink_state = !blink_state;
     watch_display_character(blink_state ? blink_character : ' ', 7);
     watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    watch_display_commit();
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
@@ -123,6 +273,7 @@ static void watch_invoke_tick_callback(void *userData) {
         watch_clear_pixel(0, 3);
         watch_set_pixel(0, 2);
     }
+    watch_display_commit();
 }
 
 void watch_start_sleep_animation(uint32_t duration) {
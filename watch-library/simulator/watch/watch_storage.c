@@ -30,3 +30,27 @@ bool watch_storage_sync(void) {
     // nothing to do here!
     return true;
 }
+
+// There's no NVM controller to wait for in the browser, so queued operations finish before the call returns.
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback, void *context) {
+    if (size == 0 || offset % NVMCTRL_PAGE_SIZE + size > NVMCTRL_PAGE_SIZE) return false;
+
+    bool success = watch_storage_write(row, offset, buffer, size);
+    if (success && callback) callback(true, context);
+
+    return success;
+}
+
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback, void *context) {
+    bool success = watch_storage_erase(row);
+    if (success && callback) callback(true, context);
+
+    return success;
+}
+
+bool watch_storage_is_busy(void) {
+    return false;
+}
+
+void watch_storage_wait(void) {
+}